@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "fast_atof.h"
 #include "Subdivision.h"
+#include "ParallelHelper.h"
 
 using namespace Assimp;
 
@@ -119,6 +120,7 @@ static const aiImporterDesc desc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 AC3DImporter::AC3DImporter()
+	: configNumThreads(1)
 {
 	// nothing to be done here
 }
@@ -668,6 +670,7 @@ aiNode* AC3DImporter::ConvertObjectSection(Object& object,
 			if (object.subDiv)	{
 				if (configEvalSubdivision) {
 					boost::scoped_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+					div->SetNumThreads(configNumThreads);
 					DefaultLogger::get()->info("AC3D: Evaluating subdivision surface: "+object.name);
 
 					std::vector<aiMesh*> cpy(meshes.size()-oldm,NULL);
@@ -739,6 +742,7 @@ void AC3DImporter::SetupProperties(const Importer* pImp)
 {
 	configSplitBFCull = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_SEPARATE_BFCULL,1) ? true : false;
 	configEvalSubdivision =  pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_EVAL_SUBDIVISION,1) ? true : false;
+	configNumThreads = GetNumThreads(pImp);
 }
 
 // ------------------------------------------------------------------------------------------------
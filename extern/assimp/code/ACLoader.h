@@ -250,6 +250,10 @@ private:
 	// evaluated if the value is true.
 	bool configEvalSubdivision;
 
+	// Configuration option: number of threads to be used
+	// to evaluate subdivision surfaces.
+	int configNumThreads;
+
 	// counts how many objects we have in the tree.
 	// basing on this information we can find a
 	// good estimate how many meshes we'll have in the final scene.
@@ -0,0 +1,159 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file Implementation of the BatchImporter class to import many files concurrently */
+
+#include "AssimpPCH.h"
+
+#include "../include/assimp/BatchImporter.hpp"
+#include "ParallelHelper.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::BatchImporter()
+	: mConfig(new Importer())
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::BatchImporter(const Importer& config)
+	: mConfig(new Importer(config))
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+BatchImporter::~BatchImporter()
+{
+	delete mConfig;
+}
+
+// ------------------------------------------------------------------------------------------------
+Importer& BatchImporter::GetConfiguration()
+{
+	return *mConfig;
+}
+
+// ------------------------------------------------------------------------------------------------
+const BatchImportStatistics& BatchImporter::GetStatistics() const
+{
+	return mStatistics;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BatchImporter::Import(const std::vector<std::string>& pFiles,
+	unsigned int pFlags,
+	std::vector<BatchImportResult>& pResults)
+{
+	const int numFiles = static_cast<int>(pFiles.size());
+	const int numThreads = std::max(1,std::min(GetNumThreads(mConfig),numFiles));
+
+	pResults.clear();
+	pResults.resize(numFiles);
+
+	mStatistics = BatchImportStatistics();
+	mStatistics.mNumFiles = numFiles;
+	mStatistics.mNumThreads = numThreads;
+
+	const double start = GetWallClockTime();
+
+#ifdef _OPENMP
+#	pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+	{
+		// Each thread imports its files with its own importer. The files
+		// are the unit of parallelism, so the post-processing steps of a
+		// single file don't spawn threads of their own.
+		Importer importer(*mConfig);
+		if (numThreads > 1) {
+			importer.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,1);
+		}
+
+#ifdef _OPENMP
+#		pragma omp for schedule(dynamic,1)
+#endif
+		for (int i = 0; i < numFiles; ++i) {
+			BatchImportResult& res = pResults[i];
+			res.mFile = pFiles[i];
+
+			const double fileStart = GetWallClockTime();
+			try {
+				if (importer.ReadFile(res.mFile,pFlags)) {
+					res.mScene = importer.GetOrphanedScene();
+				}
+				else {
+					res.mError = importer.GetErrorString();
+				}
+			}
+			catch (const std::exception& e) {
+				// exceptions may not leave the parallel region
+				res.mError = e.what();
+			}
+			res.mSeconds = GetWallClockTime() - fileStart;
+		}
+	}
+
+	mStatistics.mWallSeconds = GetWallClockTime() - start;
+
+	unsigned int numSucceeded = 0;
+	for (int i = 0; i < numFiles; ++i) {
+		const BatchImportResult& res = pResults[i];
+		mStatistics.mImportSeconds += res.mSeconds;
+
+		if (!res.mScene) {
+			++mStatistics.mNumFailed;
+			continue;
+		}
+
+		++numSucceeded;
+		mStatistics.mNumMeshes += res.mScene->mNumMeshes;
+		for (unsigned int m = 0; m < res.mScene->mNumMeshes; ++m) {
+			mStatistics.mNumVertices += res.mScene->mMeshes[m]->mNumVertices;
+			mStatistics.mNumFaces += res.mScene->mMeshes[m]->mNumFaces;
+		}
+	}
+
+	DefaultLogger::get()->info((Formatter::format("BatchImporter: imported "),
+		numSucceeded," of ",numFiles," files in ",mStatistics.mWallSeconds,"s using ",
+		numThreads," threads (",mStatistics.GetFilesPerSecond()," files/s)"));
+
+	return numSucceeded;
+}
@@ -49,6 +49,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CalcTangentsProcess.h"
 #include "ProcessHelper.h"
 #include "TinyFormatter.h"
+#include "ParallelHelper.h"
+
+#ifdef ASSIMP_BUILD_WITH_MIKKTSPACE
+#	include "mikktspace.h"
+#endif
 
 using namespace Assimp;
 
@@ -57,6 +62,9 @@ using namespace Assimp;
 CalcTangentsProcess::CalcTangentsProcess()
 {
 	this->configMaxAngle = AI_DEG_TO_RAD(45.f);
+	this->configSourceUV = 0;
+	this->configMikkTSpace = false;
+	this->configNumThreads = 1;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -83,6 +91,17 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
 	configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
 	configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX,0);
+
+	configMikkTSpace = pImp->GetPropertyBool(AI_CONFIG_PP_CT_MIKKTSPACE,false);
+#ifndef ASSIMP_BUILD_WITH_MIKKTSPACE
+	if (configMikkTSpace) {
+		DefaultLogger::get()->warn("CalcTangentsProcess: MikkTSpace support is not available, "
+			"falling back to the default algorithm");
+		configMikkTSpace = false;
+	}
+#endif
+
+	configNumThreads = GetNumThreads(pImp);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -92,6 +111,28 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 	DefaultLogger::get()->debug("CalcTangentsProcess begin");
 
 	bool bHas = false;
+#ifdef ASSIMP_BUILD_WITH_MIKKTSPACE
+	if (configMikkTSpace) {
+		// do all checks (and the logging) upfront, the meshes are then 
+		// processed in parallel.
+		std::vector<aiMesh*> meshes;
+		for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+			if (CheckMesh(pScene->mMeshes[a])) {
+				meshes.push_back(pScene->mMeshes[a]);
+			}
+		}
+
+		const int iNumMeshes = static_cast<int>(meshes.size());
+#ifdef _OPENMP
+#		pragma omp parallel for schedule(dynamic) num_threads(configNumThreads)
+#endif
+		for (int a = 0; a < iNumMeshes; ++a) {
+			ProcessMeshMikkTSpace(meshes[a]);
+		}
+		bHas = !meshes.empty();
+	}
+	else
+#endif
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
 		if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
 
@@ -100,14 +141,9 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Calculates tangents and bitangents for the given mesh
-bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+// Checks whether the tangents of the given mesh need to be calculated
+bool CalcTangentsProcess::CheckMesh( const aiMesh* pMesh) const
 {
-	// we assume that the mesh is still in the verbose vertex format where each face has its own set
-	// of vertices and no vertices are shared between faces. Sadly I don't know any quick test to 
-	// assert() it here.
-    //assert( must be verbose, dammit);
-
 	if (pMesh->mTangents) // thisimplies that mBitangents is also there
 		return false;
 
@@ -131,6 +167,21 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 		DefaultLogger::get()->error((Formatter::format("Failed to compute tangents; need UV data in channel"),configSourceUV));
 		return false;
 	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Calculates tangents and bitangents for the given mesh
+bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+	// we assume that the mesh is still in the verbose vertex format where each face has its own set
+	// of vertices and no vertices are shared between faces. Sadly I don't know any quick test to 
+	// assert() it here.
+    //assert( must be verbose, dammit);
+
+	if (!CheckMesh(pMesh)) {
+		return false;
+	}
 	 
 	const float angleEpsilon = 0.9999f;
 
@@ -290,3 +341,130 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 	}
 	return true;
 }
+
+#ifdef ASSIMP_BUILD_WITH_MIKKTSPACE
+
+namespace {
+
+	// A triangle or quad as seen by MikkTSpace. Polygons with more
+	// than four vertices are passed as triangle fans.
+	struct MikkFace
+	{
+		unsigned int mIndices[4];
+		unsigned int mNumIndices;
+	};
+
+	// User data for the MikkTSpace callbacks
+	struct MikkMesh
+	{
+		aiMesh* mMesh;
+		unsigned int mSourceUV;
+		std::vector<MikkFace> mFaces;
+	};
+
+	inline const MikkMesh& GetMikkMesh(const SMikkTSpaceContext* pContext) {
+		return *static_cast<const MikkMesh*>(pContext->m_pUserData);
+	}
+
+	int MikkGetNumFaces(const SMikkTSpaceContext* pContext)
+	{
+		return static_cast<int>(GetMikkMesh(pContext).mFaces.size());
+	}
+
+	int MikkGetNumVerticesOfFace(const SMikkTSpaceContext* pContext, const int iFace)
+	{
+		return static_cast<int>(GetMikkMesh(pContext).mFaces[iFace].mNumIndices);
+	}
+
+	void MikkGetPosition(const SMikkTSpaceContext* pContext, float fvPosOut[], const int iFace, const int iVert)
+	{
+		const MikkMesh& m = GetMikkMesh(pContext);
+		const aiVector3D& v = m.mMesh->mVertices[m.mFaces[iFace].mIndices[iVert]];
+		fvPosOut[0] = v.x; fvPosOut[1] = v.y; fvPosOut[2] = v.z;
+	}
+
+	void MikkGetNormal(const SMikkTSpaceContext* pContext, float fvNormOut[], const int iFace, const int iVert)
+	{
+		const MikkMesh& m = GetMikkMesh(pContext);
+		const aiVector3D& v = m.mMesh->mNormals[m.mFaces[iFace].mIndices[iVert]];
+		fvNormOut[0] = v.x; fvNormOut[1] = v.y; fvNormOut[2] = v.z;
+	}
+
+	void MikkGetTexCoord(const SMikkTSpaceContext* pContext, float fvTexcOut[], const int iFace, const int iVert)
+	{
+		const MikkMesh& m = GetMikkMesh(pContext);
+		const aiVector3D& v = m.mMesh->mTextureCoords[m.mSourceUV][m.mFaces[iFace].mIndices[iVert]];
+		fvTexcOut[0] = v.x; fvTexcOut[1] = v.y;
+	}
+
+	void MikkSetTSpaceBasic(const SMikkTSpaceContext* pContext, const float fvTangent[], 
+		const float fSign, const int iFace, const int iVert)
+	{
+		const MikkMesh& m = GetMikkMesh(pContext);
+		const unsigned int idx = m.mFaces[iFace].mIndices[iVert];
+
+		// same convention as Blender: the bitangent is derived from the 
+		// normal, the tangent and the sign of the tangent space.
+		const aiVector3D tangent(fvTangent[0],fvTangent[1],fvTangent[2]);
+		m.mMesh->mTangents[idx] = tangent;
+		m.mMesh->mBitangents[idx] = (m.mMesh->mNormals[idx] ^ tangent) * fSign;
+	}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+// Calculates MikkTSpace tangents and bitangents for the given mesh
+void CalcTangentsProcess::ProcessMeshMikkTSpace( aiMesh* pMesh) const
+{
+	MikkMesh m;
+	m.mMesh = pMesh;
+	m.mSourceUV = configSourceUV;
+	m.mFaces.reserve(pMesh->mNumFaces);
+
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		if (face.mNumIndices < 3) {
+			continue;
+		}
+
+		MikkFace f;
+		if (face.mNumIndices <= 4) {
+			f.mNumIndices = face.mNumIndices;
+			std::copy(face.mIndices,face.mIndices+face.mNumIndices,f.mIndices);
+			m.mFaces.push_back(f);
+			continue;
+		}
+
+		f.mNumIndices = 3;
+		f.mIndices[0] = face.mIndices[0];
+		for (unsigned int i = 2; i < face.mNumIndices; ++i) {
+			f.mIndices[1] = face.mIndices[i-1];
+			f.mIndices[2] = face.mIndices[i];
+			m.mFaces.push_back(f);
+		}
+	}
+
+	// vertices of points and lines keep qnan tangents
+	const float qnan = get_qnan();
+	pMesh->mTangents = new aiVector3D[pMesh->mNumVertices];
+	pMesh->mBitangents = new aiVector3D[pMesh->mNumVertices];
+	std::fill(pMesh->mTangents,pMesh->mTangents+pMesh->mNumVertices,aiVector3D(qnan));
+	std::fill(pMesh->mBitangents,pMesh->mBitangents+pMesh->mNumVertices,aiVector3D(qnan));
+
+	SMikkTSpaceInterface iface;
+	memset(&iface,0,sizeof(iface));
+	iface.m_getNumFaces = &MikkGetNumFaces;
+	iface.m_getNumVerticesOfFace = &MikkGetNumVerticesOfFace;
+	iface.m_getPosition = &MikkGetPosition;
+	iface.m_getNormal = &MikkGetNormal;
+	iface.m_getTexCoord = &MikkGetTexCoord;
+	iface.m_setTSpaceBasic = &MikkSetTSpaceBasic;
+
+	SMikkTSpaceContext context;
+	context.m_pInterface = &iface;
+	context.m_pUserData = &m;
+
+	genTangSpaceDefault(&context);
+}
+
+#endif // ASSIMP_BUILD_WITH_MIKKTSPACE
@@ -97,6 +97,23 @@ protected:
 	*/
 	bool ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
+	// -------------------------------------------------------------------
+	/** Checks whether tangents can and need to be computed for a mesh.
+	* Reports the reason to the logger if they can't.
+	* @param pMesh The mesh to check.
+	*/
+	bool CheckMesh( const aiMesh* pMesh) const;
+
+#ifdef ASSIMP_BUILD_WITH_MIKKTSPACE
+	// -------------------------------------------------------------------
+	/** Calculates MikkTSpace tangents and bitangents for a mesh. 
+	* The mesh must have passed CheckMesh(). The function can be 
+	* called from multiple threads for different meshes.
+	* @param pMesh The mesh to process.
+	*/
+	void ProcessMeshMikkTSpace( aiMesh* pMesh) const;
+#endif
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* @param pScene The imported data to work at.
@@ -108,6 +125,12 @@ private:
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
 	unsigned int configSourceUV;
+
+	/** Configuration option: use the MikkTSpace algorithm */
+	bool configMikkTSpace;
+
+	/** Number of threads to be used, see #AI_CONFIG_GLOB_MULTITHREADING */
+	int configNumThreads;
 };
 
 } // end of namespace Assimp
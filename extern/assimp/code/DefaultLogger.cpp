@@ -376,33 +376,43 @@ void DefaultLogger::WriteToStreams(const char *message,
 {
 	ai_assert(NULL != message);
 
-	// Check whether this is a repeated message
-	if (! ::strncmp( message,lastMsg, lastLen-1))
+	// The logger is shared by all threads, e.g. by the importers of a
+	// BatchImporter. The repeated message check and the streams are not 
+	// thread-safe, so only one thread writes at a time.
+#ifdef _OPENMP
+#	pragma omp critical(ai_default_logger)
+#endif
 	{
-		if (!noRepeatMsg)
+		bool bSkip = false;
+
+		// Check whether this is a repeated message
+		if (! ::strncmp( message,lastMsg, lastLen-1))
 		{
-			noRepeatMsg = true;
-			message = "Skipping one or more lines with the same contents\n";
+			if (!noRepeatMsg)
+			{
+				noRepeatMsg = true;
+				message = "Skipping one or more lines with the same contents\n";
+			}
+			else bSkip = true;
+		}
+		else
+		{
+			// append a new-line character to the message to be printed
+			lastLen = ::strlen(message);
+			::memcpy(lastMsg,message,lastLen+1);
+			::strcat(lastMsg+lastLen,"\n");
+
+			message = lastMsg;
+			noRepeatMsg = false;
+			++lastLen;
+		}
+		for ( ConstStreamIt it = m_StreamArray.begin();
+			!bSkip && it != m_StreamArray.end();
+			++it)
+		{
+			if ( ErrorSev & (*it)->m_uiErrorSeverity )
+				(*it)->m_pStream->write( message);
 		}
-		else return;
-	}
-	else
-	{
-		// append a new-line character to the message to be printed
-		lastLen = ::strlen(message);
-		::memcpy(lastMsg,message,lastLen+1);
-		::strcat(lastMsg+lastLen,"\n");
-
-		message = lastMsg;
-		noRepeatMsg = false;
-		++lastLen;
-	}
-	for ( ConstStreamIt it = m_StreamArray.begin();
-		it != m_StreamArray.end();
-		++it)
-	{
-		if ( ErrorSev & (*it)->m_uiErrorSeverity )
-			(*it)->m_pStream->write( message);
 	}
 }
 
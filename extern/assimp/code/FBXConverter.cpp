@@ -91,6 +91,17 @@ public:
 		TransformationComp_MAXIMUM
 	};
 
+	/** how much of a fbx node is imported if a node filter is active */
+	enum NodeSelection
+	{
+		NodeSelection_Skip = 0,
+
+		// ancestor of a selected node, only the transformation is kept
+		NodeSelection_Transform,
+
+		// selected node or part of the subtree of a selected node
+		NodeSelection_Full
+	};
 
 
 public:
@@ -100,10 +111,19 @@ public:
 		, doc(doc)
 		, defaultMaterialIndex()
 	{
+		// determine which nodes are to be imported before anything
+		// else so that neither animations nor geometry is read for
+		// nodes that we skip anyway.
+		if(doc.Settings().filter.HasNodeFilter()) {
+			SelectNodes(0L, false);
+		}
+
 		// animations need to be converted first since this will
 		// populate the node_anim_chain_bits map, which is needed
 		// to determine which nodes need to be generated.
-		ConvertAnimations();
+		if(doc.Settings().readAnimations) {
+			ConvertAnimations();
+		}
 		ConvertRootNode();
 
 		if(doc.Settings().readAllMaterials) {
@@ -133,6 +153,10 @@ public:
 		if (out->mNumMeshes == 0) {
 			out->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
 		}
+
+		if (doc.Settings().filter.IsStructureOnly()) {
+			out->mFlags |= AI_SCENE_FLAGS_STRUCTURE_ONLY;
+		}
 	}
 
 
@@ -148,6 +172,57 @@ public:
 
 private:
 
+	// ------------------------------------------------------------------------------------------------
+	// strip the Model:: prefix from a fbx node name, see FixNodeName()
+	static std::string GetPlainNodeName(const std::string& name)
+	{
+		return name.substr(0,7) == "Model::" ? name.substr(7) : name;
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	// collect the nodes selected by the node filter, their subtrees and their ancestors. Returns
+	// true if the subtree of the given node contains any selected node.
+	bool SelectNodes(uint64_t id, bool parent_selected)
+	{
+		const std::vector<const Connection*>& conns = doc.GetConnectionsByDestinationSequenced(id, "Model");
+
+		bool any = false;
+		BOOST_FOREACH(const Connection* con, conns) {
+
+			// ignore object-property links
+			if(con->PropertyName().length()) {
+				continue;
+			}
+
+			const Model* const model = dynamic_cast<const Model*>(con->SourceObject());
+			if(!model) {
+				continue;
+			}
+
+			const bool selected = parent_selected || doc.Settings().filter.IsNodeSelected(GetPlainNodeName(model->Name()));
+			if (SelectNodes(model->ID(), selected) || selected) {
+				node_selection[model] = selected ? NodeSelection_Full : NodeSelection_Transform;
+				any = true;
+			}
+		}
+		return any;
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	// determine how much of a node is to be imported
+	NodeSelection GetNodeSelection(const Model& model) const
+	{
+		if(!doc.Settings().filter.HasNodeFilter()) {
+			return NodeSelection_Full;
+		}
+
+		const NodeSelectionMap::const_iterator it = node_selection.find(&model);
+		return it == node_selection.end() ? NodeSelection_Skip : (*it).second;
+	}
+
+
 	// ------------------------------------------------------------------------------------------------
 	// find scene root and trigger recursive scene conversion
 	void ConvertRootNode() 
@@ -187,7 +262,8 @@ private:
 
 				const Model* const model = dynamic_cast<const Model*>(object);
 
-				if(model) {
+				const NodeSelection selection = model ? GetNodeSelection(*model) : NodeSelection_Skip;
+				if(selection != NodeSelection_Skip) {
 					nodes_chain.clear();
 
 					aiMatrix4x4 new_abs_transform = parent_transform;
@@ -236,17 +312,20 @@ private:
 						new_abs_transform *= prenode->mTransformation;
 					}
 
-					// attach geometry
-					ConvertModel(*model, *nodes_chain.back(), new_abs_transform);
+					// attach geometry, unless this is only an ancestor of the selected nodes
+					const bool full = selection == NodeSelection_Full;
+					if(full && !doc.Settings().filter.IsStructureOnly()) {
+						ConvertModel(*model, *nodes_chain.back(), new_abs_transform);
+					}
 
 					// attach sub-nodes
 					ConvertNodes(model->ID(), *nodes_chain.back(), new_abs_transform);
 
-					if(doc.Settings().readLights) {
+					if(full && doc.Settings().readLights) {
 						ConvertLights(*model);
 					}
 
-					if(doc.Settings().readCameras) {
+					if(full && doc.Settings().readCameras) {
 						ConvertCameras(*model);
 					}
 
@@ -1722,6 +1801,16 @@ private:
 	// ------------------------------------------------------------------------------------------------
 	void ConvertAnimationStack(const AnimationStack& st)
 	{				
+		// strip AnimationStack:: prefix
+		std::string name = st.Name();
+		if(name.substr(0,16) == "AnimationStack::") {
+			name = name.substr(16);
+		}
+
+		if(!doc.Settings().filter.IsAnimationSelected(name)) {
+			return;
+		}
+
 		const AnimationLayerList& layers = st.Layers();
 		if(layers.empty()) {
 			return;
@@ -1730,13 +1819,15 @@ private:
 		aiAnimation* const anim = new aiAnimation();
 		animations.push_back(anim);
 
-		// strip AnimationStack:: prefix
-		std::string name = st.Name();
-		if(name.substr(0,16) == "AnimationStack::") {
-			name = name.substr(16);
-		}
-
 		anim->mName.Set(name);
+
+		// take the duration from the stack properties, without
+		// looking at the animation curves at all.
+		if(doc.Settings().filter.IsStructureOnly()) {
+			anim->mDuration = CONVERT_FBX_TIME(st.LocalStop() - st.LocalStart()) * anim_fps;
+			anim->mTicksPerSecond = anim_fps;
+			return;
+		}
 		
 		// need to find all nodes for which we need to generate node animations -
 		// it may happen that we need to merge multiple layers, though.
@@ -1765,6 +1856,11 @@ private:
 					continue;
 				}
 
+				// skip curves of nodes which won't be imported
+				if(GetNodeSelection(*model) == NodeSelection_Skip) {
+					continue;
+				}
+
 				const std::string& name = FixNodeName(model->Name());
 				node_map[name].push_back(node);
 
@@ -2723,6 +2819,10 @@ private:
 	typedef std::map<std::string, std::string> NameNameMap;
 	NameNameMap renamed_nodes;
 
+	// nodes to be imported, only populated if a node filter is active
+	typedef std::map<const Model*, NodeSelection> NodeSelectionMap;
+	NodeSelectionMap node_selection;
+
 	double anim_fps;
 
 	aiScene* const out;
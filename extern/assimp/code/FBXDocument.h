@@ -947,10 +947,10 @@ public:
 
 public:
 
-	fbx_simple_property(LocalStart, uint64_t, 0L);
-	fbx_simple_property(LocalStop, uint64_t, 0L);
-	fbx_simple_property(ReferenceStart, uint64_t, 0L);
-	fbx_simple_property(ReferenceStop, uint64_t, 0L);
+	fbx_simple_property(LocalStart, int64_t, 0L);
+	fbx_simple_property(LocalStop, int64_t, 0L);
+	fbx_simple_property(ReferenceStart, int64_t, 0L);
+	fbx_simple_property(ReferenceStop, int64_t, 0L);
 
 
 
@@ -44,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_FBX_IMPORTSETTINGS_H
 #define INCLUDED_AI_FBX_IMPORTSETTINGS_H
 
+#include "ImportFilter.h"
+
 namespace Assimp {
 namespace FBX {
 
@@ -132,6 +134,11 @@ struct ImportSettings
 	 *  values matching the corresponding node transformation.
 	 *  The default value is true. */
 	bool optimizeEmptyAnimationCurves;
+
+	/** selection of the nodes and animation stacks to be read, see
+	 *  #AI_CONFIG_IMPORT_NODE_FILTER et al. Objects which are not
+	 *  selected are never evaluated. By default, everything is read. */
+	ImportFilter filter;
 };
 
 
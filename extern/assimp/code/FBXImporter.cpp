@@ -132,6 +132,7 @@ void FBXImporter::SetupProperties(const Importer* pImp)
 	settings.strictMode = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_STRICT_MODE, false);
 	settings.preservePivots = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, true);
 	settings.optimizeEmptyAnimationCurves = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_OPTIMIZE_EMPTY_ANIMATION_CURVES, true);
+	settings.filter.SetupProperties(pImp);
 }
 
 
@@ -151,11 +152,14 @@ void FBXImporter::InternReadFile( const std::string& pFile,
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
 	std::vector<char> contents;
-	contents.resize(stream->FileSize());
+	contents.resize(stream->FileSize() + 1);
 
-	stream->Read(&*contents.begin(),contents.size(),1);
+	stream->Read(&*contents.begin(),contents.size() - 1,1);
 	const char* const begin = &*contents.begin();
 
+	// the ascii tokenizer expects a zero-terminated string
+	contents.back() = '\0';
+
 	// broadphase tokenizing pass in which we identify the core
 	// syntax elements of FBX (brackets, commas, key:value mappings)
 	TokenList tokens;
@@ -164,7 +168,7 @@ void FBXImporter::InternReadFile( const std::string& pFile,
 		bool is_binary = false;
 		if (!strncmp(begin,"Kaydara FBX Binary",18)) {
 			is_binary = true;
-			TokenizeBinary(tokens,begin,contents.size());
+			TokenizeBinary(tokens,begin,contents.size() - 1);
 		}
 		else {
 			Tokenize(tokens,begin);
@@ -425,6 +425,53 @@ int ParseTokenAsInt(const Token& t, const char*& err_out)
 }
 
 
+// ------------------------------------------------------------------------------------------------
+int64_t ParseTokenAsInt64(const Token& t, const char*& err_out)
+{
+	err_out = NULL;
+
+	if (t.Type() != TokenType_DATA) {
+		err_out = "expected TOK_DATA token";
+		return 0L;
+	}
+
+	if(t.IsBinary())
+	{
+		const char* data = t.begin();
+		if (data[0] != 'L') {
+			err_out = "failed to parse Int64, unexpected data type, expected L(ong) (binary)";
+			return 0L;
+		}
+
+		ai_assert(t.end() - data == 9);
+
+		BE_NCONST int64_t ival = *reinterpret_cast<const int64_t*>(data+1);
+		AI_SWAP8(ival);
+		return ival;
+	}
+
+	// XXX: should use size_t here
+	unsigned int length = static_cast<unsigned int>(t.end() - t.begin());
+	ai_assert(length > 0);
+
+	const char* in = t.begin();
+	const bool inv = (*in == '-');
+	if (inv || *in == '+') {
+		++in;
+		--length;
+	}
+
+	const char* out;
+	const uint64_t uval = strtoul10_64(in,&out,&length);
+	if (out > t.end() || out == in) {
+		err_out = "failed to parse Int64 (text)";
+		return 0L;
+	}
+
+	return inv ? -static_cast<int64_t>(uval) : static_cast<int64_t>(uval);
+}
+
+
 // ------------------------------------------------------------------------------------------------
 std::string ParseTokenAsString(const Token& t, const char*& err_out)
 {
@@ -1200,6 +1247,19 @@ int ParseTokenAsInt(const Token& t)
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// wrapper around ParseTokenAsInt64() with ParseError handling
+int64_t ParseTokenAsInt64(const Token& t)
+{
+	const char* err;
+	const int64_t i = ParseTokenAsInt64(t,err);
+	if(err) {
+		ParseError(err,t);
+	}
+	return i;
+}
+
+
 
 } // !FBX
 } // !Assimp
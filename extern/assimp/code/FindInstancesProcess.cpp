@@ -45,6 +45,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssimpPCH.h"
 #include "FindInstancesProcess.h"
+#include "ParallelHelper.h"
+#include "TinyFormatter.h"
 
 using namespace Assimp;
 
@@ -52,6 +54,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 FindInstancesProcess::FindInstancesProcess()
 :	configSpeedFlag (false)
+,	configNumThreads (1)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -74,6 +77,8 @@ void FindInstancesProcess::SetupProperties(const Importer* pImp)
 {
 	// AI_CONFIG_FAVOUR_SPEED
 	configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED,0));
+
+	configNumThreads = GetNumThreads(pImp);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -112,6 +117,89 @@ void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
 		UpdateMeshIndices(node->mChildren[n],lookup);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Check whether a mesh is an instance of another mesh with the same hash
+bool FindInstancesProcess::IsInstance(const aiMesh* orig, const aiMesh* inst, float epsilon) const
+{
+	// check for hash collision .. we needn't check
+	// the vertex format, it *must* match due to the
+	// (brilliant) construction of the hash
+	if (orig->mNumBones       != inst->mNumBones      ||
+		orig->mNumFaces       != inst->mNumFaces      ||
+		orig->mNumVertices    != inst->mNumVertices   ||
+		orig->mMaterialIndex  != inst->mMaterialIndex ||
+		orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+		return false;
+
+	// up to now the meshes are equal. now compare vertex positions, normals,
+	// tangents and bitangents using the given epsilon.
+	if (orig->HasPositions()) {
+		if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
+			return false;
+	}
+	if (orig->HasNormals()) {
+		if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+			return false;
+	}
+	if (orig->HasTangentsAndBitangents()) {
+		if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+			!CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+			return false;
+	}
+
+	// use a constant epsilon for colors and UV coordinates
+	static const float uvEpsilon = 10e-4f;
+
+	for (unsigned int i = 0, end = orig->GetNumUVChannels(); i < end; ++i) {
+		if (!orig->mTextureCoords[i]) {
+			continue;
+		}
+		if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
+			return false;
+		}
+	}
+	for (unsigned int i = 0, end = orig->GetNumColorChannels(); i < end; ++i) {
+		if (!orig->mColors[i]) {
+			continue;
+		}
+		if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
+			return false;
+		}
+	}
+
+	// These two checks are actually quite expensive and almost *never* required.
+	// Almost. That's why they're still here. But there's no reason to do them
+	// in speed-targeted imports.
+	if (!configSpeedFlag) {
+
+		// It seems to be strange, but we really need to check whether the
+		// bones are identical too. Although it's extremely unprobable
+		// that they're not if control reaches here, we need to deal
+		// with unprobable cases, too. It could still be that there are
+		// equal shapes which are deformed differently.
+		if (!CompareBones(orig,inst))
+			return false;
+
+		// For completeness ... compare even the index buffers for equality
+		// face order & winding order doesn't care. Input data is in verbose format.
+		boost::scoped_array<unsigned int> ftbl_orig(new unsigned int[orig->mNumVertices]);
+		boost::scoped_array<unsigned int> ftbl_inst(new unsigned int[orig->mNumVertices]);
+
+		for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+			aiFace& f = orig->mFaces[tt];
+			for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+				ftbl_orig[f.mIndices[nn]] = tt;
+
+			aiFace& f2 = inst->mFaces[tt];
+			for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+				ftbl_inst[f2.mIndices[nn]] = tt;
+		}
+		if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+			return false;
+	}
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FindInstancesProcess::Execute( aiScene* pScene)
@@ -126,128 +214,56 @@ void FindInstancesProcess::Execute( aiScene* pScene)
 		// everyone-against-everyone check involving up to 10 comparisons
 		// each.
 		boost::scoped_array<uint64_t> hashes (new uint64_t[pScene->mNumMeshes]);
+		boost::scoped_array<float> epsilons (new float[pScene->mNumMeshes]);
 		boost::scoped_array<unsigned int> remapping (new unsigned int[pScene->mNumMeshes]);
 
-		unsigned int numMeshesOut = 0;
+		// compute the hashes and the (squared) epsilons to compare positions 
+		// against upfront. This is independent for every mesh, so it's done
+		// in parallel.
+		const int iNumMeshes = static_cast<int>(pScene->mNumMeshes);
+#ifdef _OPENMP
+#		pragma omp parallel for schedule(dynamic,64) num_threads(configNumThreads) if(iNumMeshes > 256)
+#endif
+		for (int i = 0; i < iNumMeshes; ++i) {
+			aiMesh* mesh = pScene->mMeshes[i];
+			hashes[i] = GetMeshHash(mesh);
+
+			const float epsilon = ComputePositionEpsilon(mesh);
+			epsilons[i] = epsilon * epsilon;
+		}
+
+		// Sort the meshes into buckets by their hash. A mesh is only
+		// compared to the meshes in its bucket, which are the unique meshes
+		// seen so far with the same hash, latest first.
+		typedef std::map<uint64_t, std::vector<unsigned int> > HashBuckets;
+		HashBuckets buckets;
+
+		unsigned int numMeshesOut = 0, numCompared = 0;
 		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 
 			aiMesh* inst = pScene->mMeshes[i];
-			hashes[i] = GetMeshHash(inst);
-
-			for (int a = i-1; a >= 0; --a) {
-				if (hashes[i] == hashes[a])
-				{
-					aiMesh* orig = pScene->mMeshes[a];
-					if (!orig)
-						continue;
-					
-					// check for hash collision .. we needn't check
-					// the vertex format, it *must* match due to the
-					// (brilliant) construction of the hash
-					if (orig->mNumBones       != inst->mNumBones      ||
-						orig->mNumFaces       != inst->mNumFaces      ||
-						orig->mNumVertices    != inst->mNumVertices   ||
-						orig->mMaterialIndex  != inst->mMaterialIndex ||
-						orig->mPrimitiveTypes != inst->mPrimitiveTypes)
-						continue;
-
-					// up to now the meshes are equal. find an appropriate
-					// epsilon to compare position differences against
-					float epsilon = ComputePositionEpsilon(inst);
-					epsilon *= epsilon;
-
-					// now compare vertex positions, normals,
-					// tangents and bitangents using this epsilon.
-					if (orig->HasPositions()) {
-						if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
-							continue;
-					}
-					if (orig->HasNormals()) {
-						if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-							continue;
-					}
-					if (orig->HasTangentsAndBitangents()) {
-						if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-							!CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
-							continue;
-					}
-
-					// use a constant epsilon for colors and UV coordinates
-					static const float uvEpsilon = 10e-4f;
-
-					{
-						unsigned int i, end = orig->GetNumUVChannels();
-						for(i = 0; i < end; ++i) {
-							if (!orig->mTextureCoords[i]) {
-								continue;
-							}
-							if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
-								break;	
-							}
-						}
-						if (i != end) {
-							continue;
-						}
-					}
-					{
-						unsigned int i, end = orig->GetNumColorChannels();
-						for(i = 0; i < end; ++i) {
-							if (!orig->mColors[i]) {
-								continue;
-							}
-							if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
-								break;	
-							}
-						}
-						if (i != end) {
-							continue;
-						}
-					}
-
-					// These two checks are actually quite expensive and almost *never* required.
-					// Almost. That's why they're still here. But there's no reason to do them
-					// in speed-targeted imports.
-					if (!configSpeedFlag) {
-
-						// It seems to be strange, but we really need to check whether the
-						// bones are identical too. Although it's extremely unprobable
-						// that they're not if control reaches here, we need to deal
-						// with unprobable cases, too. It could still be that there are
-						// equal shapes which are deformed differently.
-						if (!CompareBones(orig,inst))
-							continue;
-
-						// For completeness ... compare even the index buffers for equality
-						// face order & winding order doesn't care. Input data is in verbose format.
-						boost::scoped_array<unsigned int> ftbl_orig(new unsigned int[orig->mNumVertices]);
-						boost::scoped_array<unsigned int> ftbl_inst(new unsigned int[orig->mNumVertices]);
-
-						for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-							aiFace& f = orig->mFaces[tt];
-							for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-								ftbl_orig[f.mIndices[nn]] = tt;
-
-							aiFace& f2 = inst->mFaces[tt];
-							for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-								ftbl_inst[f2.mIndices[nn]] = tt;
-						}
-						if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-							continue;
-					}
-
-					// We're still here. Or in other words: 'inst' is an instance of 'orig'.
-					// Place a marker in our list that we can easily update mesh indices.
-					remapping[i] = remapping[a];
-
-					// Delete the instanced mesh, we don't need it anymore
-					delete inst;
-					pScene->mMeshes[i] = NULL;
+			std::vector<unsigned int>& bucket = buckets[hashes[i]];
+
+			std::vector<unsigned int>::reverse_iterator it = bucket.rbegin();
+			for (; it != bucket.rend(); ++it) {
+				++numCompared;
+				if (IsInstance(pScene->mMeshes[*it],inst,epsilons[i])) {
 					break;
 				}
 			}
 
-			// If we didn't find a match for the current mesh: keep it
-			if (pScene->mMeshes[i]) {
+			if (it != bucket.rend()) {
+				// 'inst' is an instance of 'orig'. Place a marker in our
+				// list that we can easily update mesh indices.
+				remapping[i] = remapping[*it];
+
+				// Delete the instanced mesh, we don't need it anymore
+				delete inst;
+				pScene->mMeshes[i] = NULL;
+			}
+			else {
+				// If we didn't find a match for the current mesh: keep it
+				bucket.push_back(i);
 				remapping[i] = numMeshesOut++;
 			}
 		}
@@ -265,13 +281,14 @@ void FindInstancesProcess::Execute( aiScene* pScene)
 
 			// write to log
 			if (!DefaultLogger::isNullLogger()) {
-			
-				char buffer[512];
-				::sprintf(buffer,"FindInstancesProcess finished. Found %i instances",pScene->mNumMeshes-numMeshesOut);
-				DefaultLogger::get()->info(buffer); 
+				const unsigned int numInstances = pScene->mNumMeshes-numMeshesOut;
+				DefaultLogger::get()->info((Formatter::format("FindInstancesProcess finished. Found "),
+					numInstances," instances of ",numMeshesOut," unique meshes, ",
+					buckets.size()," hash buckets, ",numCompared-numInstances," hash collisions"));
 			}
 			pScene->mNumMeshes = numMeshesOut;
 		}
-		else DefaultLogger::get()->debug("FindInstancesProcess finished. No instanced meshes found"); 
+		else DefaultLogger::get()->debug((Formatter::format("FindInstancesProcess finished. No instanced meshes found, "),
+			numCompared," hash collisions")); 
 	}
 }
@@ -125,9 +125,16 @@ public:
 	// Setup properties prior to executing the process
 	void SetupProperties(const Importer* pImp);
 
+private:
+
+	// -------------------------------------------------------------------
+	// Check whether a mesh is an instance of another mesh with the same hash
+	bool IsInstance(const aiMesh* orig, const aiMesh* inst, float epsilon) const;
+
 private:
 
 	bool configSpeedFlag;
+	int configNumThreads;
 
 }; // ! end class FindInstancesProcess
 }  // ! end namespace Assimp
@@ -0,0 +1,910 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenLODsProcess.cpp
+ *  @brief Implementation of the GenLODs post processing step
+ *
+ *  The simplification follows Garland & Heckbert, "Surface Simplification
+ *  Using Quadric Error Metrics" (1997), but collapses each edge onto one of
+ *  its vertices instead of an optimal position, so that the attributes of 
+ *  the remaining vertices (normals, texture coordinates, bone weights) can
+ *  be taken over unchanged.
+ */
+
+#include "AssimpPCH.h"
+
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#include "GenLODsProcess.h"
+#include "ProcessHelper.h"
+#include "ParallelHelper.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+
+namespace {
+
+// weight of the planes which keep open borders in place, relative to the surface
+#define AI_LOD_BORDER_WEIGHT 10.0
+
+// ------------------------------------------------------------------------------------------------
+// Symmetric 4x4 error quadric, normalized by the accumulated plane weight
+struct Quadric
+{
+	Quadric()
+		: a00(), a11(), a22(), a01(), a02(), a12()
+		, b0(), b1(), b2(), c(), w()
+	{}
+
+	void AddPlane(const aiVector3D& n, double d, double weight) {
+		a00 += weight * n.x * n.x;
+		a11 += weight * n.y * n.y;
+		a22 += weight * n.z * n.z;
+		a01 += weight * n.x * n.y;
+		a02 += weight * n.x * n.z;
+		a12 += weight * n.y * n.z;
+		b0 += weight * n.x * d;
+		b1 += weight * n.y * d;
+		b2 += weight * n.z * d;
+		c += weight * d * d;
+		w += weight;
+	}
+
+	Quadric& operator += (const Quadric& o) {
+		a00 += o.a00; a11 += o.a11; a22 += o.a22;
+		a01 += o.a01; a02 += o.a02; a12 += o.a12;
+		b0 += o.b0; b1 += o.b1; b2 += o.b2;
+		c += o.c;
+		w += o.w;
+		return *this;
+	}
+
+	// mean squared distance of p to the planes
+	double Error(const aiVector3D& p) const {
+		const double x = p.x, y = p.y, z = p.z;
+		const double r = a00*x*x + a11*y*y + a22*z*z + 2.0*(a01*x*y + a02*x*z + a12*y*z) +
+			2.0*(b0*x + b1*y + b2*z) + c;
+		return w > 0.0 ? fabs(r) / w : 0.0;
+	}
+
+	double a00, a11, a22, a01, a02, a12;
+	double b0, b1, b2, c, w;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Topological classification of a vertex, determines which collapses it can take part in
+enum VertexKind
+{
+	// interior vertex, may collapse onto any neighbour
+	Kind_Manifold,
+	// vertex on an open border, may only collapse along the border
+	Kind_Border,
+	// vertex on a seam between two attribute sets (i.e. UV charts), collapses
+	// together with its twin along the seam
+	Kind_Seam,
+	// corners, non-manifold vertices and seams with more than two sides
+	Kind_Locked
+};
+
+// ------------------------------------------------------------------------------------------------
+// Candidate collapse of vertex v onto vertex u
+struct Collapse
+{
+	unsigned int v, u;
+	double cost;
+
+	bool operator < (const Collapse& o) const {
+		return cost < o.cost;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+// Vertex to triangle adjacency of an index buffer, in CSR layout
+struct Adjacency
+{
+	void Build(const std::vector<unsigned int>& indices, unsigned int numVertices) {
+		offsets.assign(numVertices + 1,0);
+		for (size_t i = 0; i < indices.size(); ++i) {
+			++offsets[indices[i] + 1];
+		}
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			offsets[i + 1] += offsets[i];
+		}
+		triangles.resize(indices.size());
+		std::vector<unsigned int> fill(offsets.begin(),offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i) {
+			triangles[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+		}
+	}
+
+	std::vector<unsigned int> offsets, triangles;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Incremental simplifier for a single triangle mesh. Simplify() may be called repeatedly 
+// with decreasing targets to produce a chain of levels of detail.
+class MeshSimplifier
+{
+public:
+
+	MeshSimplifier(const aiMesh* pMesh, float pMaxError);
+
+	void Simplify(unsigned int pTargetTriangles);
+
+	aiMesh* BuildMesh() const;
+
+	unsigned int GetNumTriangles() const {
+		return static_cast<unsigned int>(indices.size() / 3);
+	}
+
+	// estimated distance of the current mesh to the original mesh
+	float GetError() const {
+		return static_cast<float>(sqrt(error));
+	}
+
+private:
+
+	// -------------------------------------------------------------------
+	// The vertex following / preceding v in triangle t
+	unsigned int Next(unsigned int t, unsigned int v) const {
+		const unsigned int* tri = &indices[t*3];
+		return tri[0] == v ? tri[1] : (tri[1] == v ? tri[2] : tri[0]);
+	}
+	unsigned int Prev(unsigned int t, unsigned int v) const {
+		const unsigned int* tri = &indices[t*3];
+		return tri[0] == v ? tri[2] : (tri[1] == v ? tri[0] : tri[1]);
+	}
+
+	bool HasEdge(unsigned int a, unsigned int b) const;
+	bool HasPositionEdge(unsigned int a, unsigned int b) const;
+
+	void ClassifyVertices();
+	void ComputeQuadrics();
+	void ComputeBoneWeights();
+
+	bool GetCollapse(unsigned int v, unsigned int u, Collapse& out, unsigned int& v2, unsigned int& u2) const;
+	bool CheckFlip(unsigned int v, unsigned int u) const;
+	double GetBonePenalty(unsigned int v, unsigned int u) const;
+
+private:
+
+	const aiMesh* mesh;
+	const unsigned int numVertices;
+
+	// current triangles
+	std::vector<unsigned int> indices;
+	Adjacency adj;
+
+	// first vertex with the same position, and circular list of vertices with the same position
+	std::vector<unsigned int> remap, wedge;
+	std::vector<unsigned char> kind;
+
+	// per position
+	std::vector<Quadric> quadrics;
+
+	// per vertex (bone, weight) lists
+	std::vector<unsigned int> boneOffsets;
+	std::vector< std::pair<unsigned int,float> > boneWeights;
+
+	double penaltyScale;
+	double errorLimit;
+	double error;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Orders vertex indices by position
+struct PositionLess
+{
+	PositionLess(const aiVector3D* v) : v(v) {}
+
+	bool operator () (unsigned int a, unsigned int b) const {
+		const aiVector3D& pa = v[a], &pb = v[b];
+		if (pa.x != pb.x) return pa.x < pb.x;
+		if (pa.y != pb.y) return pa.y < pb.y;
+		if (pa.z != pb.z) return pa.z < pb.z;
+		return a < b;
+	}
+
+	const aiVector3D* v;
+};
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiMesh* pMesh, float pMaxError)
+	: mesh(pMesh)
+	, numVertices(pMesh->mNumVertices)
+	, error()
+{
+	indices.reserve(mesh->mNumFaces * 3);
+	for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+		const aiFace& f = mesh->mFaces[i];
+		indices.insert(indices.end(),f.mIndices,f.mIndices + 3);
+	}
+
+	// find vertices which share a position, they differ in other attributes
+	std::vector<unsigned int> order(numVertices);
+	for (unsigned int i = 0; i < numVertices; ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(),order.end(),PositionLess(mesh->mVertices));
+
+	remap.resize(numVertices);
+	wedge.resize(numVertices);
+	for (unsigned int i = 0; i < numVertices; ) {
+		unsigned int end = i + 1;
+		while (end < numVertices && mesh->mVertices[order[end]] == mesh->mVertices[order[i]]) {
+			++end;
+		}
+		for (unsigned int k = i; k < end; ++k) {
+			remap[order[k]] = order[i];
+			wedge[order[k]] = order[k + 1 < end ? k + 1 : i];
+		}
+		i = end;
+	}
+
+	adj.Build(indices,numVertices);
+
+	ClassifyVertices();
+	ComputeQuadrics();
+	ComputeBoneWeights();
+
+	aiVector3D min, max;
+	ArrayBounds(mesh->mVertices,numVertices,min,max);
+	const double extent = std::max(max.x - min.x,std::max(max.y - min.y,max.z - min.z));
+
+	// a weight difference of 1 costs as much as an error of 1% of the mesh size
+	penaltyScale = (extent * 0.01) * (extent * 0.01);
+	errorLimit = (pMaxError * extent) * (pMaxError * extent);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether there is a triangle with the directed edge a->b
+bool MeshSimplifier::HasEdge(unsigned int a, unsigned int b) const
+{
+	for (unsigned int i = adj.offsets[a]; i < adj.offsets[a + 1]; ++i) {
+		if (Next(adj.triangles[i],a) == b) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether there is a triangle with the directed edge a->b, comparing positions only
+bool MeshSimplifier::HasPositionEdge(unsigned int a, unsigned int b) const
+{
+	const unsigned int pb = remap[b];
+	unsigned int w = a;
+	do {
+		for (unsigned int i = adj.offsets[w]; i < adj.offsets[w + 1]; ++i) {
+			if (remap[Next(adj.triangles[i],w)] == pb) {
+				return true;
+			}
+		}
+		w = wedge[w];
+	}
+	while (w != a);
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::ClassifyVertices()
+{
+	kind.assign(numVertices,Kind_Locked);
+
+	for (unsigned int p = 0; p < numVertices; ++p) {
+		if (remap[p] != p) {
+			continue;
+		}
+
+		// count the edges around the position which have no opposite edge
+		unsigned int numWedges = 0, openOut = 0, openIn = 0;
+		unsigned int w = p;
+		do {
+			++numWedges;
+			for (unsigned int i = adj.offsets[w]; i < adj.offsets[w + 1]; ++i) {
+				const unsigned int t = adj.triangles[i];
+				openOut += !HasPositionEdge(Next(t,w),w);
+				openIn += !HasPositionEdge(w,Prev(t,w));
+			}
+			w = wedge[w];
+		}
+		while (w != p);
+
+		unsigned char k = Kind_Locked;
+		if (numWedges == 1) {
+			if (!openOut && !openIn) {
+				k = Kind_Manifold;
+			}
+			else if (openOut == 1 && openIn == 1) {
+				k = Kind_Border;
+			}
+		}
+		else if (numWedges == 2 && !openOut && !openIn) {
+			// a closed surface with two attribute sets meeting at this position,
+			// each side must have exactly one seam edge going in and one going out
+			k = Kind_Seam;
+			w = p;
+			do {
+				unsigned int seamOut = 0, seamIn = 0;
+				for (unsigned int i = adj.offsets[w]; i < adj.offsets[w + 1]; ++i) {
+					const unsigned int t = adj.triangles[i];
+					seamOut += !HasEdge(Next(t,w),w);
+					seamIn += !HasEdge(w,Prev(t,w));
+				}
+				if (seamOut != 1 || seamIn != 1) {
+					k = Kind_Locked;
+				}
+				w = wedge[w];
+			}
+			while (w != p);
+		}
+
+		w = p;
+		do {
+			kind[w] = k;
+			w = wedge[w];
+		}
+		while (w != p);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::ComputeQuadrics()
+{
+	quadrics.resize(numVertices);
+	const aiVector3D* const pos = mesh->mVertices;
+
+	for (size_t t = 0; t < indices.size(); t += 3) {
+		const unsigned int* tri = &indices[t];
+		aiVector3D n = (pos[tri[1]] - pos[tri[0]]) ^ (pos[tri[2]] - pos[tri[0]]);
+		const float len = n.Length();
+		if (len <= 0.f) {
+			continue;
+		}
+		n /= len;
+
+		// plane of the triangle, weighted by its area
+		const double d = -(n * pos[tri[0]]);
+		for (unsigned int k = 0; k < 3; ++k) {
+			quadrics[remap[tri[k]]].AddPlane(n,d,len * 0.5);
+		}
+
+		// planes perpendicular to open borders keep them in place
+		for (unsigned int k = 0; k < 3; ++k) {
+			const unsigned int a = tri[k], b = tri[(k+1)%3];
+			if (HasPositionEdge(b,a)) {
+				continue;
+			}
+			const aiVector3D edge = pos[b] - pos[a];
+			aiVector3D m = edge ^ n;
+			const float mlen = m.Length();
+			if (mlen <= 0.f) {
+				continue;
+			}
+			m /= mlen;
+
+			const double md = -(m * pos[a]);
+			const double weight = edge.SquareLength() * AI_LOD_BORDER_WEIGHT;
+			quadrics[remap[a]].AddPlane(m,md,weight);
+			quadrics[remap[b]].AddPlane(m,md,weight);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::ComputeBoneWeights()
+{
+	if (!mesh->HasBones()) {
+		return;
+	}
+
+	boneOffsets.assign(numVertices + 1,0);
+	for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+		const aiBone* bone = mesh->mBones[b];
+		for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+			++boneOffsets[bone->mWeights[i].mVertexId + 1];
+		}
+	}
+	for (unsigned int i = 0; i < numVertices; ++i) {
+		boneOffsets[i + 1] += boneOffsets[i];
+	}
+
+	boneWeights.resize(boneOffsets.back());
+	std::vector<unsigned int> fill(boneOffsets.begin(),boneOffsets.end() - 1);
+	for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+		const aiBone* bone = mesh->mBones[b];
+		for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+			boneWeights[fill[bone->mWeights[i].mVertexId]++] = std::make_pair(b,bone->mWeights[i].mWeight);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sum of the absolute differences of the bone weights of two vertices
+double MeshSimplifier::GetBonePenalty(unsigned int v, unsigned int u) const
+{
+	if (boneOffsets.empty()) {
+		return 0.0;
+	}
+
+	double diff = 0.0;
+	for (unsigned int i = boneOffsets[v]; i < boneOffsets[v + 1]; ++i) {
+		float other = 0.f;
+		for (unsigned int j = boneOffsets[u]; j < boneOffsets[u + 1]; ++j) {
+			if (boneWeights[j].first == boneWeights[i].first) {
+				other = boneWeights[j].second;
+			}
+		}
+		diff += fabs(boneWeights[i].second - other);
+	}
+	for (unsigned int j = boneOffsets[u]; j < boneOffsets[u + 1]; ++j) {
+		bool found = false;
+		for (unsigned int i = boneOffsets[v]; i < boneOffsets[v + 1]; ++i) {
+			found = found || boneWeights[j].first == boneWeights[i].first;
+		}
+		if (!found) {
+			diff += boneWeights[j].second;
+		}
+	}
+	return diff * diff * penaltyScale;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether moving v onto u flips any of the remaining triangles around v
+bool MeshSimplifier::CheckFlip(unsigned int v, unsigned int u) const
+{
+	const aiVector3D* const pos = mesh->mVertices;
+	for (unsigned int i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i) {
+		const unsigned int t = adj.triangles[i];
+		const unsigned int a = Next(t,v), b = Prev(t,v);
+		if (remap[a] == remap[u] || remap[b] == remap[u]) {
+			continue;
+		}
+
+		const aiVector3D n0 = (pos[a] - pos[v]) ^ (pos[b] - pos[v]);
+		const aiVector3D n1 = (pos[a] - pos[u]) ^ (pos[b] - pos[u]);
+		if (n0 * n1 <= 0.f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Determine whether v may collapse onto u, and at which cost. Seam vertices collapse 
+// together with their twin v2, which moves onto u2.
+bool MeshSimplifier::GetCollapse(unsigned int v, unsigned int u, Collapse& out,
+	unsigned int& v2, unsigned int& u2) const
+{
+	v2 = u2 = UINT_MAX;
+
+	switch (kind[v])
+	{
+	case Kind_Manifold:
+		break;
+
+	case Kind_Border:
+		// only along the border, in either direction
+		if (HasPositionEdge(u,v) && HasPositionEdge(v,u)) {
+			return false;
+		}
+		break;
+
+	case Kind_Seam:
+		{
+			if (kind[u] != Kind_Seam && kind[u] != Kind_Locked) {
+				return false;
+			}
+			// only along the seam
+			if (HasEdge(u,v) == HasEdge(v,u)) {
+				return false;
+			}
+			// the twin must be connected to a twin of u
+			v2 = wedge[v];
+			for (unsigned int w = wedge[u]; w != u; w = wedge[w]) {
+				if (HasEdge(v2,w) || HasEdge(w,v2)) {
+					u2 = w;
+					break;
+				}
+			}
+			if (u2 == UINT_MAX) {
+				return false;
+			}
+		}
+		break;
+
+	default:
+		return false;
+	};
+
+	out.v = v;
+	out.u = u;
+	out.cost = quadrics[remap[v]].Error(mesh->mVertices[u]) + GetBonePenalty(v,u);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::Simplify(unsigned int pTargetTriangles)
+{
+	std::vector<Collapse> candidates;
+	std::vector<unsigned int> collapseTo(numVertices);
+	std::vector<bool> locked(numVertices), removedVertex(numVertices);
+
+	while (GetNumTriangles() > pTargetTriangles) {
+		adj.Build(indices,numVertices);
+
+		// gather the cheapest possible collapse along each edge. Interior edges are 
+		// seen from both of their triangles, take them from one side only.
+		candidates.clear();
+		for (size_t i = 0; i < indices.size(); ++i) {
+			const unsigned int v = indices[i], u = indices[i - i%3 + (i+1)%3];
+			if (v > u && HasEdge(u,v)) {
+				continue;
+			}
+
+			Collapse c, cr;
+			unsigned int v2, u2;
+			const bool fwd = GetCollapse(v,u,c,v2,u2), bwd = GetCollapse(u,v,cr,v2,u2);
+			if (fwd || bwd) {
+				candidates.push_back(fwd && (!bwd || c.cost <= cr.cost) ? c : cr);
+			}
+		}
+		if (candidates.empty()) {
+			break;
+		}
+		std::sort(candidates.begin(),candidates.end());
+
+		// Collapse the cheapest edges first. In each pass, only collapses whose cost is close
+		// to that of the last one which would be needed to reach the target are done, 
+		// otherwise the locking below would force expensive collapses early.
+		const unsigned int numRemove = GetNumTriangles() - pTargetTriangles;
+		const size_t last = std::min(candidates.size(),static_cast<size_t>(numRemove / 2 + 1)) - 1;
+		const double threshold = candidates[last].cost * 1.5;
+
+		for (unsigned int i = 0; i < numVertices; ++i) {
+			collapseTo[i] = i;
+		}
+		locked.assign(numVertices,false);
+		removedVertex.assign(numVertices,false);
+
+		unsigned int removed = 0, performed = 0;
+		bool limitReached = false;
+		for (size_t c = 0; c < candidates.size() && removed < numRemove; ++c) {
+			const Collapse& col = candidates[c];
+			if (col.cost > errorLimit) {
+				limitReached = true;
+				break;
+			}
+			if (col.cost > threshold) {
+				break;
+			}
+
+			// The flip test assumes that the neighbours of the collapsed vertex stay in place,
+			// so they must not be collapsed in the same pass. Removed vertices can't be targets.
+			unsigned int v2, u2;
+			Collapse dummy;
+			if (locked[remap[col.v]] || removedVertex[remap[col.u]] || !GetCollapse(col.v,col.u,dummy,v2,u2)) {
+				continue;
+			}
+			if (!CheckFlip(col.v,col.u) || (v2 != UINT_MAX && !CheckFlip(v2,u2))) {
+				continue;
+			}
+
+			const unsigned int sides[2] = {col.v,v2}, targets[2] = {col.u,u2};
+			for (unsigned int s = 0; s < 2 && sides[s] != UINT_MAX; ++s) {
+				collapseTo[sides[s]] = targets[s];
+				for (unsigned int i = adj.offsets[sides[s]]; i < adj.offsets[sides[s] + 1]; ++i) {
+					const unsigned int* tri = &indices[adj.triangles[i]*3];
+					for (unsigned int k = 0; k < 3; ++k) {
+						locked[remap[tri[k]]] = true;
+					}
+					removed += tri[0] == targets[s] || tri[1] == targets[s] || tri[2] == targets[s];
+				}
+			}
+
+			removedVertex[remap[col.v]] = true;
+			quadrics[remap[col.u]] += quadrics[remap[col.v]];
+			error = std::max(error,col.cost);
+			++performed;
+		}
+
+		if (!performed) {
+			break;
+		}
+
+		// apply the collapses and drop the triangles which became degenerate
+		size_t out = 0;
+		for (size_t t = 0; t < indices.size(); t += 3) {
+			const unsigned int a = collapseTo[indices[t]], b = collapseTo[indices[t+1]], c = collapseTo[indices[t+2]];
+			if (remap[a] == remap[b] || remap[b] == remap[c] || remap[c] == remap[a]) {
+				continue;
+			}
+			indices[out++] = a;
+			indices[out++] = b;
+			indices[out++] = c;
+		}
+		indices.resize(out);
+
+		if (limitReached) {
+			break;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Build a mesh from the current triangles, with unused vertices removed
+aiMesh* MeshSimplifier::BuildMesh() const
+{
+	std::vector<unsigned int> newIndex(numVertices,UINT_MAX);
+	std::vector<unsigned int> used;
+	for (size_t i = 0; i < indices.size(); ++i) {
+		if (newIndex[indices[i]] == UINT_MAX) {
+			newIndex[indices[i]] = static_cast<unsigned int>(used.size());
+			used.push_back(indices[i]);
+		}
+	}
+	const unsigned int num = static_cast<unsigned int>(used.size());
+
+	aiMesh* out = new aiMesh();
+	out->mName = mesh->mName;
+	out->mMaterialIndex = mesh->mMaterialIndex;
+	out->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+	out->mNumVertices = num;
+
+	out->mVertices = new aiVector3D[num];
+	for (unsigned int i = 0; i < num; ++i) {
+		out->mVertices[i] = mesh->mVertices[used[i]];
+	}
+	if (mesh->HasNormals()) {
+		out->mNormals = new aiVector3D[num];
+		for (unsigned int i = 0; i < num; ++i) {
+			out->mNormals[i] = mesh->mNormals[used[i]];
+		}
+	}
+	if (mesh->HasTangentsAndBitangents()) {
+		out->mTangents = new aiVector3D[num];
+		out->mBitangents = new aiVector3D[num];
+		for (unsigned int i = 0; i < num; ++i) {
+			out->mTangents[i] = mesh->mTangents[used[i]];
+			out->mBitangents[i] = mesh->mBitangents[used[i]];
+		}
+	}
+	for (unsigned int a = 0; mesh->HasTextureCoords(a); ++a) {
+		out->mNumUVComponents[a] = mesh->mNumUVComponents[a];
+		out->mTextureCoords[a] = new aiVector3D[num];
+		for (unsigned int i = 0; i < num; ++i) {
+			out->mTextureCoords[a][i] = mesh->mTextureCoords[a][used[i]];
+		}
+	}
+	for (unsigned int a = 0; mesh->HasVertexColors(a); ++a) {
+		out->mColors[a] = new aiColor4D[num];
+		for (unsigned int i = 0; i < num; ++i) {
+			out->mColors[a][i] = mesh->mColors[a][used[i]];
+		}
+	}
+
+	out->mNumFaces = GetNumTriangles();
+	out->mFaces = new aiFace[out->mNumFaces];
+	for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+		aiFace& f = out->mFaces[i];
+		f.mNumIndices = 3;
+		f.mIndices = new unsigned int[3];
+		for (unsigned int k = 0; k < 3; ++k) {
+			f.mIndices[k] = newIndex[indices[i*3+k]];
+		}
+	}
+
+	// keep the bones which still influence any vertex
+	std::vector<aiBone*> bones;
+	for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+		const aiBone* src = mesh->mBones[b];
+
+		std::vector<aiVertexWeight> weights;
+		for (unsigned int i = 0; i < src->mNumWeights; ++i) {
+			const unsigned int idx = newIndex[src->mWeights[i].mVertexId];
+			if (idx != UINT_MAX) {
+				weights.push_back(aiVertexWeight(idx,src->mWeights[i].mWeight));
+			}
+		}
+		if (weights.empty()) {
+			continue;
+		}
+
+		aiBone* bone = new aiBone();
+		bone->mName = src->mName;
+		bone->mOffsetMatrix = src->mOffsetMatrix;
+		bone->mNumWeights = static_cast<unsigned int>(weights.size());
+		bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+		std::copy(weights.begin(),weights.end(),bone->mWeights);
+		bones.push_back(bone);
+	}
+	if (!bones.empty()) {
+		out->mNumBones = static_cast<unsigned int>(bones.size());
+		out->mBones = new aiBone*[out->mNumBones];
+		std::copy(bones.begin(),bones.end(),out->mBones);
+	}
+
+	out->mLODError = GetError();
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Statistics of one level of one mesh
+struct LevelInfo
+{
+	unsigned int numTriangles;
+	float error;
+	double seconds;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenLODsProcess::GenLODsProcess()
+	: configLevels(AI_LOD_LEVELS)
+	, configRatio(AI_LOD_RATIO)
+	, configMaxError(1.f)
+	, configNumThreads(1)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenLODsProcess::~GenLODsProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenLODsProcess::IsActive( unsigned int pFlags) const
+{
+	return (pFlags & aiProcess_GenLODs) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void GenLODsProcess::SetupProperties(const Importer* pImp)
+{
+	configLevels = static_cast<unsigned int>(std::max(0,pImp->GetPropertyInteger(AI_CONFIG_PP_LOD_LEVELS,AI_LOD_LEVELS)));
+	configRatio = pImp->GetPropertyFloat(AI_CONFIG_PP_LOD_RATIO,AI_LOD_RATIO);
+	configMaxError = pImp->GetPropertyFloat(AI_CONFIG_PP_LOD_MAX_ERROR,1.f);
+
+	if (configRatio <= 0.f || configRatio >= 1.f) {
+		DefaultLogger::get()->error("GenLODsProcess: AI_CONFIG_PP_LOD_RATIO must be in ]0,1[, using default");
+		configRatio = AI_LOD_RATIO;
+	}
+
+	configNumThreads = GetNumThreads(pImp);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenLODsProcess::Execute( aiScene* pScene)
+{
+	DefaultLogger::get()->debug("GenLODsProcess begin");
+
+	const int numMeshes = static_cast<int>(pScene->mNumMeshes);
+	std::vector< std::vector<LevelInfo> > info(numMeshes);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(dynamic,1) num_threads(configNumThreads) if(configNumThreads > 1 && numMeshes > 1)
+#endif
+	for (int i = 0; i < numMeshes; ++i) {
+		aiMesh* mesh = pScene->mMeshes[i];
+
+		for (unsigned int a = 0; a < mesh->mNumLODs; ++a) {
+			delete mesh->mLODs[a];
+		}
+		delete [] mesh->mLODs;
+		mesh->mLODs = NULL;
+		mesh->mNumLODs = 0;
+
+		if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || !configLevels) {
+			continue;
+		}
+
+		MeshSimplifier simplifier(mesh,configMaxError);
+		std::vector<aiMesh*> lods;
+
+		float ratio = 1.f;
+		unsigned int last = mesh->mNumFaces;
+		for (unsigned int level = 0; level < configLevels; ++level) {
+			const double start = GetWallClockTime();
+
+			ratio *= configRatio;
+			simplifier.Simplify(static_cast<unsigned int>(mesh->mNumFaces * ratio));
+
+			// stop if the mesh cannot be simplified any further
+			const unsigned int num = simplifier.GetNumTriangles();
+			if (!num || num >= last) {
+				break;
+			}
+			last = num;
+			lods.push_back(simplifier.BuildMesh());
+
+			LevelInfo li;
+			li.numTriangles = num;
+			li.error = simplifier.GetError();
+			li.seconds = GetWallClockTime() - start;
+			info[i].push_back(li);
+		}
+
+		if (!lods.empty()) {
+			mesh->mNumLODs = static_cast<unsigned int>(lods.size());
+			mesh->mLODs = new aiMesh*[mesh->mNumLODs];
+			std::copy(lods.begin(),lods.end(),mesh->mLODs);
+		}
+	}
+
+	if (!DefaultLogger::isNullLogger()) {
+		unsigned int numTriangles = 0;
+		for (int i = 0; i < numMeshes; ++i) {
+			if (pScene->mMeshes[i]->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+				numTriangles += pScene->mMeshes[i]->mNumFaces;
+			}
+		}
+
+		for (unsigned int level = 0; level < configLevels; ++level) {
+			unsigned int numMeshesLevel = 0, numTrianglesLevel = 0;
+			float error = 0.f;
+			double seconds = 0.0;
+			for (int i = 0; i < numMeshes; ++i) {
+				if (level < info[i].size()) {
+					const LevelInfo& li = info[i][level];
+					++numMeshesLevel;
+					numTrianglesLevel += li.numTriangles;
+					error = std::max(error,li.error);
+					seconds += li.seconds;
+				}
+			}
+			if (!numMeshesLevel) {
+				break;
+			}
+			DefaultLogger::get()->info((Formatter::format("GenLODsProcess: LOD "),level + 1,": ",
+				numMeshesLevel," meshes, ",numTrianglesLevel," of ",numTriangles," triangles, max. error ",
+				error,", ",seconds,"s"));
+		}
+	}
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENLODS_PROCESS
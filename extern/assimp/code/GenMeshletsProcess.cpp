@@ -0,0 +1,331 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.cpp
+ *  @brief Implementation of the GenMeshlets post processing step
+ */
+
+#include "AssimpPCH.h"
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "GenMeshletsProcess.h"
+#include "ProcessHelper.h"
+#include "VertexTriangleAdjacency.h"
+#include "ParallelHelper.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Compute the bounding sphere and the normal cone of a finished meshlet
+void ComputeMeshletBounds(const aiMesh* mesh, const unsigned int* verts, 
+	const unsigned char* tris, aiMeshlet& m)
+{
+	aiVector3D min, max;
+	MinMaxChooser<aiVector3D>()(min,max);
+	for (unsigned int i = 0; i < m.mNumVertices; ++i) {
+		min = std::min(min,mesh->mVertices[verts[i]]);
+		max = std::max(max,mesh->mVertices[verts[i]]);
+	}
+
+	m.mCenter = (min + max) * 0.5f;
+	m.mRadius = 0.f;
+	for (unsigned int i = 0; i < m.mNumVertices; ++i) {
+		m.mRadius = std::max(m.mRadius,(mesh->mVertices[verts[i]] - m.mCenter).Length());
+	}
+
+	// the cone axis is the average triangle normal, its opening is given
+	// by the normal which deviates most from the axis
+	std::vector<aiVector3D> normals(m.mNumTriangles);
+	aiVector3D axis;
+	for (unsigned int t = 0; t < m.mNumTriangles; ++t) {
+		const aiVector3D& a = mesh->mVertices[verts[tris[t*3]]];
+		const aiVector3D& b = mesh->mVertices[verts[tris[t*3+1]]];
+		const aiVector3D& c = mesh->mVertices[verts[tris[t*3+2]]];
+
+		const aiVector3D n = (b - a) ^ (c - a);
+		const float len = n.Length();
+		normals[t] = len > 0.f ? n / len : aiVector3D();
+		axis += normals[t];
+	}
+
+	m.mConeApex = m.mCenter;
+	m.mConeAxis = aiVector3D();
+	m.mConeCutoff = 1.f;
+
+	const float len = axis.Length();
+	if (len <= 0.f) {
+		return;
+	}
+	axis /= len;
+
+	float minDot = 1.f;
+	for (unsigned int t = 0; t < m.mNumTriangles; ++t) {
+		if (normals[t].SquareLength() > 0.f) {
+			minDot = std::min(minDot,normals[t] * axis);
+		}
+	}
+
+	// wider than ~84 degrees, the cone would hardly ever cull anything
+	if (minDot <= 0.1f) {
+		return;
+	}
+
+	// move the apex back along the axis until all triangle planes are in front of it
+	float maxT = 0.f;
+	for (unsigned int t = 0; t < m.mNumTriangles; ++t) {
+		const float dn = normals[t] * axis;
+		if (dn > 0.f) {
+			const aiVector3D& a = mesh->mVertices[verts[tris[t*3]]];
+			maxT = std::max(maxT,((m.mCenter - a) * normals[t]) / dn);
+		}
+	}
+
+	m.mConeApex = m.mCenter - axis * maxT;
+	m.mConeAxis = axis;
+	m.mConeCutoff = sqrt(1.f - minDot * minDot);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenMeshletsProcess::GenMeshletsProcess()
+	: configMaxVertices(AI_MESHLET_MAX_VERTICES)
+	, configMaxTriangles(AI_MESHLET_MAX_TRIANGLES)
+	, configNumThreads(1)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenMeshletsProcess::~GenMeshletsProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenMeshletsProcess::IsActive( unsigned int pFlags) const
+{
+	return (pFlags & aiProcess_GenMeshlets) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void GenMeshletsProcess::SetupProperties(const Importer* pImp)
+{
+	const int verts = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_VERTICES,AI_MESHLET_MAX_VERTICES);
+	const int tris = pImp->GetPropertyInteger(AI_CONFIG_PP_ML_MAX_TRIANGLES,AI_MESHLET_MAX_TRIANGLES);
+
+	configMaxVertices = static_cast<unsigned int>(std::max(3,std::min(256,verts)));
+	configMaxTriangles = static_cast<unsigned int>(std::max(1,tris));
+	if (static_cast<int>(configMaxVertices) != verts || static_cast<int>(configMaxTriangles) != tris) {
+		DefaultLogger::get()->warn((Formatter::format("GenMeshletsProcess: Meshlet limits clamped to "),
+			configMaxVertices," vertices and ",configMaxTriangles," triangles"));
+	}
+
+	configNumThreads = GetNumThreads(pImp);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenMeshletsProcess::Execute( aiScene* pScene)
+{
+	DefaultLogger::get()->debug("GenMeshletsProcess begin");
+
+	const int numMeshes = static_cast<int>(pScene->mNumMeshes);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(dynamic,1) num_threads(configNumThreads) if(configNumThreads > 1 && numMeshes > 1)
+#endif
+	for (int i = 0; i < numMeshes; ++i) {
+		aiMesh* mesh = pScene->mMeshes[i];
+
+		delete mesh->mMeshlets;
+		mesh->mMeshlets = NULL;
+
+		if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+			continue;
+		}
+		mesh->mMeshlets = BuildMeshlets(mesh,configMaxVertices,configMaxTriangles);
+	}
+
+	if (!DefaultLogger::isNullLogger()) {
+		unsigned int numMeshlets = 0, numVertices = 0, numTriangles = 0;
+		for (int i = 0; i < numMeshes; ++i) {
+			const aiMeshletTable* t = pScene->mMeshes[i]->mMeshlets;
+			if (!t) {
+				DefaultLogger::get()->warn((Formatter::format("GenMeshletsProcess: Skipping mesh "),
+					i,", it does not consist of triangles only"));
+				continue;
+			}
+			numMeshlets += t->mNumMeshlets;
+			numVertices += t->mNumVertices;
+			numTriangles += t->mNumTriangles;
+		}
+		if (numMeshlets) {
+			DefaultLogger::get()->info((Formatter::format("GenMeshletsProcess finished. "),
+				numMeshlets," meshlets, on average ",static_cast<float>(numVertices) / numMeshlets,
+				" vertices and ",static_cast<float>(numTriangles) / numMeshlets," triangles"));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partition the triangles of a single mesh into meshlets
+aiMeshletTable* GenMeshletsProcess::BuildMeshlets(aiMesh* pMesh, 
+	unsigned int pMaxVertices, unsigned int pMaxTriangles)
+{
+	ai_assert(pMaxVertices >= 3 && pMaxVertices <= 256 && pMaxTriangles >= 1);
+
+	const unsigned int numFaces = pMesh->mNumFaces;
+	VertexTriangleAdjacency adj(pMesh->mFaces,numFaces,pMesh->mNumVertices,true);
+
+	std::vector<bool> emitted(numFaces,false);
+	std::vector<int> local(pMesh->mNumVertices,-1);
+
+	std::vector<aiMeshlet> meshlets;
+	std::vector<unsigned int> verts;
+	std::vector<unsigned char> tris;
+
+	// triangles adjacent to the vertices of the current meshlet
+	std::vector<unsigned int> candidates;
+
+	aiMeshlet cur = aiMeshlet();
+	unsigned int next = 0;
+
+	for (;;) {
+		// Grow the meshlet by the adjacent triangle which adds the fewest 
+		// vertices. This keeps the meshlet compact and the vertex reuse high.
+		unsigned int best = UINT_MAX, bestNew = 4;
+		for (unsigned int c = 0; c < candidates.size(); ) {
+			const unsigned int t = candidates[c];
+			if (emitted[t]) {
+				candidates[c] = candidates.back();
+				candidates.pop_back();
+				continue;
+			}
+
+			const aiFace& f = pMesh->mFaces[t];
+			const unsigned int numNew = (local[f.mIndices[0]] < 0) + (local[f.mIndices[1]] < 0) + (local[f.mIndices[2]] < 0);
+			if (numNew < bestNew) {
+				best = t;
+				bestNew = numNew;
+				if (!numNew) {
+					break;
+				}
+			}
+			++c;
+		}
+
+		// no connected triangles left, continue with the next one in order
+		if (best == UINT_MAX) {
+			while (next < numFaces && emitted[next]) {
+				++next;
+			}
+			if (next == numFaces) {
+				break;
+			}
+			best = next;
+			const aiFace& f = pMesh->mFaces[best];
+			bestNew = (local[f.mIndices[0]] < 0) + (local[f.mIndices[1]] < 0) + (local[f.mIndices[2]] < 0);
+		}
+
+		// flush the meshlet if the triangle does not fit anymore
+		if (cur.mNumVertices + bestNew > pMaxVertices || cur.mNumTriangles == pMaxTriangles) {
+			for (unsigned int i = 0; i < cur.mNumVertices; ++i) {
+				local[verts[cur.mVertexOffset + i]] = -1;
+			}
+			meshlets.push_back(cur);
+
+			cur = aiMeshlet();
+			cur.mVertexOffset = static_cast<unsigned int>(verts.size());
+			cur.mTriangleOffset = static_cast<unsigned int>(tris.size() / 3);
+			candidates.clear();
+		}
+
+		const aiFace& f = pMesh->mFaces[best];
+		for (unsigned int i = 0; i < 3; ++i) {
+			const unsigned int idx = f.mIndices[i];
+			if (local[idx] < 0) {
+				local[idx] = static_cast<int>(cur.mNumVertices++);
+				verts.push_back(idx);
+
+				const unsigned int* const adjacent = adj.GetAdjacentTriangles(idx);
+				candidates.insert(candidates.end(),adjacent,adjacent + adj.GetNumTrianglesPtr(idx));
+			}
+			tris.push_back(static_cast<unsigned char>(local[idx]));
+		}
+		++cur.mNumTriangles;
+		emitted[best] = true;
+	}
+	if (cur.mNumTriangles) {
+		meshlets.push_back(cur);
+	}
+
+	aiMeshletTable* out = new aiMeshletTable();
+	out->mMaxVertices = pMaxVertices;
+	out->mMaxTriangles = pMaxTriangles;
+
+	out->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+	out->mMeshlets = new aiMeshlet[out->mNumMeshlets];
+	std::copy(meshlets.begin(),meshlets.end(),out->mMeshlets);
+
+	out->mNumVertices = static_cast<unsigned int>(verts.size());
+	out->mVertices = new unsigned int[out->mNumVertices];
+	std::copy(verts.begin(),verts.end(),out->mVertices);
+
+	out->mNumTriangles = static_cast<unsigned int>(tris.size() / 3);
+	out->mTriangles = new unsigned char[tris.size()];
+	std::copy(tris.begin(),tris.end(),out->mTriangles);
+
+	for (unsigned int i = 0; i < out->mNumMeshlets; ++i) {
+		aiMeshlet& m = out->mMeshlets[i];
+		ComputeMeshletBounds(pMesh,out->mVertices + m.mVertexOffset,out->mTriangles + m.mTriangleOffset * 3,m);
+	}
+	return out;
+}
+
+#endif // !! ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
@@ -0,0 +1,97 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file GenMeshletsProcess.h
+ *  @brief Defines a post processing step to partition meshes into meshlets
+ */
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+struct aiMeshletTable;
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** The GenMeshletsProcess generates an #aiMeshletTable for each triangle mesh,
+ *  see #aiProcess_GenMeshlets. Meshes are processed in parallel.
+ */
+class GenMeshletsProcess : public BaseProcess
+{
+public:
+
+	GenMeshletsProcess();
+	~GenMeshletsProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	void Execute( aiScene* pScene);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Partition the triangles of a single mesh into meshlets.
+	 *  @param pMesh Mesh to be processed, must consist of triangles only.
+	 *  @param pMaxVertices Maximum number of vertices per meshlet, <= 256
+	 *  @param pMaxTriangles Maximum number of triangles per meshlet
+	 *  @return A new meshlet table, to be owned by the caller */
+	static aiMeshletTable* BuildMeshlets(aiMesh* pMesh, 
+		unsigned int pMaxVertices, unsigned int pMaxTriangles);
+
+private:
+
+	unsigned int configMaxVertices;
+	unsigned int configMaxTriangles;
+	int configNumThreads;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
@@ -48,14 +48,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
+#include "ParallelHelper.h"
 
 using namespace Assimp;
 
+// Meshes with fewer faces/vertices than this are always processed serially,
+// the overhead of starting the worker threads would dominate.
+#define AI_GSN_PARALLEL_THRESHOLD 4096
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess()
 {
 	this->configMaxAngle = AI_DEG_TO_RAD(175.f);
+	this->configNumThreads = 1;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -79,6 +85,8 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
 	// Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
 	configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,175.f);
 	configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle,175.0f),0.0f));
+
+	configNumThreads = GetNumThreads(pImp);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -105,6 +113,59 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
 		"Normals are already there");
 }
 
+// ------------------------------------------------------------------------------------------------
+// Computes the normalized normal vectors of all faces of a mesh. Points and lines
+// receive qnan normals, they are skipped when the vertex normals are accumulated.
+static void ComputeFaceNormals(const aiMesh* pMesh, aiVector3D* pcOut, int numThreads)
+{
+	const float qnan = std::numeric_limits<float>::quiet_NaN();
+	const aiVector3D* const pcVerts = pMesh->mVertices;
+	const aiFace* const pcFaces = pMesh->mFaces;
+	const int iNumFaces = static_cast<int>(pMesh->mNumFaces);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(static) num_threads(numThreads) if(iNumFaces > AI_GSN_PARALLEL_THRESHOLD)
+#else
+	(void)numThreads;
+#endif
+	for (int a = 0; a < iNumFaces; ++a)	{
+		const aiFace& face = pcFaces[a];
+		if (face.mNumIndices < 3) {
+			pcOut[a] = aiVector3D(qnan);
+			continue;
+		}
+
+		const aiVector3D& v1 = pcVerts[face.mIndices[0]];
+		const aiVector3D& v2 = pcVerts[face.mIndices[1]];
+		const aiVector3D& v3 = pcVerts[face.mIndices[face.mNumIndices-1]];
+
+		// cross product and normalization, written out so the compiler 
+		// keeps everything in registers
+		const float ax = v2.x - v1.x, ay = v2.y - v1.y, az = v2.z - v1.z;
+		const float bx = v3.x - v1.x, by = v3.y - v1.y, bz = v3.z - v1.z;
+		const float nx = ay*bz - az*by, ny = az*bx - ax*bz, nz = ax*by - ay*bx;
+		const float inv = 1.f / ::sqrt(nx*nx + ny*ny + nz*nz);
+		pcOut[a] = aiVector3D(nx*inv, ny*inv, nz*inv);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether any vertex of the mesh is referenced by more than one face
+static bool HasSharedVertices(const aiMesh* pMesh)
+{
+	std::vector<bool> abRef(pMesh->mNumVertices,false);
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+			if (abRef[face.mIndices[i]]) {
+				return true;
+			}
+			abRef[face.mIndices[i]] = true;
+		}
+	}
+	return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int meshIndex)
@@ -121,61 +182,135 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 		return false;
 	}
 
-	// Allocate the array to hold the output normals
-	const float qnan = std::numeric_limits<float>::quiet_NaN();
-	pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-
-	// Compute per-face normals but store them per-vertex
-	for( unsigned int a = 0; a < pMesh->mNumFaces; a++)
-	{
-		const aiFace& face = pMesh->mFaces[a];
-		if (face.mNumIndices < 3)
-		{
-			// either a point or a line -> no normal vector
-			for (unsigned int i = 0;i < face.mNumIndices;++i) {
-				pMesh->mNormals[face.mIndices[i]] = aiVector3D(qnan);
-			}
-
-			continue;
-		}
+	// Compute all face normals first. The vertex normals are gathered from
+	// this array, so every output vertex can be processed independently.
+	std::vector<aiVector3D> faceNormals(pMesh->mNumFaces);
+	ComputeFaceNormals(pMesh,&faceNormals[0],configNumThreads);
 
-		const aiVector3D* pV1 = &pMesh->mVertices[face.mIndices[0]];
-		const aiVector3D* pV2 = &pMesh->mVertices[face.mIndices[1]];
-		const aiVector3D* pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices-1]];
-		const aiVector3D vNor = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).Normalize();
+	aiVector3D* pcNew = new aiVector3D[pMesh->mNumVertices];
 
-		for (unsigned int i = 0;i < face.mNumIndices;++i) {
-			pMesh->mNormals[face.mIndices[i]] = vNor;
-		}
+	// If the loader has already welded the vertices, the faces around a vertex
+	// can be taken directly from the index buffer. Otherwise every vertex 
+	// belongs to a single face and the neighbours are found by position only.
+	if (HasSharedVertices(pMesh)) {
+		GenWeldedVertexNormals(pMesh,meshIndex,&faceNormals[0],pcNew);
+	}
+	else {
+		GenVerboseVertexNormals(pMesh,meshIndex,&faceNormals[0],pcNew);
 	}
 
-	// Set up a SpatialSort to quickly find all vertices close to a given position
+	pMesh->mNormals = pcNew;
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Set up a SpatialSort to quickly find all vertices close to a given position
+SpatialSort* GenVertexNormalsProcess::GetVertexFinder (const aiMesh* pMesh, unsigned int meshIndex,
+	SpatialSort& localFinder, float& posEpsilon) const
+{
 	// check whether we can reuse the SpatialSort of a previous step.
-	SpatialSort* vertexFinder = NULL;
-	SpatialSort  _vertexFinder;
-	float posEpsilon = 1e-5f;
 	if (shared)	{
 		std::vector<std::pair<SpatialSort,float> >* avf;
 		shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
 		if (avf)
 		{
 			std::pair<SpatialSort,float>& blubb = avf->operator [] (meshIndex);
-			vertexFinder = &blubb.first;
 			posEpsilon = blubb.second;
+			return &blubb.first;
 		}
 	}
-	if (!vertexFinder)	{
-		_vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-		vertexFinder = &_vertexFinder;
-		posEpsilon = ComputePositionEpsilon(pMesh);
+	localFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
+	posEpsilon = ComputePositionEpsilon(pMesh);
+	return &localFinder;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::GenWeldedVertexNormals (const aiMesh* pMesh, unsigned int meshIndex,
+	const aiVector3D* faceNormals, aiVector3D* pcOut) const
+{
+	// Loaders share vertices only where all attributes match, so there may still 
+	// be several vertices at one position, e.g. along UV or material seams. Those 
+	// are welded once to keep seams smooth, like on the verbose code path.
+	SpatialSort _vertexFinder;
+	float posEpsilon;
+	const SpatialSort* vertexFinder = GetVertexFinder(pMesh,meshIndex,_vertexFinder,posEpsilon);
+
+	std::vector<unsigned int> weldTable;
+	const unsigned int iNumWelded = vertexFinder->GenerateMappingTable(weldTable,posEpsilon);
+
+	// Collect the faces around every welded position. Like the verbose code path,
+	// the angle limit is measured against the normal of the last face referencing
+	// a vertex.
+	std::vector<unsigned int> weldOffsets(iNumWelded+1,0);
+	std::vector<unsigned int> lastFace(pMesh->mNumVertices,UINT_MAX);
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+			++weldOffsets[weldTable[face.mIndices[i]]+1];
+			lastFace[face.mIndices[i]] = a;
+		}
 	}
-	std::vector<unsigned int> verticesFound;
-	aiVector3D* pcNew = new aiVector3D[pMesh->mNumVertices];
+	for (unsigned int w = 0; w < iNumWelded; ++w) {
+		weldOffsets[w+1] += weldOffsets[w];
+	}
+	std::vector<unsigned int> weldFaces(weldOffsets[iNumWelded]);
+	std::vector<unsigned int> cursor(weldOffsets.begin(),weldOffsets.end()-1);
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+			weldFaces[cursor[weldTable[face.mIndices[i]]]++] = a;
+		}
+	}
+
+	const float qnan = std::numeric_limits<float>::quiet_NaN();
+	const bool bLimit = configMaxAngle < AI_DEG_TO_RAD( 175.f );
+	const float fLimit = ::cos(configMaxAngle); 
+	const int iNumVertices = static_cast<int>(pMesh->mNumVertices);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(static) num_threads(configNumThreads) if(iNumVertices > AI_GSN_PARALLEL_THRESHOLD)
+#endif
+	for (int i = 0; i < iNumVertices; ++i) {
+		const unsigned int w = weldTable[i];
+		const aiVector3D vRef = lastFace[i] != UINT_MAX ? faceNormals[lastFace[i]] : aiVector3D(qnan);
+
+		// gather the normals of all faces around the welded position
+		aiVector3D pcNor;
+		for (unsigned int a = weldOffsets[w]; a < weldOffsets[w+1]; ++a) {
+			const aiVector3D& v = faceNormals[weldFaces[a]];
+			if (bLimit ? !(v * vRef >= fLimit) : !is_not_qnan(v.x)) {
+				continue;
+			}
+			pcNor += v;
+		}
+		pcOut[i] = pcNor.Normalize();
+	}
+}
 
-	if (configMaxAngle >= AI_DEG_TO_RAD( 175.f ))	{
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::GenVerboseVertexNormals (const aiMesh* pMesh, unsigned int meshIndex,
+	const aiVector3D* faceNormals, aiVector3D* pcOut) const
+{
+	// Store the face normals per vertex
+	const float qnan = std::numeric_limits<float>::quiet_NaN();
+	std::vector<aiVector3D> vertexNormals(pMesh->mNumVertices,aiVector3D(qnan));
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+			vertexNormals[face.mIndices[i]] = faceNormals[a];
+		}
+	}
+
+	SpatialSort _vertexFinder;
+	float posEpsilon;
+	const SpatialSort* vertexFinder = GetVertexFinder(pMesh,meshIndex,_vertexFinder,posEpsilon);
+
+	const bool bLimit = configMaxAngle < AI_DEG_TO_RAD( 175.f );
+	if (!bLimit && configNumThreads == 1)	{
 		// There is no angle limit. Thus all vertices with positions close
 		// to each other will receive the same vertex normal. This allows us
 		// to optimize the whole algorithm a little bit ...
+		std::vector<unsigned int> verticesFound;
 		std::vector<bool> abHad(pMesh->mNumVertices,false);
 		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
 			if (abHad[i]) {
@@ -187,7 +322,7 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 
 			aiVector3D pcNor; 
 			for (unsigned int a = 0; a < verticesFound.size(); ++a)	{
-				const aiVector3D& v = pMesh->mNormals[verticesFound[a]];
+				const aiVector3D& v = vertexNormals[verticesFound[a]];
 				if (is_not_qnan(v.x))pcNor += v;
 			}
 			pcNor.Normalize();
@@ -196,38 +331,45 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 			for (unsigned int a = 0; a < verticesFound.size(); ++a)
 			{
 				register unsigned int vidx = verticesFound[a];
-				pcNew[vidx] = pcNor;
+				pcOut[vidx] = pcNor;
 				abHad[vidx] = true;
 			}
 		}
+		return;
 	}
-	// Slower code path if a smooth angle is set. There are many ways to achieve
-	// the effect, this one is the most straightforward one.
-	else	{
-		const float fLimit = ::cos(configMaxAngle); 
-		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
+
+	// Generic code path, used if a smooth angle is set or if multiple threads
+	// are available. Every vertex searches for its neighbours on its own, so
+	// the loop can be split across threads.
+	const float fLimit = ::cos(configMaxAngle); 
+	const int iNumVertices = static_cast<int>(pMesh->mNumVertices);
+
+#ifdef _OPENMP
+#	pragma omp parallel num_threads(configNumThreads) if(iNumVertices > AI_GSN_PARALLEL_THRESHOLD)
+#endif
+	{
+		std::vector<unsigned int> verticesFound;
+
+#ifdef _OPENMP
+#		pragma omp for schedule(dynamic,256)
+#endif
+		for (int i = 0; i < iNumVertices; ++i)	{
 			// Get all vertices that share this one ...
 			vertexFinder->FindPositions( pMesh->mVertices[i] , posEpsilon, verticesFound);
 
+			const aiVector3D& vRef = vertexNormals[i];
 			aiVector3D pcNor; 
 			for (unsigned int a = 0; a < verticesFound.size(); ++a)	{
-				const aiVector3D& v = pMesh->mNormals[verticesFound[a]];
+				const aiVector3D& v = vertexNormals[verticesFound[a]];
 
-				// check whether the angle between the two normals is not too large
-				// HACK: if v.x is qnan the dot product will become qnan, too
-				//   therefore the comparison against fLimit should be false
-				//   in every case. 
-				if (v * pMesh->mNormals[i] < fLimit)
+				// check whether the angle between the two normals is not too large.
+				// qnan normals of points and lines fail both comparisons.
+				if (bLimit ? !(v * vRef >= fLimit) : !is_not_qnan(v.x)) {
 					continue;
-
+				}
 				pcNor += v;
 			}
-			pcNew[i] = pcNor.Normalize();
+			pcOut[i] = pcNor.Normalize();
 		}
 	}
-
-	delete[] pMesh->mNormals;
-	pMesh->mNormals = pcNew;
-
-	return true;
 }
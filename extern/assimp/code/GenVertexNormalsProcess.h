@@ -50,11 +50,15 @@ class GenNormalsTest;
 
 namespace Assimp {
 
+class SpatialSort;
+
 // ---------------------------------------------------------------------------
 /** The GenFaceNormalsProcess computes vertex normals for all vertizes
 */
 class ASSIMP_API_WINONLY GenVertexNormalsProcess : public BaseProcess
 {
+	friend class ::GenNormalsTest;
+
 public:
 
 	GenVertexNormalsProcess();
@@ -101,10 +105,50 @@ public:
 	*/
 	bool GenMeshVertexNormals (aiMesh* pcMesh, unsigned int meshIndex);
 
+private:
+
+	// -------------------------------------------------------------------
+	/** Get a SpatialSort of the vertices of a mesh, the one of a previous
+	*  step is reused if it is available.
+	*  @param pcMesh Mesh
+	*  @param meshIndex Index of the mesh
+	*  @param localFinder Filled and returned if there is none to reuse
+	*  @param posEpsilon Receives the epsilon for position searches
+	*/
+	SpatialSort* GetVertexFinder (const aiMesh* pcMesh, unsigned int meshIndex,
+		SpatialSort& localFinder, float& posEpsilon) const;
+
+	// -------------------------------------------------------------------
+	/** Smooth normals of a mesh whose faces share their vertices. The
+	*  vertices are welded by position once using a SpatialSort, the
+	*  faces around every welded position are gathered from the index buffer.
+	*  @param pcMesh Mesh
+	*  @param meshIndex Index of the mesh
+	*  @param faceNormals Normalized face normals of the mesh
+	*  @param pcOut Receives the vertex normals
+	*/
+	void GenWeldedVertexNormals (const aiMesh* pcMesh, unsigned int meshIndex,
+		const aiVector3D* faceNormals, aiVector3D* pcOut) const;
+
+	// -------------------------------------------------------------------
+	/** Smooth normals of a mesh in which each vertex belongs to exactly
+	*  one face. A SpatialSort is used to find all vertices close to a 
+	*  vertex.
+	*  @param pcMesh Mesh
+	*  @param meshIndex Index of the mesh
+	*  @param faceNormals Normalized face normals of the mesh
+	*  @param pcOut Receives the vertex normals
+	*/
+	void GenVerboseVertexNormals (const aiMesh* pcMesh, unsigned int meshIndex,
+		const aiVector3D* faceNormals, aiVector3D* pcOut) const;
+
 private:
 
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
+
+	/** Number of threads to be used, see #AI_CONFIG_GLOB_MULTITHREADING */
+	int configNumThreads;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,262 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file HeaderCacheIOSystem.h
+ *  IOSystem wrapper which reads the header of a file only once, for use during
+ *  file format detection. */
+#ifndef AI_HEADERCACHEIOSYSTEM_H_INC
+#define AI_HEADERCACHEIOSYSTEM_H_INC
+
+namespace Assimp	{
+
+// Number of bytes at the start of a file which are kept in memory
+#define AI_HEADER_CACHE_SIZE 4096
+
+class HeaderCacheIOSystem;
+
+// ----------------------------------------------------------------------------------
+/** Read-only stream which serves reads from the cached header of a
+ *  #HeaderCacheIOSystem. Reads beyond the cached header are passed to the
+ *  underlying file, which is only opened if needed. */
+// ----------------------------------------------------------------------------------
+class HeaderCacheIOStream : public IOStream
+{
+public:
+	HeaderCacheIOStream (IOSystem* io, const std::string& file,
+		const std::vector<uint8_t>& header, size_t fileSize)
+		: io(io)
+		, file(file)
+		, header(header)
+		, fileSize(fileSize)
+		, pos((size_t)0)
+		, stream(NULL)
+	{
+	}
+
+public:
+
+	~HeaderCacheIOStream ()	{
+		if (stream) {
+			io->Close(stream);
+		}
+	}
+
+	// -------------------------------------------------------------------
+	// Read from stream
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount)	{
+		if (!pSize || !pCount || pos >= fileSize) {
+			return 0;
+		}
+
+		// entirely within the header, or the header is the whole file
+		if (pos + pSize*pCount <= header.size() || header.size() == fileSize) {
+			const size_t cnt = std::min(pCount,(header.size()-pos)/pSize),ofs = pSize*cnt;
+
+			memcpy(pvBuffer,&header[0]+pos,ofs);
+			pos += ofs;
+			return cnt;
+		}
+
+		if (!stream) {
+			stream = io->Open(file,"rb");
+			if (!stream) {
+				return 0;
+			}
+		}
+		stream->Seek(pos,aiOrigin_SET);
+		const size_t cnt = stream->Read(pvBuffer,pSize,pCount);
+		pos = stream->Tell();
+		return cnt;
+	}
+
+	// -------------------------------------------------------------------
+	// Write to stream
+	size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/,size_t /*pCount*/)	{
+		ai_assert(false); // won't be needed
+		return 0;
+	}
+
+	// -------------------------------------------------------------------
+	// Seek specific position
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+		size_t target;
+		if (aiOrigin_SET == pOrigin) {
+			target = pOffset;
+		}
+		else if (aiOrigin_END == pOrigin) {
+			if (pOffset > fileSize) {
+				return AI_FAILURE;
+			}
+			target = fileSize-pOffset;
+		}
+		else {
+			target = pos+pOffset;
+		}
+
+		if (target > fileSize) {
+			return AI_FAILURE;
+		}
+		pos = target;
+		return AI_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------
+	// Get current seek position
+	size_t Tell() const {
+		return pos;
+	}
+
+	// -------------------------------------------------------------------
+	// Get size of file
+	size_t FileSize() const {
+		return fileSize;
+	}
+
+	// -------------------------------------------------------------------
+	// Flush file contents
+	void Flush() {
+		ai_assert(false); // won't be needed
+	}
+
+private:
+	IOSystem* io;
+	const std::string& file;
+	const std::vector<uint8_t>& header;
+	size_t fileSize, pos;
+	IOStream* stream;
+};
+
+// ---------------------------------------------------------------------------
+/** IO system wrapper to be passed to BaseImporter::CanRead() while looking
+ *  for an importer for a file. The first #AI_HEADER_CACHE_SIZE bytes of the
+ *  file are read once, on the first request, and every stream opened for the
+ *  file afterwards reads from this copy. This way, probing dozens of importers
+ *  costs a single small read instead of opening the file again and again for
+ *  each signature check. All other files are passed through. */
+class HeaderCacheIOSystem : public IOSystem
+{
+public:
+	/** Constructor.
+	 *  @param io IO system to read the file with
+	 *  @param file File to be cached */
+	HeaderCacheIOSystem (IOSystem* io, const std::string& file)
+		: io(io), file(file), fileSize(0), loaded(false), valid(false) {
+	}
+
+	/** Destructor. */
+	~HeaderCacheIOSystem() {
+	}
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file at the given path. */
+	bool Exists( const char* pFile) const {
+		return io->Exists(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Returns the directory separator. */
+	char getOsSeparator() const {
+		return io->getOsSeparator();
+	}
+
+	// -------------------------------------------------------------------
+	/** Open a new file with a given path. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb") {
+		if (file != pFile || strchr(pMode,'w') || strchr(pMode,'a') || strchr(pMode,'+')) {
+			return io->Open(pFile,pMode);
+		}
+
+		if (!loaded) {
+			Load();
+		}
+		return valid ? new HeaderCacheIOStream(io,file,header,fileSize) : NULL;
+	}
+
+	// -------------------------------------------------------------------
+	/** Closes the given file and releases all resources associated with it. */
+	void Close( IOStream* pFile) {
+		if (dynamic_cast<HeaderCacheIOStream*>(pFile)) {
+			delete pFile;
+			return;
+		}
+		io->Close(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Compare two paths */
+	bool ComparePaths (const char* one, const char* second) const {
+		return io->ComparePaths(one,second);
+	}
+
+private:
+
+	// -------------------------------------------------------------------
+	/** Read the header of the file */
+	void Load() {
+		loaded = true;
+
+		IOStream* stream = io->Open(file,"rb");
+		if (!stream) {
+			return;
+		}
+
+		fileSize = stream->FileSize();
+		header.resize(std::min(fileSize,(size_t)AI_HEADER_CACHE_SIZE));
+		if (!header.empty()) {
+			header.resize(stream->Read(&header[0],1,header.size()));
+		}
+
+		// a short read leaves us with less than the file size promises,
+		// reads beyond the header will go to the file
+		io->Close(stream);
+		valid = true;
+	}
+
+private:
+	IOSystem* io;
+	std::string file;
+	std::vector<uint8_t> header;
+	size_t fileSize;
+	bool loaded, valid;
+};
+
+} // end namespace Assimp
+
+#endif // !! AI_HEADERCACHEIOSYSTEM_H_INC
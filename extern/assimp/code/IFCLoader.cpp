@@ -156,6 +156,8 @@ void IFCImporter::SetupProperties(const Importer* pImp)
 
 	settings.conicSamplingAngle = 10.f;
 	settings.skipAnnotations = true;
+
+	settings.filter.SetupProperties(pImp);
 }
 
 
@@ -295,6 +297,10 @@ void IFCImporter::InternReadFile( const std::string& pFile,
 
 	pScene->mRootNode->mTransformation = rot * scale * conv.wcs * pScene->mRootNode->mTransformation;
 
+	if (settings.filter.IsStructureOnly()) {
+		pScene->mFlags |= AI_SCENE_FLAGS_STRUCTURE_ONLY;
+	}
+
 	// this must be last because objects are evaluated lazily as we process them
 	if ( !DefaultLogger::isNullLogger() ){
 		LogDebug((Formatter::format(),"STEP: evaluated ",db->GetEvaluatedObjectCount()," object records"));
@@ -577,6 +583,13 @@ void ProcessProductRepresentation(const IfcProduct& el, aiNode* nd, std::vector<
 	AssignAddedMeshes(meshes,nd,conv);
 }
 
+// ------------------------------------------------------------------------------------------------
+bool IsProductSelected(const IfcProduct& el, const aiNode& nd, ConversionData& conv)
+{
+	const ImportFilter& filter = conv.settings.filter;
+	return filter.IsNodeSelected(nd.mName.C_Str()) || filter.IsNodeSelected(el.GlobalId) || (el.Name && filter.IsNodeSelected(el.Name.Get()));
+}
+
 // ------------------------------------------------------------------------------------------------
 aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, ConversionData& conv, std::vector<TempOpening>* collect_openings = NULL)
 {
@@ -606,6 +619,12 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 		ResolveObjectPlacement(nd->mTransformation,el.ObjectPlacement.Get(),conv);
 	}
 
+	// if only parts of the file are imported, products outside the selected subtrees
+	// are kept as plain nodes (and only if they have selected descendants).
+	const bool was_in_selection = conv.in_selection;
+	const bool selected = was_in_selection || IsProductSelected(el,*nd,conv);
+	conv.in_selection = selected;
+
 	std::vector<TempOpening> openings;
 
 	IfcMatrix4 myInv;
@@ -699,7 +718,9 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 					}
 				}
 			
-				subnodes.push_back( nd_aggr.release() );
+				if(nd_aggr->mNumChildren || !conv.settings.filter.HasNodeFilter()) {
+					subnodes.push_back( nd_aggr.release() );
+				}
 			}
 		}
 
@@ -708,7 +729,9 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 			conv.apply_openings = &openings;
 		}
 
-		ProcessProductRepresentation(el,nd.get(),subnodes,conv);
+		if(selected && !conv.settings.filter.IsStructureOnly()) {
+			ProcessProductRepresentation(el,nd.get(),subnodes,conv);
+		}
 		conv.apply_openings = conv.collect_openings = NULL;
 
 		if (subnodes.size()) {
@@ -722,9 +745,16 @@ aiNode* ProcessSpatialStructure(aiNode* parent, const IfcProduct& el, Conversion
 	catch(...) {
 		// it hurts, but I don't want to pull boost::ptr_vector into -noboost only for these few spots here
 		std::for_each(subnodes.begin(),subnodes.end(),delete_fun<aiNode>());
+		conv.in_selection = was_in_selection;
 		throw;
 	}
 
+	conv.in_selection = was_in_selection;
+
+	// drop branches which contain nothing that has been selected
+	if(!selected && !nd->mNumChildren && parent) {
+		return NULL;
+	}
 	return nd.release();
 }
 
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 #include "LogAux.h"
+#include "ImportFilter.h"
 
 namespace Assimp	{
 	
@@ -119,6 +120,9 @@ public:
 		bool useCustomTriangulation;
 		bool skipAnnotations;
 		float conicSamplingAngle;
+
+		// products to be imported, by name or GlobalId
+		ImportFilter filter;
 	};
 	
 	
@@ -107,6 +107,7 @@ struct ConversionData
 		, settings(settings)
 		, apply_openings()
 		, collect_openings()
+		, in_selection()
 	{}
 
 	~ConversionData() {
@@ -138,6 +139,10 @@ struct ConversionData
 	// for later processing by a parent, which is a wall. 
 	std::vector<TempOpening>* apply_openings;
 	std::vector<TempOpening>* collect_openings;
+
+	// true while converting the subtree of a product which has been
+	// selected by the node filter, see #AI_CONFIG_IMPORT_NODE_FILTER
+	bool in_selection;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,71 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file Implementation of the ImportFilter helper */
+
+#include "AssimpPCH.h"
+
+#include "ImportFilter.h"
+#include "ProcessHelper.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+void ImportFilter::SetupProperties(const Importer* pImp)
+{
+	nodes.clear();
+	animations.clear();
+
+	std::list<std::string> names;
+	ConvertListToStrings(pImp->GetPropertyString(AI_CONFIG_IMPORT_NODE_FILTER,""),names);
+	nodes.insert(names.begin(),names.end());
+
+	names.clear();
+	ConvertListToStrings(pImp->GetPropertyString(AI_CONFIG_IMPORT_ANIMATION_FILTER,""),names);
+	animations.insert(names.begin(),names.end());
+
+	structureOnly = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STRUCTURE_ONLY,false);
+
+	if (!nodes.empty() || !animations.empty()) {
+		DefaultLogger::get()->info((Formatter::format("Partial import, "),nodes.size(),
+			" selected nodes, ",animations.size()," selected animations"));
+	}
+}
@@ -0,0 +1,112 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ImportFilter.h
+ *  @brief Helper for loaders which can import parts of a file only
+ */
+#ifndef AI_IMPORTFILTER_H_INC
+#define AI_IMPORTFILTER_H_INC
+
+#include <set>
+#include <string>
+
+namespace Assimp	{
+
+class Importer;
+
+// ---------------------------------------------------------------------------
+/** @brief Selection of the nodes and animations to be imported.
+ *
+ *  Loaders which support partial imports read the selection from the
+ *  #AI_CONFIG_IMPORT_NODE_FILTER, #AI_CONFIG_IMPORT_ANIMATION_FILTER and
+ *  #AI_CONFIG_IMPORT_STRUCTURE_ONLY properties in their SetupProperties()
+ *  and skip reading everything that is not selected. An empty filter
+ *  selects everything.
+ */
+class ImportFilter
+{
+public:
+
+	ImportFilter()
+		: structureOnly(false)
+	{}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Read the filter from the configuration of an importer */
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	/** Check whether only the scene structure is to be imported */
+	bool IsStructureOnly() const {
+		return structureOnly;
+	}
+
+	// -------------------------------------------------------------------
+	/** Check whether the node selection is restricted at all */
+	bool HasNodeFilter() const {
+		return !nodes.empty();
+	}
+
+	// -------------------------------------------------------------------
+	/** Check whether a node (and thus its subtree) has been selected
+	 *  by name. Always true if there is no node filter. */
+	bool IsNodeSelected(const std::string& name) const {
+		return nodes.empty() || nodes.find(name) != nodes.end();
+	}
+
+	// -------------------------------------------------------------------
+	/** Check whether an animation has been selected by name. Always
+	 *  true if there is no animation filter. */
+	bool IsAnimationSelected(const std::string& name) const {
+		return animations.empty() || animations.find(name) != animations.end();
+	}
+
+private:
+
+	std::set<std::string> nodes, animations;
+	bool structureOnly;
+};
+
+} // !namespace Assimp
+
+#endif // !! AI_IMPORTFILTER_H_INC
@@ -71,6 +71,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "ScenePreprocessor.h"
 #include "MemoryIOWrapper.h"
+#include "HeaderCacheIOSystem.h"
 #include "Profiler.h"
 #include "TinyFormatter.h"
 
@@ -608,11 +609,13 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			profiler->BeginRegion("total");
 		}
 
-		// Find an worker class which can handle the file
+		// Find an worker class which can handle the file. All importers look at
+		// the same file header, so it is read only once for all of them.
+		HeaderCacheIOSystem probeIOHandler(pimpl->mIOHandler,pFile);
 		BaseImporter* imp = NULL;
 		for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
 
-			if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
+			if( pimpl->mImporter[a]->CanRead( pFile, &probeIOHandler, false)) {
 				imp = pimpl->mImporter[a];
 				break;
 			}
@@ -625,7 +628,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 				DefaultLogger::get()->info("File extension not known, trying signature-based detection");
 				for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
 
-					if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
+					if( pimpl->mImporter[a]->CanRead( pFile, &probeIOHandler, true)) {
 						imp = pimpl->mImporter[a];
 						break;
 					}
@@ -654,15 +657,29 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			profiler->EndRegion("import");
 		}
 
+		// Scenes which only describe the structure of the file are handed out
+		// as they are, the post processing steps would choke on them. Loaders
+		// which ignore AI_CONFIG_IMPORT_STRUCTURE_ONLY return full scenes.
+		if( pimpl->mScene && (pimpl->mScene->mFlags & AI_SCENE_FLAGS_STRUCTURE_ONLY))	{
+			pimpl->mScene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+		}
 		// If successful, apply all active post processing steps to the imported data
-		if( pimpl->mScene)	{
+		else if( pimpl->mScene)	{
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 			// The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
 			if (pFlags & aiProcess_ValidateDataStructure)
 			{
+				if (profiler) {
+					profiler->BeginRegion("validate");
+				}
+
 				ValidateDSProcess ds;
 				ds.ExecuteOnScene (this);
+
+				if (profiler) {
+					profiler->EndRegion("validate");
+				}
 				if (!pimpl->mScene) {
 					return NULL;
 				}
@@ -737,13 +754,23 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	ai_assert(_ValidateFlags(pFlags));
 	DefaultLogger::get()->info("Entering post processing pipeline");
 
+	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 	// The ValidateDS process plays an exceptional role. It isn't contained in the global
 	// list of post-processing steps, so we need to call it manually.
 	if (pFlags & aiProcess_ValidateDataStructure)
 	{
+		if (profiler) {
+			profiler->BeginRegion("validate");
+		}
+
 		ValidateDSProcess ds;
 		ds.ExecuteOnScene (this);
+
+		if (profiler) {
+			profiler->EndRegion("validate");
+		}
 		if (!pimpl->mScene) {
 			return NULL;
 		}
@@ -763,7 +790,6 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	}
 #endif // ! DEBUG
 
-	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
 	for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
 
 		BaseProcess* process = pimpl->mPostProcessingSteps[a];
@@ -1016,6 +1042,19 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
 			}
 			else break;
 		}
+		if (mScene->mMeshes[i]->HasQuantizedAttributes()) {
+			const aiQuantizedAttributes* q = mScene->mMeshes[i]->mQuantization;
+			unsigned int num = 3 + (q->mNormals ? 2 : 0) + (q->mTangents ? 4 : 0);
+			for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS;++a) {
+				num += q->mTextureCoords[a] ? q->mNumUVComponents[a] : 0;
+			}
+			in.meshes += sizeof(aiQuantizedAttributes) + sizeof(short) * num * q->mNumVertices;
+		}
+		if (mScene->mMeshes[i]->HasMeshlets()) {
+			const aiMeshletTable* t = mScene->mMeshes[i]->mMeshlets;
+			in.meshes += sizeof(aiMeshletTable) + sizeof(aiMeshlet) * t->mNumMeshlets +
+				sizeof(unsigned int) * t->mNumVertices + 3 * t->mNumTriangles;
+		}
 		if (mScene->mMeshes[i]->HasBones()) {
 			in.meshes += sizeof(void*) * mScene->mMeshes[i]->mNumBones;
 			for (unsigned int p = 0; p < mScene->mMeshes[i]->mNumBones;++p) {
@@ -534,6 +534,35 @@ uint32_t Assimp :: ComputeMaterialHash(const aiMaterial* mat, bool includeMatNam
 	return hash;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool Assimp :: CompareMaterials(const aiMaterial* first, const aiMaterial* second, bool includeMatName /*= false*/)
+{
+	// walk both property lists in parallel, skipping the same properties 
+	// ComputeMaterialHash() skips
+	unsigned int i = 0, n = 0;
+	for (;;) {
+		while (i < first->mNumProperties && !(first->mProperties[i] && 
+			(includeMatName || first->mProperties[i]->mKey.data[0] != '?'))) {
+			++i;
+		}
+		while (n < second->mNumProperties && !(second->mProperties[n] && 
+			(includeMatName || second->mProperties[n]->mKey.data[0] != '?'))) {
+			++n;
+		}
+		if (i == first->mNumProperties || n == second->mNumProperties) {
+			return i == first->mNumProperties && n == second->mNumProperties;
+		}
+
+		const aiMaterialProperty* a = first->mProperties[i++];
+		const aiMaterialProperty* b = second->mProperties[n++];
+		if (a->mKey != b->mKey || a->mSemantic != b->mSemantic || a->mIndex != b->mIndex || 
+			a->mType != b->mType || a->mDataLength != b->mDataLength ||
+			0 != ::memcmp(a->mData,b->mData,a->mDataLength)) {
+			return false;
+		}
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 void aiMaterial::CopyPropertyList(aiMaterial* pcDest, 
 	const aiMaterial* pcSrc
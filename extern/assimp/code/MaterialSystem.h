@@ -60,6 +60,16 @@ namespace Assimp	{
  */
 uint32_t ComputeMaterialHash(const aiMaterial* mat, bool includeMatName = false);
 
+// ------------------------------------------------------------------------------
+/** Compares all material properties of two materials. Use this to verify
+ *  that two materials with the same #ComputeMaterialHash are really equal.
+ *
+ *  @param  includeMatName Set to 'true' to take all properties with
+ *    '?' as initial character in their name into account. 
+ *  @return true if both materials have the same properties in the same order
+ */
+bool CompareMaterials(const aiMaterial* first, const aiMaterial* second, bool includeMatName = false);
+
 
 } // ! namespace Assimp
 
@@ -56,14 +56,14 @@ void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 	// invoke the exporter 
 	ObjExporter exporter(pFile, pScene);
 
-	// we're still here - export successfully completed. Write both the main OBJ file and the material script
+	// write both the main OBJ file and the material script, the output is streamed to the files directly
 	{
 		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-		outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+		exporter.WriteGeometryFile(outfile.get());
 	}
 	{
 		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
-		outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+		exporter.WriteMaterialFile(outfile.get());
 	}
 }
 
@@ -76,13 +76,9 @@ ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-	mOutputMat.imbue(l);
-
-	WriteGeometryFile();
-	WriteMaterialFile();
+	// collect mesh instances, the actual output is written on demand
+	aiMatrix4x4 mBase;
+	AddNode(pScene->mRootNode,mBase);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -105,7 +101,7 @@ std::string ObjExporter :: GetMaterialLibFileName()
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteHeader(std::ostringstream& out)
+void ObjExporter :: WriteHeader(StreamWriterLE& out)
 {
 	out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
 	out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' << aiGetVersionRevision() << ")" << endl  << endl;
@@ -126,124 +122,181 @@ std::string ObjExporter :: GetMaterialName(unsigned int index)
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteMaterialFile()
+void ObjExporter :: WriteMaterialFile(IOStream* outfile)
 {
-	WriteHeader(mOutputMat);
+	StreamWriterLE out(outfile);
+	WriteHeader(out);
 
 	for(unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
 		const aiMaterial* const mat = pScene->mMaterials[i];
 
 		int illum = 1;
-		mOutputMat << "newmtl " << GetMaterialName(i)  << endl;
+		out << "newmtl " << GetMaterialName(i)  << endl;
 
 		aiColor4D c;
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_DIFFUSE,c)) {
-			mOutputMat << "kd " << c.r << " " << c.g << " " << c.b << endl;
+			out << "kd " << c.r << " " << c.g << " " << c.b << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_AMBIENT,c)) {
-			mOutputMat << "ka " << c.r << " " << c.g << " " << c.b << endl;
+			out << "ka " << c.r << " " << c.g << " " << c.b << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_COLOR_SPECULAR,c)) {
-			mOutputMat << "ks " << c.r << " " << c.g << " " << c.b << endl;
+			out << "ks " << c.r << " " << c.g << " " << c.b << endl;
 		}
 
 		float o;
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_OPACITY,o)) {
-			mOutputMat << "d " << o << endl;
+			out << "d " << o << endl;
 		}
 
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_SHININESS,o) && o) {
-			mOutputMat << "Ns " << o << endl;
+			out << "Ns " << o << endl;
 			illum = 2;
 		}
 
-		mOutputMat << "illum " << illum << endl;
+		out << "illum " << illum << endl;
 
 		aiString s;
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_DIFFUSE(0),s)) {
-			mOutputMat << "map_kd " << s.data << endl;
+			out << "map_kd " << s.data << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_AMBIENT(0),s)) {
-			mOutputMat << "map_ka " << s.data << endl;
+			out << "map_ka " << s.data << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SPECULAR(0),s)) {
-			mOutputMat << "map_ks " << s.data << endl;
+			out << "map_ks " << s.data << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_SHININESS(0),s)) {
-			mOutputMat << "map_ns " << s.data << endl;
+			out << "map_ns " << s.data << endl;
 		}
 		if(AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_HEIGHT(0),s) || AI_SUCCESS == mat->Get(AI_MATKEY_TEXTURE_NORMALS(0),s)) {
 			// implementations seem to vary here, so write both variants
-			mOutputMat << "bump " << s.data << endl;
-			mOutputMat << "map_bump " << s.data << endl;
+			out << "bump " << s.data << endl;
+			out << "map_bump " << s.data << endl;
 		}
 
-		mOutputMat << endl;
+		out << endl;
 	}
+	out.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteGeometryFile()
+void ObjExporter :: WriteGeometryFile(IOStream* outfile)
 {
-	WriteHeader(mOutput);
-	mOutput << "mtllib "  << GetMaterialLibName() << endl << endl;
+	StreamWriterLE out(outfile);
+	WriteHeader(out);
+	out << "mtllib "  << GetMaterialLibName() << endl << endl;
 
-	// collect mesh geometry
-	aiMatrix4x4 mBase;
-	AddNode(pScene->mRootNode,mBase);
+	// Vertex components are written once per mesh vertex, faces reference
+	// them through the running offsets of each mesh instance.
+	unsigned int numvp = 0, numvt = 0, numvn = 0;
+	BOOST_FOREACH(const MeshInstance& m, meshes) {
+		numvp += m.mesh->mNumVertices;
+		if (m.mesh->mTextureCoords[0]) {
+			numvt += m.mesh->mNumVertices;
+		}
+		if (m.mesh->mNormals) {
+			numvn += m.mesh->mNumVertices;
+		}
+	}
 
 	// write vertex positions
-	mOutput << "# " << vp.size() << " vertex positions" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vp) {
-		mOutput << "v  " << v.x << " " << v.y << " " << v.z << endl;
+	out << "# " << numvp << " vertex positions" << endl;
+	BOOST_FOREACH(const MeshInstance& m, meshes) {
+		ai_assert(m.mesh->mVertices);
+		for(unsigned int i = 0; i < m.mesh->mNumVertices; ++i) {
+			const aiVector3D v = m.mat * m.mesh->mVertices[i];
+			out << "v  " << v.x << " " << v.y << " " << v.z << endl;
+		}
 	}
-	mOutput << endl;
+	out << endl;
 
 	// write uv coordinates
-	mOutput << "# " << vt.size() << " UV coordinates" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vt) {
-		mOutput << "vt " << v.x << " " << v.y << " " << v.z << endl;
+	out << "# " << numvt << " UV coordinates" << endl;
+	BOOST_FOREACH(const MeshInstance& m, meshes) {
+		const aiVector3D* const uv = m.mesh->mTextureCoords[0];
+		if (!uv) {
+			continue;
+		}
+		for(unsigned int i = 0; i < m.mesh->mNumVertices; ++i) {
+			const aiVector3D& v = uv[i];
+			out << "vt " << v.x << " " << v.y << " " << v.z << endl;
+		}
 	}
-	mOutput << endl;
+	out << endl;
 
 	// write vertex normals
-	mOutput << "# " << vn.size() << " vertex normals" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vn) {
-		mOutput << "vn " << v.x << " " << v.y << " " << v.z << endl;
+	out << "# " << numvn << " vertex normals" << endl;
+	BOOST_FOREACH(const MeshInstance& m, meshes) {
+		if (!m.mesh->mNormals) {
+			continue;
+		}
+		for(unsigned int i = 0; i < m.mesh->mNumVertices; ++i) {
+			const aiVector3D& v = m.mesh->mNormals[i];
+			out << "vn " << v.x << " " << v.y << " " << v.z << endl;
+		}
 	}
-	mOutput << endl;
+	out << endl;
 
-	// now write all mesh instances
+	// now write all mesh instances. Indices are one-based, 0 means: 'does not exist'
+	unsigned int vp = 1, vt = 1, vn = 1;
 	BOOST_FOREACH(const MeshInstance& m, meshes) {
-		mOutput << "# Mesh \'" << m.name << "\' with " << m.faces.size() << " faces" << endl;
-		mOutput << "g " << m.name << endl;
-		mOutput << "usemtl " << m.matname << endl;
-
-		BOOST_FOREACH(const Face& f, m.faces) {
-			mOutput << f.kind << ' ';
-			BOOST_FOREACH(const FaceVertex& fv, f.indices) {
-				mOutput << ' ' << fv.vp;
-
-				if (f.kind != 'p') {
-					if (fv.vt || f.kind == 'f') {
-						mOutput << '/';
+		const aiMesh* const mesh = m.mesh;
+		const bool hasvt = mesh->mTextureCoords[0] != NULL, hasvn = mesh->mNormals != NULL;
+
+		out << "# Mesh \'" << m.name << "\' with " << mesh->mNumFaces << " faces" << endl;
+		out << "g " << m.name << endl;
+		out << "usemtl " << m.matname << endl;
+
+		for(unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+			const aiFace& f = mesh->mFaces[i];
+
+			char kind;
+			switch (f.mNumIndices) {
+				case 1: 
+					kind = 'p';
+					break;
+				case 2: 
+					kind = 'l';
+					break;
+				default: 
+					kind = 'f';
+			}
+
+			out << kind << ' ';
+			for(unsigned int a = 0; a < f.mNumIndices; ++a) {
+				const unsigned int idx = f.mIndices[a];
+				out << ' ' << (vp + idx);
+
+				if (kind != 'p') {
+					if (hasvt || kind == 'f') {
+						out << '/';
 					}
-					if (fv.vt) {
-						mOutput << fv.vt;
+					if (hasvt) {
+						out << (vt + idx);
 					}
-					if (f.kind == 'f') {
-						mOutput << '/';
-						if (fv.vn) {
-							mOutput << fv.vn;
+					if (kind == 'f') {
+						out << '/';
+						if (hasvn) {
+							out << (vn + idx);
 						}
 					}
 				}
 			}
 
-			mOutput << endl;
+			out << endl;
+		}
+		out << endl;
+
+		vp += mesh->mNumVertices;
+		if (hasvt) {
+			vt += mesh->mNumVertices;
+		}
+		if (hasvn) {
+			vn += mesh->mNumVertices;
 		}
-		mOutput << endl;
 	}
+	out.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -254,44 +307,8 @@ void ObjExporter :: AddMesh(const aiString& name, const aiMesh* m, const aiMatri
 
 	mesh.name = std::string(name.data,name.length) + (m->mName.length ? "_"+std::string(m->mName.data,m->mName.length) : "");
 	mesh.matname = GetMaterialName(m->mMaterialIndex);
-
-	mesh.faces.resize(m->mNumFaces);
-	for(unsigned int i = 0; i < m->mNumFaces; ++i) {
-		const aiFace& f = m->mFaces[i];
-
-		Face& face = mesh.faces[i];
-		switch (f.mNumIndices) {
-			case 1: 
-				face.kind = 'p';
-				break;
-			case 2: 
-				face.kind = 'l';
-				break;
-			default: 
-				face.kind = 'f';
-		}
-		face.indices.resize(f.mNumIndices);
-
-		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-			const unsigned int idx = f.mIndices[a];
-
-			// XXX need a way to check if this is an unique vertex or if we had it already, 
-			// in which case we should instead reference the previous occurrence.
-			ai_assert(m->mVertices);
-			vp.push_back( mat * m->mVertices[idx] );
-			face.indices[a].vp = vp.size();
-
-			if (m->mNormals) {
-				vn.push_back( m->mNormals[idx] );
-			}
-			face.indices[a].vn = vn.size();
-
-			if (m->mTextureCoords[0]) {
-				vt.push_back( m->mTextureCoords[0][idx] );
-			}
-			face.indices[a].vt = vt.size();
-		}
-	}
+	mesh.mesh = m;
+	mesh.mat = mat;
 }
 
 // ------------------------------------------------------------------------------------------------
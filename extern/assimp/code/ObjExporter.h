@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_OBJEXPORTER_H_INC
 #define AI_OBJEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -53,7 +53,8 @@ namespace Assimp
 {
 
 // ------------------------------------------------------------------------------------------------
-/** Helper class to export a given scene to an OBJ file. */
+/** Helper class to export a given scene to an OBJ file. The output is streamed to the
+ *  target files, no copy of the whole file is kept in memory. */
 // ------------------------------------------------------------------------------------------------
 class ObjExporter
 {
@@ -65,41 +66,25 @@ public:
 
 	std::string GetMaterialLibName();
 	std::string GetMaterialLibFileName();
-	
-public:
 
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput, mOutputMat;
+	/// Write the OBJ geometry to a stream
+	void WriteGeometryFile(IOStream* outfile);
 
+	/// Write the MTL material library to a stream
+	void WriteMaterialFile(IOStream* outfile);
+	
 private:
 
-	// intermediate data structures
-	struct FaceVertex 
-	{
-		FaceVertex()
-			: vp(),vn(),vt() 
-		{
-		}
-
-		// one-based, 0 means: 'does not exist'
-		unsigned int vp,vn,vt;
-	};
-
-	struct Face {
-		char kind;
-		std::vector<FaceVertex> indices;
-	};
-
+	// A mesh referenced by a node, along with the transformation
+	// to be applied to its vertices.
 	struct MeshInstance {
 
 		std::string name, matname;
-		std::vector<Face> faces;
+		const aiMesh* mesh;
+		aiMatrix4x4 mat;
 	};
 
-	void WriteHeader(std::ostringstream& out);
-
-	void WriteMaterialFile();
-	void WriteGeometryFile();
+	void WriteHeader(StreamWriterLE& out);
 
 	std::string GetMaterialName(unsigned int index);
 
@@ -111,7 +96,6 @@ private:
 	const std::string filename;
 	const aiScene* const pScene;
 
-	std::vector<aiVector3D> vp, vn, vt;
 	std::vector<MeshInstance> meshes;
 
 	// this endl() doesn't flush() the stream
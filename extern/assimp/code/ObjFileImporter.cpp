@@ -109,6 +109,12 @@ const aiImporterDesc* ObjFileImporter::GetInfo () const
 	return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+void ObjFileImporter::SetupProperties(const Importer* pImp)
+{
+	m_filter.SetupProperties(pImp);
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Obj-file import implementation
 void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler)
@@ -142,10 +148,13 @@ void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 	}
 	
 	// parse the file into a temporary representation
-	ObjFileParser parser(m_Buffer, strModelName, pIOHandler);
+	ObjFileParser parser(m_Buffer, strModelName, pIOHandler, m_filter);
 
 	// And create the proper return structures out of it
 	CreateDataFromImport(parser.GetModel(), pScene);
+	if (m_filter.IsStructureOnly()) {
+		pScene->mFlags |= AI_SCENE_FLAGS_STRUCTURE_ONLY;
+	}
 
 	// Clean up allocated storage for the next import 
 	m_Buffer.clear();
@@ -175,6 +184,10 @@ void ObjFileImporter::CreateDataFromImport(const ObjFile::Model* pModel, aiScene
 	std::vector<aiMesh*> MeshArray;
 	for (size_t index = 0; index < pModel->m_Objects.size(); index++)
 	{
+		// no faces have been read for objects which are not selected
+		if ( !m_filter.IsNodeSelected( pModel->m_Objects[ index ]->m_strObjName ) )
+			continue;
+
 		createNodes(pModel, pModel->m_Objects[ index ], index, pScene->mRootNode, pScene, MeshArray);
 	}
 
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBJ_FILE_IMPORTER_H_INC
 
 #include "BaseImporter.h"
+#include "ImportFilter.h"
 #include <vector>
 
 struct aiMesh;
@@ -75,6 +76,10 @@ public:
 	/// \remark	See BaseImporter::CanRead() for details.
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+	/// \brief	Reads the selection of objects to be imported.
+	/// \remark	See BaseImporter::SetupProperties() for details.
+	void SetupProperties(const Importer* pImp);
+
 private:
 
 	//! \brief	Appends the supported extention.
@@ -117,6 +122,8 @@ private:
 	ObjFile::Object *m_pRootObject;
 	//!	Absolute pathname of model in filesystem
 	std::string m_strAbsPath;
+	//!	Objects and groups to be imported
+	ImportFilter m_filter;
 };
 
 // ------------------------------------------------------------------------------------------------
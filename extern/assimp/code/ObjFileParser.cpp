@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "../include/assimp/types.h"
 #include "DefaultIOSystem.h"
+#include "ImportFilter.h"
 
 namespace Assimp	
 {
@@ -58,12 +59,13 @@ const std::string ObjFileParser::DEFAULT_MATERIAL = AI_DEFAULT_MATERIAL_NAME;
 
 // -------------------------------------------------------------------
 //	Constructor with loaded data and directories.
-ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io ) :
+ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io, const ImportFilter& filter ) :
 	m_DataIt(Data.begin()),
 	m_DataItEnd(Data.end()),
 	m_pModel(NULL),
 	m_uiLine(0),
-	m_pIO( io )
+	m_pIO( io ),
+	m_filter( filter )
 {
 	std::fill_n(m_buffer,BUFFERSIZE,0);
 
@@ -111,6 +113,13 @@ void ObjFileParser::parseFile()
 		{
 		case 'v': // Parse a vertex texture coordinate
 			{
+				// Vertex data is not needed to query the structure of the file
+				if (m_filter.IsStructureOnly())
+				{
+					m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+					break;
+				}
+
 				++m_DataIt;
 				if (*m_DataIt == ' ')
 				{
@@ -259,6 +268,13 @@ void ObjFileParser::getVector2( std::vector<aiVector2D> &point2d_array )
 //	Get values for a new face instance
 void ObjFileParser::getFace(aiPrimitiveType type)
 {
+	// Don't even tokenize faces which are not going to be imported
+	if ( isFaceSkipped() )
+	{
+		m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+		return;
+	}
+
 	copyNextLine(m_buffer, BUFFERSIZE);
 	if (m_DataIt == m_DataItEnd)
 		return;
@@ -373,6 +389,20 @@ void ObjFileParser::getFace(aiPrimitiveType type)
 	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
+// -------------------------------------------------------------------
+//	Returns true, if the faces of the current object are filtered out.
+bool ObjFileParser::isFaceSkipped() const
+{
+	if ( m_filter.IsStructureOnly() )
+		return true;
+
+	if ( !m_filter.HasNodeFilter() )
+		return false;
+
+	// Faces outside of any object go to the default object, see getFace()
+	return !m_filter.IsNodeSelected( NULL != m_pModel->m_pCurrent ? m_pModel->m_pCurrent->m_strObjName : "defaultobject" );
+}
+
 // -------------------------------------------------------------------
 //	Get values for a new material description
 void ObjFileParser::getMaterialDesc()
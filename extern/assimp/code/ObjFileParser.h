@@ -59,6 +59,7 @@ struct Point2;
 }
 class ObjFileImporter;
 class IOSystem;
+class ImportFilter;
 
 ///	\class	ObjFileParser
 ///	\brief	Parser for a obj waveform file
@@ -72,7 +73,7 @@ public:
 
 public:
 	///	\brief	Constructor with data array.
-	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io);
+	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io, const ImportFilter& filter);
 	///	\brief	Destructor
 	~ObjFileParser();
 	///	\brief	Model getter.
@@ -114,6 +115,8 @@ private:
 	bool needsNewMesh( const std::string &rMaterialName );
 	///	Error report in token
 	void reportErrorTokenInFace();
+	///	Returns true, if faces of the current object are not to be imported.
+	bool isFaceSkipped() const;
 
 private:
 	///	Default material name
@@ -130,6 +133,8 @@ private:
 	char m_buffer[BUFFERSIZE];
 	///	Pointer to IO system instance.
 	IOSystem *m_pIO;
+	///	Selection of objects and groups to be imported
+	const ImportFilter& m_filter;
 };
 
 }	// Namespace Assimp
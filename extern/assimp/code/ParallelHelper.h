@@ -0,0 +1,145 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ParallelHelper.h
+ *  @brief Utilities for post processing steps which process meshes in parallel.
+ *
+ *  Parallel loops are expressed with OpenMP. If Assimp is built without OpenMP
+ *  support the pragmas are ignored and all loops run serially, so every step
+ *  must also work correctly with just one thread.
+ */
+#ifndef AI_PARALLEL_HELPER_H_INCLUDED
+#define AI_PARALLEL_HELPER_H_INCLUDED
+
+#ifdef _OPENMP
+#	include <omp.h>
+#endif
+
+#include <ctime>
+
+namespace Assimp {
+
+// -------------------------------------------------------------------------------
+/** Determine the number of threads to be used by a parallel region, as requested
+ *  by the #AI_CONFIG_GLOB_MULTITHREADING property. 
+ *  @param pImp Importer to read the property from, may be NULL
+ *  @return Number of threads, always at least 1. */
+inline int GetNumThreads(const Importer* pImp)
+{
+	const int policy = pImp ? pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,-1) : -1;
+#ifdef _OPENMP
+	if (policy < 0) {
+		return omp_get_max_threads();
+	}
+	return policy ? policy : 1;
+#else
+	(void)policy;
+	return 1;
+#endif
+}
+
+// -------------------------------------------------------------------------------
+/** Get a wall-clock time stamp, in seconds. In contrast to boost::timer, this
+ *  does not sum up the CPU time of all threads. */
+inline double GetWallClockTime()
+{
+#ifdef _OPENMP
+	return omp_get_wtime();
+#else
+	return static_cast<double>(::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// -------------------------------------------------------------------------------
+/** Collects the error raised by the iterations of a parallel loop. Exceptions
+ *  must not leave an OpenMP region, so each iteration catches them and stores
+ *  them here. After the loop, Rethrow() raises the error of the iteration
+ *  with the lowest index on the calling thread, which is the same error the
+ *  serial loop would have reported.
+ *
+ *  Failed() may be polled by other iterations to skip their work early. */
+class ParallelErrorCollector
+{
+public:
+
+	ParallelErrorCollector()
+		: failed(false)
+		, index(~0u)
+	{}
+
+public:
+
+	/** Check whether any iteration failed so far */
+	bool Failed() const {
+		return failed;
+	}
+
+	/** Record an error raised by iteration i */
+	void Set(unsigned int i, const std::string& message) {
+#ifdef _OPENMP
+#		pragma omp critical(ai_parallel_error_collector)
+#endif
+		{
+			if (i < index) {
+				index = i;
+				this->message = message;
+			}
+			failed = true;
+		}
+	}
+
+	/** Raise the recorded error, if any, as DeadlyImportError */
+	void Rethrow() const {
+		if (failed) {
+			throw DeadlyImportError(message);
+		}
+	}
+
+private:
+
+	volatile bool failed;
+	unsigned int index;
+	std::string message;
+};
+
+} // ! namespace Assimp
+
+#endif // !! AI_PARALLEL_HELPER_H_INCLUDED
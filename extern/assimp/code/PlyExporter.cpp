@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if !defined(ASSIMP_BUILD_NO_EXPORT) && !defined(ASSIMP_BUILD_NO_PLY_EXPORTER)
 
 #include "PlyExporter.h"
+#include "Quantization.h"
 #include "../include/assimp/version.h"
 
 using namespace Assimp;
@@ -55,9 +56,33 @@ void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 	// invoke the exporter 
 	PlyExporter exporter(pFile, pScene);
 
-	// we're still here - export successfully completed. Write the file.
+	// the output is streamed to the file directly
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	exporter.WriteFile(outfile.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to binary PLY. Prototyped and registered in Exporter.cpp
+void ExportScenePlyBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
+{
+	// invoke the exporter 
+	PlyExporter exporter(pFile, pScene, true);
+
+	// the output is streamed to the file directly
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
+	exporter.WriteFile(outfile.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to quantized binary PLY. Prototyped and registered in Exporter.cpp
+void ExportScenePlyQuantized(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
+{
+	// invoke the exporter 
+	PlyExporter exporter(pFile, pScene, true, true);
+
+	// the output is streamed to the file directly
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
+	exporter.WriteFile(outfile.get());
 }
 
 } // end of namespace Assimp
@@ -68,20 +93,35 @@ void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
+PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene, bool binary, bool quantized)
 : filename(_filename)
 , pScene(pScene)
+, binary(binary || quantized)
+, quantized(quantized)
+, maxFaceIndices()
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+		const aiMesh& m = *pScene->mMeshes[i];
+		for (unsigned int f = 0; f < m.mNumFaces; ++f) {
+			maxFaceIndices = std::max(maxFaceIndices,m.mFaces[f].mNumIndices);
+		}
 
-	unsigned int faces = 0u, vertices = 0u, components = 0u;
+		// the quantized data is taken from the aiProcess_QuantizeAttributes step
+		if (quantized && !(m.HasQuantizedAttributes() && m.mQuantization->mNumVertices == m.mNumVertices)) {
+			throw DeadlyExportError("PLY: quantized export requires aiMesh::mQuantization on all meshes");
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteFile(IOStream* outfile)
+{
+	StreamWriterLE out(outfile);
+
+	unsigned int components = 0u;
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		const aiMesh& m = *pScene->mMeshes[i];
-		faces += m.mNumFaces;
-		vertices += m.mNumVertices;
 
 		if (m.HasNormals()) {
 			components |= PLY_EXPORT_HAS_NORMALS;
@@ -97,21 +137,95 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 		}
 	}
 
-	mOutput << "ply" << endl;
-	mOutput << "format ascii 1.0" << endl;
-	mOutput << "Created by Open Asset Import Library - http://assimp.sf.net (v"
+	WriteHeader(out,components);
+
+	if (quantized) {
+		WriteQuantization(out);
+	}
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+		if (quantized) {
+			WriteMeshVertsQuantized(out,pScene->mMeshes[i],components);
+		}
+		else if (binary) {
+			WriteMeshVertsBinary(out,pScene->mMeshes[i],components);
+		}
+		else {
+			WriteMeshVerts(out,pScene->mMeshes[i],components);
+		}
+	}
+	for (unsigned int i = 0, ofs = 0; i < pScene->mNumMeshes; ++i) {
+		if (binary) {
+			WriteMeshIndicesBinary(out,pScene->mMeshes[i],ofs);
+		}
+		else {
+			WriteMeshIndices(out,pScene->mMeshes[i],ofs);
+		}
+		ofs += pScene->mMeshes[i]->mNumVertices;
+	}
+	out.Flush();
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteHeader(StreamWriterLE& out, unsigned int components)
+{
+	unsigned int faces = 0u, vertices = 0u;
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+		faces += pScene->mMeshes[i]->mNumFaces;
+		vertices += pScene->mMeshes[i]->mNumVertices;
+	}
+
+	out << "ply" << endl;
+	out << (binary ? "format binary_little_endian 1.0" : "format ascii 1.0") << endl;
+	out << "comment Created by Open Asset Import Library - http://assimp.sf.net (v"
 		<< aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' 
 		<< aiGetVersionRevision() << ")" << endl;
 
-	mOutput << "element vertex " << vertices << endl;
-	mOutput << "property float x" << endl;
-	mOutput << "property float y" << endl;
-	mOutput << "property float z" << endl;
+	if (quantized) {
+		// Ply has no notion of quantization. The lattice of the positions of each
+		// mesh is stored in an extra element, so the vertex properties have names
+		// of their own: readers which don't know about the encoding find no
+		// positions rather than garbage.
+		float maxError = 0.f;
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			maxError = std::max(maxError,pScene->mMeshes[i]->mQuantization->mMaxPositionError);
+		}
+		out << "comment qx qy qz: unsigned 16 bit positions, offset + value * scale of their mesh" << endl;
+		out << "comment position_max_error " << maxError << endl;
+		out << "comment nu nv tu tv bu bv: octahedral unit vectors, value / 32767" << endl;
+		out << "comment hs ht: half precision texture coordinates" << endl;
+
+		out << "element quantization " << pScene->mNumMeshes << endl;
+		out << "property uint first_vertex" << endl;
+		out << "property float offset_x" << endl;
+		out << "property float offset_y" << endl;
+		out << "property float offset_z" << endl;
+		out << "property float scale_x" << endl;
+		out << "property float scale_y" << endl;
+		out << "property float scale_z" << endl;
+	}
+
+	out << "element vertex " << vertices << endl;
+	if (quantized) {
+		out << "property ushort qx" << endl;
+		out << "property ushort qy" << endl;
+		out << "property ushort qz" << endl;
+	}
+	else {
+		out << "property float x" << endl;
+		out << "property float y" << endl;
+		out << "property float z" << endl;
+	}
 
 	if(components & PLY_EXPORT_HAS_NORMALS) {
-		mOutput << "property float nx" << endl;
-		mOutput << "property float ny" << endl;
-		mOutput << "property float nz" << endl;
+		if (quantized) {
+			out << "property short nu" << endl;
+			out << "property short nv" << endl;
+		}
+		else {
+			out << "property float nx" << endl;
+			out << "property float ny" << endl;
+			out << "property float nz" << endl;
+		}
 	}
 
 	// write texcoords first, just in case an importer does not support tangents
@@ -119,102 +233,111 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 	// unknown fields (Ply leaves pretty much every vertex component open,
 	// but in reality most importers only know about vertex positions, normals
 	// and texture coordinates).
+	const char* const uvType = quantized ? "property ushort h" : "property float ";
 	for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
 		if (!c) {
-			mOutput << "property float s" << endl;
-			mOutput << "property float t" << endl;
+			out << uvType << "s" << endl;
+			out << uvType << "t" << endl;
 		}
 		else {
-			mOutput << "property float s" << c << endl;
-			mOutput << "property float t" << c << endl;
+			out << uvType << "s" << c << endl;
+			out << uvType << "t" << c << endl;
 		}
 	}
 
+	// quantized colors use the common 8 bit layout
+	const char* const colorType = quantized ? "property uchar " : "property float ";
 	for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
 		if (!c) {
-			mOutput << "property float r" << endl;
-			mOutput << "property float g" << endl;
-			mOutput << "property float b" << endl;
-			mOutput << "property float a" << endl;
+			out << colorType << "r" << endl;
+			out << colorType << "g" << endl;
+			out << colorType << "b" << endl;
+			out << colorType << "a" << endl;
 		}
 		else {
-			mOutput << "property float r" << c << endl;
-			mOutput << "property float g" << c << endl;
-			mOutput << "property float b" << c << endl;
-			mOutput << "property float a" << c << endl;
+			out << colorType << "r" << c << endl;
+			out << colorType << "g" << c << endl;
+			out << colorType << "b" << c << endl;
+			out << colorType << "a" << c << endl;
 		}
 	}
 
 	if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
-		mOutput << "property float tx" << endl;
-		mOutput << "property float ty" << endl;
-		mOutput << "property float tz" << endl;
-		mOutput << "property float bx" << endl;
-		mOutput << "property float by" << endl;
-		mOutput << "property float bz" << endl;
+		if (quantized) {
+			out << "property short tu" << endl;
+			out << "property short tv" << endl;
+			out << "property short bu" << endl;
+			out << "property short bv" << endl;
+		}
+		else {
+			out << "property float tx" << endl;
+			out << "property float ty" << endl;
+			out << "property float tz" << endl;
+			out << "property float bx" << endl;
+			out << "property float by" << endl;
+			out << "property float bz" << endl;
+		}
 	}
 
-	mOutput << "element face " << faces << endl;
-	mOutput << "property list uint uint vertex_indices" << endl;
-	mOutput << "end_header" << endl;
-
-	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-		WriteMeshVerts(pScene->mMeshes[i],components);
+	out << "element face " << faces << endl;
+	if (binary) {
+		// the common layout is uchar count + int indices, but polygons may be larger
+		out << (maxFaceIndices > 0xff ? "property list uint int vertex_indices" : "property list uchar int vertex_indices") << endl;
 	}
-	for (unsigned int i = 0, ofs = 0; i < pScene->mNumMeshes; ++i) {
-		WriteMeshIndices(pScene->mMeshes[i],ofs);
-		ofs += pScene->mMeshes[i]->mNumVertices;
+	else {
+		out << "property list uint uint vertex_indices" << endl;
 	}
+	out << "end_header" << endl;
 }
 
 // ------------------------------------------------------------------------------------------------
-void PlyExporter :: WriteMeshVerts(const aiMesh* m, unsigned int components)
+void PlyExporter :: WriteMeshVerts(StreamWriterLE& out, const aiMesh* m, unsigned int components)
 {
 	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-		mOutput << 
+		out << 
 			m->mVertices[i].x << " " << 
 			m->mVertices[i].y << " " << 
 			m->mVertices[i].z
 		;
 		if(components & PLY_EXPORT_HAS_NORMALS) {
 			if (m->HasNormals()) {
-				mOutput << 
+				out << 
 				" " << m->mNormals[i].x << 
 				" " << m->mNormals[i].y << 
 				" " << m->mNormals[i].z;
 			}
 			else {
-				mOutput << " 0.0 0.0 0.0"; 
+				out << " 0.0 0.0 0.0"; 
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
 			if (m->HasTextureCoords(c)) {
-				mOutput << 
+				out << 
 					" " << m->mTextureCoords[c][i].x << 
 					" " << m->mTextureCoords[c][i].y;
 			}
 			else {
-				mOutput << " -1.0 -1.0"; 
+				out << " -1.0 -1.0"; 
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
 			if (m->HasVertexColors(c)) {
-				mOutput << 
+				out << 
 					" " << m->mColors[c][i].r << 
 					" " << m->mColors[c][i].g <<
 					" " << m->mColors[c][i].b <<
 					" " << m->mColors[c][i].a;
 			}
 			else {
-				mOutput << " -1.0 -1.0 -1.0 -1.0"; 
+				out << " -1.0 -1.0 -1.0 -1.0"; 
 			}
 		}
 
 		if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
 			if (m->HasTangentsAndBitangents()) {
-				mOutput << 
+				out << 
 				" " << m->mTangents[i].x << 
 				" " << m->mTangents[i].y << 
 				" " << m->mTangents[i].z << 
@@ -224,22 +347,138 @@ void PlyExporter :: WriteMeshVerts(const aiMesh* m, unsigned int components)
 				;
 			}
 			else {
-				mOutput << " 0.0 0.0 0.0 0.0 0.0 0.0"; 
+				out << " 0.0 0.0 0.0 0.0 0.0 0.0"; 
 			}
 		}
 
-		mOutput << endl;
+		out << endl;
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-void PlyExporter :: WriteMeshIndices(const aiMesh* m, unsigned int offset)
+void PlyExporter :: WriteMeshIndices(StreamWriterLE& out, const aiMesh* m, unsigned int offset)
 {
 	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
 		const aiFace& f = m->mFaces[i];
-		mOutput << f.mNumIndices << " ";
+		out << f.mNumIndices << " ";
+		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
+			out << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl : " ");
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteMeshVertsBinary(StreamWriterLE& out, const aiMesh* m, unsigned int components)
+{
+	// same layout and placeholder values as in WriteMeshVerts()
+	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
+		out.PutF4(m->mVertices[i].x);
+		out.PutF4(m->mVertices[i].y);
+		out.PutF4(m->mVertices[i].z);
+
+		if(components & PLY_EXPORT_HAS_NORMALS) {
+			const aiVector3D n = m->HasNormals() ? m->mNormals[i] : aiVector3D();
+			out.PutF4(n.x);
+			out.PutF4(n.y);
+			out.PutF4(n.z);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
+			const aiVector3D uv = m->HasTextureCoords(c) ? m->mTextureCoords[c][i] : aiVector3D(-1.f,-1.f,-1.f);
+			out.PutF4(uv.x);
+			out.PutF4(uv.y);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
+			const aiColor4D col = m->HasVertexColors(c) ? m->mColors[c][i] : aiColor4D(-1.f,-1.f,-1.f,-1.f);
+			out.PutF4(col.r);
+			out.PutF4(col.g);
+			out.PutF4(col.b);
+			out.PutF4(col.a);
+		}
+
+		if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
+			const bool has = m->HasTangentsAndBitangents();
+			const aiVector3D t = has ? m->mTangents[i] : aiVector3D(), b = has ? m->mBitangents[i] : aiVector3D();
+			out.PutF4(t.x);
+			out.PutF4(t.y);
+			out.PutF4(t.z);
+			out.PutF4(b.x);
+			out.PutF4(b.y);
+			out.PutF4(b.z);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteQuantization(StreamWriterLE& out)
+{
+	for (unsigned int i = 0, ofs = 0; i < pScene->mNumMeshes; ++i) {
+		const aiQuantizedAttributes* q = pScene->mMeshes[i]->mQuantization;
+		out.PutU4(ofs);
+		out.PutF4(q->mPositionOffset.x);
+		out.PutF4(q->mPositionOffset.y);
+		out.PutF4(q->mPositionOffset.z);
+		out.PutF4(q->mPositionScale.x);
+		out.PutF4(q->mPositionScale.y);
+		out.PutF4(q->mPositionScale.z);
+		ofs += pScene->mMeshes[i]->mNumVertices;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteMeshVertsQuantized(StreamWriterLE& out, const aiMesh* m, unsigned int components)
+{
+	// same layout as WriteMeshVertsBinary(), but with the encodings of Quantization.h
+	const aiQuantizedAttributes* q = m->mQuantization;
+	const uint16_t noUV = Quantization::FloatToHalf(-1.f);
+	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
+		out.PutU2(q->mPositions[i*3]);
+		out.PutU2(q->mPositions[i*3+1]);
+		out.PutU2(q->mPositions[i*3+2]);
+
+		if(components & PLY_EXPORT_HAS_NORMALS) {
+			out.PutI2(q->mNormals ? q->mNormals[i*2] : 0);
+			out.PutI2(q->mNormals ? q->mNormals[i*2+1] : 0);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
+			const unsigned int comp = q->mNumUVComponents[c];
+			const uint16_t* uv = q->mTextureCoords[c] ? q->mTextureCoords[c] + i*comp : NULL;
+			out.PutU2(uv ? uv[0] : noUV);
+			out.PutU2(uv ? (comp > 1 ? uv[1] : 0) : noUV);
+		}
+
+		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
+			const aiColor4D col = m->HasVertexColors(c) ? m->mColors[c][i] : aiColor4D(0.f,0.f,0.f,0.f);
+			for (unsigned int k = 0; k < 4; ++k) {
+				out.PutU1(static_cast<uint8_t>(std::max(0.f,std::min(1.f,col[k])) * 255.f + 0.5f));
+			}
+		}
+
+		if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
+			out.PutI2(q->mTangents ? q->mTangents[i*2] : 0);
+			out.PutI2(q->mTangents ? q->mTangents[i*2+1] : 0);
+			out.PutI2(q->mBitangents ? q->mBitangents[i*2] : 0);
+			out.PutI2(q->mBitangents ? q->mBitangents[i*2+1] : 0);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter :: WriteMeshIndicesBinary(StreamWriterLE& out, const aiMesh* m, unsigned int offset)
+{
+	const bool wide = maxFaceIndices > 0xff;
+	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+		const aiFace& f = m->mFaces[i];
+		if (wide) {
+			out.PutU4(f.mNumIndices);
+		}
+		else {
+			out.PutU1(static_cast<uint8_t>(f.mNumIndices));
+		}
 		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
-			mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl : " ");
+			out.PutI4(static_cast<int32_t>(f.mIndices[c] + offset));
 		}
 	}
 }
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -53,28 +53,41 @@ namespace Assimp
 {
 
 // ------------------------------------------------------------------------------------------------
-/** Helper class to export a given scene to a Stanford Ply file. */
+/** Helper class to export a given scene to a Stanford Ply file. The output is streamed to
+ *  the target file, either as ASCII or as little-endian binary Ply. Binary files may
+ *  optionally store the quantized vertex attributes of aiMesh::mQuantization. */
 // ------------------------------------------------------------------------------------------------
 class PlyExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	PlyExporter(const char* filename, const aiScene* pScene);
+	PlyExporter(const char* filename, const aiScene* pScene, bool binary = false, bool quantized = false);
 
 public:
 
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	/// Write the whole file to a stream
+	void WriteFile(IOStream* outfile);
 
 private:
 
-	void WriteMeshVerts(const aiMesh* m, unsigned int components);
-	void WriteMeshIndices(const aiMesh* m, unsigned int ofs);
+	void WriteHeader(StreamWriterLE& out, unsigned int components);
+	void WriteMeshVerts(StreamWriterLE& out, const aiMesh* m, unsigned int components);
+	void WriteMeshIndices(StreamWriterLE& out, const aiMesh* m, unsigned int ofs);
+
+	void WriteMeshVertsBinary(StreamWriterLE& out, const aiMesh* m, unsigned int components);
+	void WriteQuantization(StreamWriterLE& out);
+	void WriteMeshVertsQuantized(StreamWriterLE& out, const aiMesh* m, unsigned int components);
+	void WriteMeshIndicesBinary(StreamWriterLE& out, const aiMesh* m, unsigned int ofs);
 
 private:
 
 	const std::string filename;
 	const aiScene* const pScene;
+	const bool binary;
+	const bool quantized;
+
+	// maximum number of indices in a face, determines the type of the face list count
+	unsigned int maxFaceIndices;
 
 	// obviously, this endl() doesn't flush() the stream 
 	const std::string endl;
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "Quantization.h"
 
 using namespace Assimp;
 
@@ -162,17 +163,22 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	}
 	this->pcDOM = &sPlyDom;
 
-	// now load a list of vertices. This must be sucessfull in order to procede
+	// now load a list of vertices. This must be sucessfull in order to procede.
+	// Quantized files also contain the normals and texture coordinates.
 	std::vector<aiVector3D> avPositions;
-	this->LoadVertices(&avPositions,false);
+	std::vector<aiVector3D> avNormals;
+	std::vector<aiVector2D> avTexCoords;
+	const bool bQuantized = LoadQuantizedVertices(&avPositions,&avNormals,&avTexCoords);
+	if (!bQuantized)
+		this->LoadVertices(&avPositions,false);
 
 	if (avPositions.empty())
 		throw DeadlyImportError( "Invalid .ply file: No vertices found. "
 			"Unable to parse the data format of the PLY file.");
 
 	// now load a list of normals. 
-	std::vector<aiVector3D> avNormals;
-	LoadVertices(&avNormals,true);
+	if (!bQuantized)
+		LoadVertices(&avNormals,true);
 
 	// load the face list
 	std::vector<PLY::Face> avFaces;
@@ -209,9 +215,10 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	LoadVertexColor(&avColors);
 
 	// now try to load texture coordinates
-	std::vector<aiVector2D> avTexCoords;
-	avTexCoords.reserve(avPositions.size());
-	LoadTextureCoordinates(&avTexCoords);
+	if (!bQuantized) {
+		avTexCoords.reserve(avPositions.size());
+		LoadTextureCoordinates(&avTexCoords);
+	}
 
 	// now replace the default material in all faces and validate all material indices
 	ReplaceDefaultMaterial(&avFaces,&avMaterials);
@@ -446,6 +453,130 @@ void PLYImporter::LoadTextureCoordinates(std::vector<aiVector2D>* pvOut)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the index of the property with the given name, 0xFFFFFFFF if there is none
+static unsigned int FindPropertyByName(const PLY::Element& element, const char* szName)
+{
+	for (unsigned int a = 0; a < element.alProperties.size(); ++a) {
+		const PLY::Property& prop = element.alProperties[a];
+		if (!prop.bIsList && PLY::EST_INVALID == prop.Semantic && prop.szName == szName) {
+			return a;
+		}
+	}
+	return 0xFFFFFFFF;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Try to extract quantized vertices from the PLY DOM
+bool PLYImporter::LoadQuantizedVertices(std::vector<aiVector3D>* pvPositions,
+	std::vector<aiVector3D>* pvNormals,
+	std::vector<aiVector2D>* pvTexCoords)
+{
+	ai_assert(NULL != pvPositions && NULL != pvNormals && NULL != pvTexCoords);
+
+	// the vertex element and the quantization element, which holds the 
+	// position lattice of each range of vertices
+	const PLY::Element* pcVertex = NULL, *pcQuant = NULL;
+	const PLY::ElementInstanceList* pcVertexList = NULL, *pcQuantList = NULL;
+	for (unsigned int i = 0; i < pcDOM->alElements.size(); ++i) {
+		const PLY::Element& element = pcDOM->alElements[i];
+		if (PLY::EEST_Vertex == element.eSemantic) {
+			pcVertex = &element;
+			pcVertexList = &pcDOM->alElementData[i];
+		}
+		else if (PLY::EEST_INVALID == element.eSemantic && element.szName == "quantization") {
+			pcQuant = &element;
+			pcQuantList = &pcDOM->alElementData[i];
+		}
+	}
+	if (!pcVertex || !pcQuant) {
+		return false;
+	}
+
+	static const char* const szQuantNames[7] = {
+		"first_vertex","offset_x","offset_y","offset_z","scale_x","scale_y","scale_z"
+	};
+	unsigned int aiQuant[7];
+	for (unsigned int a = 0; a < 7; ++a) {
+		if (0xFFFFFFFF == (aiQuant[a] = FindPropertyByName(*pcQuant,szQuantNames[a])))
+			throw DeadlyImportError( "Invalid .ply file: Quantization element lacks " + std::string(szQuantNames[a]));
+	}
+
+	// positions are required, normals and the first texture coordinate set are optional
+	static const char* const szVertexNames[7] = {"qx","qy","qz","nu","nv","hs","ht"};
+	unsigned int aiVertex[7];
+	for (unsigned int a = 0; a < 7; ++a) {
+		aiVertex[a] = FindPropertyByName(*pcVertex,szVertexNames[a]);
+	}
+	if (0xFFFFFFFF == aiVertex[0] || 0xFFFFFFFF == aiVertex[1] || 0xFFFFFFFF == aiVertex[2])
+		throw DeadlyImportError( "Invalid .ply file: Quantized vertices lack positions");
+
+	const bool bNormals = 0xFFFFFFFF != aiVertex[3] && 0xFFFFFFFF != aiVertex[4];
+	const bool bTexCoords = 0xFFFFFFFF != aiVertex[5] && 0xFFFFFFFF != aiVertex[6];
+
+	const std::vector<PLY::ElementInstance>& alRanges = pcQuantList->alInstances;
+	const std::vector<PLY::ElementInstance>& alVertices = pcVertexList->alInstances;
+
+	// the instances of unknown elements are skipped in ASCII files
+	for (unsigned int i = 0; i < alRanges.size(); ++i) {
+		if (alRanges[i].alProperties.size() != pcQuant->alProperties.size())
+			throw DeadlyImportError( "Invalid .ply file: Unable to read the quantization element");
+	}
+
+	pvPositions->reserve(alVertices.size());
+	if (bNormals)
+		pvNormals->reserve(alVertices.size());
+	if (bTexCoords)
+		pvTexCoords->reserve(alVertices.size());
+
+	aiVector3D vOffset, vScale;
+	unsigned int iRange = 0;
+	for (unsigned int i = 0; i < alVertices.size(); ++i) {
+		// the ranges are sorted by their first vertex
+		for (; iRange < alRanges.size(); ++iRange) {
+			const std::vector<PLY::PropertyInstance>& p = alRanges[iRange].alProperties;
+			if (PLY::PropertyInstance::ConvertTo<unsigned int>(p[aiQuant[0]].avList.front(),
+				pcQuant->alProperties[aiQuant[0]].eType) > i) {
+				break;
+			}
+			float af[6];
+			for (unsigned int a = 0; a < 6; ++a) {
+				af[a] = PLY::PropertyInstance::ConvertTo<float>(p[aiQuant[a+1]].avList.front(),
+					pcQuant->alProperties[aiQuant[a+1]].eType);
+			}
+			vOffset = aiVector3D(af[0],af[1],af[2]);
+			vScale = aiVector3D(af[3],af[4],af[5]);
+		}
+
+		const std::vector<PLY::PropertyInstance>& p = alVertices[i].alProperties;
+		uint16_t aiPos[3];
+		for (unsigned int a = 0; a < 3; ++a) {
+			aiPos[a] = PLY::PropertyInstance::ConvertTo<uint16_t>(p[aiVertex[a]].avList.front(),
+				pcVertex->alProperties[aiVertex[a]].eType);
+		}
+		pvPositions->push_back(Quantization::DequantizePosition(aiPos,vOffset,vScale));
+
+		if (bNormals) {
+			int16_t aiOct[2];
+			for (unsigned int a = 0; a < 2; ++a) {
+				aiOct[a] = PLY::PropertyInstance::ConvertTo<int16_t>(p[aiVertex[a+3]].avList.front(),
+					pcVertex->alProperties[aiVertex[a+3]].eType);
+			}
+			pvNormals->push_back(Quantization::DecodeOctahedral(aiOct));
+		}
+
+		if (bTexCoords) {
+			aiVector2D vOut;
+			vOut.x = Quantization::HalfToFloat(PLY::PropertyInstance::ConvertTo<uint16_t>(
+				p[aiVertex[5]].avList.front(),pcVertex->alProperties[aiVertex[5]].eType));
+			vOut.y = Quantization::HalfToFloat(PLY::PropertyInstance::ConvertTo<uint16_t>(
+				p[aiVertex[6]].avList.front(),pcVertex->alProperties[aiVertex[6]].eType));
+			pvTexCoords->push_back(vOut);
+		}
+	}
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Try to extract vertices from the PLY DOM
 void PLYImporter::LoadVertices(std::vector<aiVector3D>* pvOut, bool p_bNormals)
@@ -99,6 +99,14 @@ protected:
 	void LoadVertices(std::vector<aiVector3D>* pvOut,
 		bool p_bNormals = false);
 
+	// -------------------------------------------------------------------
+	/** Extract and decode the quantized vertex attributes written by 
+	 *  the "plyq" exporter. Returns false if the file isn't quantized.
+	*/
+	bool LoadQuantizedVertices(std::vector<aiVector3D>* pvPositions,
+		std::vector<aiVector3D>* pvNormals,
+		std::vector<aiVector2D>* pvTexCoords);
+
 	// -------------------------------------------------------------------
 	/** Extract vertex color channels from the DOM
 	*/
@@ -234,7 +234,7 @@ PLY::ESemantic PLY::Property::ParseSemantic(const char* pCur,const char** pCurOu
 	else
 	{
 		DefaultLogger::get()->info("Found unknown property semantic in file. This is ok");
-		SkipLine(&pCur);
+		SkipToken(pCur);
 	}
 	*pCurOut = pCur;
 	return eOut;
@@ -379,6 +379,7 @@ bool PLY::Element::ParseElement (const char* pCur,
 	{
 		// if the exact semantic can't be determined, just store
 		// the original string identifier
+		SkipToken(pCur);
 		uintptr_t iDiff = (uintptr_t)pCur - (uintptr_t)szCur;
 		pOut->szName = std::string(szCur,iDiff);
 	}
@@ -851,7 +852,7 @@ bool PLY::PropertyInstance::ParseValueBinary(
 
 	case EDT_UShort:
 		{
-		int16_t i = *((uint16_t*)pCur);
+		uint16_t i = *((uint16_t*)pCur);
 
 		// Swap endianess
 		if (p_bBE)ByteSwap::Swap(&i);
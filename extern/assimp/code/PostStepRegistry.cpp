@@ -120,6 +120,15 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_DEBONE_PROCESS
 #	include "DeboneProcess.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+#	include "GenLODsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+#	include "GenMeshletsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_QUANTIZEATTRIBUTES_PROCESS
+#	include "QuantizeAttributesProcess.h"
+#endif
 
 namespace Assimp {
 
@@ -224,6 +233,18 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
 	out.push_back( new ImproveCacheLocalityProcess());
 #endif
+
+#if (!defined ASSIMP_BUILD_NO_GENLODS_PROCESS)
+	out.push_back( new GenLODsProcess());
+#endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+	out.push_back( new GenMeshletsProcess());
+#endif
+
+	// must run last, it takes a snapshot of the final vertex data
+#if (!defined ASSIMP_BUILD_NO_QUANTIZEATTRIBUTES_PROCESS)
+	out.push_back( new QuantizeAttributesProcess());
+#endif
 }
 
 }
@@ -58,6 +58,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 PretransformVertices::PretransformVertices()
 :	configKeepHierarchy (false)
+,	configNormalize (false)
 {
 }
 
@@ -412,4 +412,71 @@ aiMesh* MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
 	return oMesh;
 }
 
+namespace {
+
+	// Orders faces by one coordinate of their centers
+	struct FaceCenterLess
+	{
+		FaceCenterLess(const std::vector<aiVector3D>& centers, unsigned int axis)
+			: centers(centers), axis(axis)
+		{}
+
+		bool operator() (unsigned int a, unsigned int b) const {
+			return centers[a][axis] < centers[b][axis];
+		}
+
+		const std::vector<aiVector3D>& centers;
+		unsigned int axis;
+	};
+
+	// Bisect the faces of chunks [first,last) until each chunk is on its own
+	void BisectFaces(std::vector<unsigned int>& faces, const std::vector<aiVector3D>& centers,
+		unsigned int first, unsigned int last, unsigned int numChunks, unsigned int chunkSize)
+	{
+		if (last - first < 2) {
+			return;
+		}
+
+		const unsigned int begin = first * chunkSize;
+		const unsigned int end = last == numChunks ? static_cast<unsigned int>(faces.size()) : last * chunkSize;
+
+		aiVector3D min(1e10f,1e10f,1e10f), max(-1e10f,-1e10f,-1e10f);
+		for (unsigned int i = begin; i < end; ++i) {
+			const aiVector3D& c = centers[faces[i]];
+			min.x = std::min(min.x,c.x); max.x = std::max(max.x,c.x);
+			min.y = std::min(min.y,c.y); max.y = std::max(max.y,c.y);
+			min.z = std::min(min.z,c.z); max.z = std::max(max.z,c.z);
+		}
+		const aiVector3D size = max - min;
+		const unsigned int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+
+		const unsigned int middle = first + (last - first) / 2;
+		std::nth_element(faces.begin() + begin, faces.begin() + middle * chunkSize, 
+			faces.begin() + end, FaceCenterLess(centers,axis));
+
+		BisectFaces(faces,centers,first,middle,numChunks,chunkSize);
+		BisectFaces(faces,centers,middle,last,numChunks,chunkSize);
+	}
+}
+
+// -------------------------------------------------------------------------------
+void ComputeFaceSpatialOrder(const aiMesh* pMesh, unsigned int numChunks, std::vector<unsigned int>& out)
+{
+	out.resize(pMesh->mNumFaces);
+	std::vector<aiVector3D> centers(pMesh->mNumFaces);
+	for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+		const aiFace& face = pMesh->mFaces[a];
+		for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+			centers[a] += pMesh->mVertices[face.mIndices[i]];
+		}
+		if (face.mNumIndices) {
+			centers[a] /= static_cast<float>(face.mNumIndices);
+		}
+		out[a] = a;
+	}
+
+	numChunks = std::max(1u,std::min(numChunks,pMesh->mNumFaces));
+	BisectFaces(out,centers,0,numChunks,numChunks,pMesh->mNumFaces / numChunks);
+}
+
 } // namespace Assimp
@@ -315,6 +315,18 @@ const char* MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+/** @brief Sort the faces of a mesh into spatially compact chunks
+ *
+ *  The face set is recursively bisected along the longest axis of the bounds
+ *  of the face centers, with all cuts placed at chunk boundaries. Chunk k 
+ *  consists of the faces out[k*size] to out[(k+1)*size-1], with 
+ *  size = mNumFaces/numChunks; the last chunk receives the remaining faces.
+ *  @param pMesh Input mesh
+ *  @param numChunks Number of chunks to generate
+ *  @param[out] out Receives the indices of the faces of the mesh, in sorted order */
+void ComputeFaceSpatialOrder(const aiMesh* pMesh, unsigned int numChunks, std::vector<unsigned int>& out);
+
 // -------------------------------------------------------------------------------
 // Utility postprocess step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
@@ -0,0 +1,223 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Quantization.h
+ *  @brief Helpers to encode vertex attributes in compact fixed-point
+ *    and half precision formats.
+ *
+ *  Used by the QuantizeAttributes post processing step and by the
+ *  quantized Ply exporter, which must agree on the exact encodings.
+ */
+#ifndef AI_QUANTIZATION_H_INC
+#define AI_QUANTIZATION_H_INC
+
+namespace Assimp	{
+namespace Quantization	{
+
+// ------------------------------------------------------------------------------------------------
+/** Convert a single precision float to IEEE 754 half precision, rounding to
+ *  nearest even. Values too large for a half become infinity, NaNs stay NaNs. */
+inline uint16_t FloatToHalf(float value)
+{
+	union { float f; uint32_t u; } in, magic;
+	in.f = value;
+
+	const uint32_t sign = in.u & 0x80000000u;
+	in.u ^= sign;
+
+	uint32_t out;
+	if (in.u >= (127u + 16u) << 23u) {
+		// overflow, infinity or NaN
+		out = in.u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+	}
+	else if (in.u < 113u << 23u) {
+		// result is a denormal or zero, let the FPU do the rounding
+		magic.u = ((127u - 15u) + (23u - 10u) + 1u) << 23u;
+		in.f += magic.f;
+		out = in.u - magic.u;
+	}
+	else {
+		// rebias the exponent and round the mantissa to nearest even
+		const uint32_t odd = (in.u >> 13u) & 1u;
+		in.u += ((15u - 127u) << 23u) + 0xfffu + odd;
+		out = in.u >> 13u;
+	}
+	return static_cast<uint16_t>(out | (sign >> 16u));
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Convert an IEEE 754 half precision value back to single precision */
+inline float HalfToFloat(uint16_t value)
+{
+	union { float f; uint32_t u; } out, magic;
+	const uint32_t exp_mask = 0x7c00u << 13u;
+
+	out.u = (value & 0x7fffu) << 13u;
+	const uint32_t exp = out.u & exp_mask;
+	out.u += (127u - 15u) << 23u;
+
+	if (exp == exp_mask) {
+		// infinity or NaN
+		out.u += (128u - 16u) << 23u;
+	}
+	else if (!exp) {
+		// zero or denormal, renormalize
+		magic.u = 113u << 23u;
+		out.u += 1u << 23u;
+		out.f -= magic.f;
+	}
+	out.u |= (value & 0x8000u) << 16u;
+	return out.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Compute the offset and scale to map a bounding box to the 16 bit lattice
+ *  used by QuantizePosition(). Degenerate axes get a scale of zero. */
+inline void GetPositionQuantization(const aiVector3D& min, const aiVector3D& max,
+	aiVector3D& offset, aiVector3D& scale)
+{
+	offset = min;
+	scale = aiVector3D(
+		max.x > min.x ? (max.x - min.x) / 65535.f : 0.f,
+		max.y > min.y ? (max.y - min.y) / 65535.f : 0.f,
+		max.z > min.z ? (max.z - min.z) / 65535.f : 0.f);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Quantize a single coordinate to 16 bit, given the offset and scale of its axis */
+inline uint16_t QuantizeCoordinate(float value, float offset, float scale)
+{
+	if (scale <= 0.f) {
+		return 0;
+	}
+	const float q = (value - offset) / scale + 0.5f;
+	return static_cast<uint16_t>(q <= 0.f ? 0.f : (q >= 65535.f ? 65535.f : q));
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Quantize a position to 16 bit per component, see GetPositionQuantization() */
+inline void QuantizePosition(const aiVector3D& pos, const aiVector3D& offset,
+	const aiVector3D& scale, uint16_t* out)
+{
+	out[0] = QuantizeCoordinate(pos.x,offset.x,scale.x);
+	out[1] = QuantizeCoordinate(pos.y,offset.y,scale.y);
+	out[2] = QuantizeCoordinate(pos.z,offset.z,scale.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Reconstruct a position from its quantized representation */
+inline aiVector3D DequantizePosition(const uint16_t* in, const aiVector3D& offset,
+	const aiVector3D& scale)
+{
+	return aiVector3D(offset.x + in[0] * scale.x,
+		offset.y + in[1] * scale.y,
+		offset.z + in[2] * scale.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Reconstruct a unit vector from its octahedral representation */
+inline aiVector3D DecodeOctahedral(const int16_t* in)
+{
+	float x = std::max(in[0] / 32767.f,-1.f);
+	float y = std::max(in[1] / 32767.f,-1.f);
+	const float z = 1.f - fabs(x) - fabs(y);
+	if (z < 0.f) {
+		// lower hemisphere, unfold the corners of the octahedron
+		const float ox = (1.f - fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+		const float oy = (1.f - fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+		x = ox;
+		y = oy;
+	}
+	return aiVector3D(x,y,z).Normalize();
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Encode a direction vector in two 16 bit signed normalized values by projecting
+ *  it onto an octahedron. Of the four lattice points around the projection, the one
+ *  which decodes closest to the input is chosen. Zero-length or invalid vectors
+ *  are encoded as +z.
+ *  @return The cosine of the angle between the input and the decoded vector */
+inline float EncodeOctahedral(const aiVector3D& vec, int16_t* out)
+{
+	const float l1 = fabs(vec.x) + fabs(vec.y) + fabs(vec.z);
+	if (is_special_float(l1) || l1 < 1e-20f) {
+		out[0] = out[1] = 0;
+		return 1.f;
+	}
+
+	float x = vec.x / l1, y = vec.y / l1;
+	if (vec.z < 0.f) {
+		const float ox = (1.f - fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+		const float oy = (1.f - fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+		x = ox;
+		y = oy;
+	}
+
+	const aiVector3D ref = vec / vec.Length();
+	const float fx = floor(x * 32767.f), fy = floor(y * 32767.f);
+
+	float best = -2.f;
+	for (unsigned int i = 0; i < 4; ++i) {
+		int16_t cand[2];
+		cand[0] = static_cast<int16_t>(std::max(-32767.f,std::min(32767.f,fx + (i & 1))));
+		cand[1] = static_cast<int16_t>(std::max(-32767.f,std::min(32767.f,fy + (i >> 1))));
+
+		const float d = DecodeOctahedral(cand) * ref;
+		if (d > best) {
+			best = d;
+			out[0] = cand[0];
+			out[1] = cand[1];
+		}
+	}
+	return best;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Get the angle, in radians, for a cosine returned by EncodeOctahedral() */
+inline float GetAngularError(float cosine)
+{
+	return acos(std::max(-1.f,std::min(1.f,cosine)));
+}
+
+} // ! namespace Quantization
+} // ! namespace Assimp
+
+#endif // !! AI_QUANTIZATION_H_INC
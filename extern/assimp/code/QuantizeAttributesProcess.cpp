@@ -0,0 +1,192 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file QuantizeAttributesProcess.cpp
+ *  @brief Implementation of the QuantizeAttributes post processing step
+ */
+
+#include "AssimpPCH.h"
+
+#ifndef ASSIMP_BUILD_NO_QUANTIZEATTRIBUTES_PROCESS
+
+#include "QuantizeAttributesProcess.h"
+#include "ProcessHelper.h"
+#include "ParallelHelper.h"
+#include "Quantization.h"
+#include "TinyFormatter.h"
+
+using namespace Assimp;
+using namespace Assimp::Quantization;
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+QuantizeAttributesProcess::QuantizeAttributesProcess()
+	: configSceneBounds(false)
+	, configNumThreads(1)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+QuantizeAttributesProcess::~QuantizeAttributesProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool QuantizeAttributesProcess::IsActive( unsigned int pFlags) const
+{
+	return (pFlags & aiProcess_QuantizeAttributes) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void QuantizeAttributesProcess::SetupProperties(const Importer* pImp)
+{
+	configSceneBounds = pImp->GetPropertyInteger(AI_CONFIG_PP_QA_SCENE_BOUNDS,0) != 0;
+	configNumThreads = GetNumThreads(pImp);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void QuantizeAttributesProcess::Execute( aiScene* pScene)
+{
+	DefaultLogger::get()->debug("QuantizeAttributesProcess begin");
+
+	// common bounds for all meshes, if requested
+	aiVector3D sceneMin, sceneMax;
+	MinMaxChooser<aiVector3D>()(sceneMin,sceneMax);
+	if (configSceneBounds) {
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			aiVector3D min, max;
+			ArrayBounds(pScene->mMeshes[i]->mVertices,pScene->mMeshes[i]->mNumVertices,min,max);
+			sceneMin = std::min(sceneMin,min);
+			sceneMax = std::max(sceneMax,max);
+		}
+	}
+
+	const int numMeshes = static_cast<int>(pScene->mNumMeshes);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(dynamic,1) num_threads(configNumThreads) if(configNumThreads > 1 && numMeshes > 1)
+#endif
+	for (int i = 0; i < numMeshes; ++i) {
+		aiMesh* mesh = pScene->mMeshes[i];
+		if (configSceneBounds) {
+			QuantizeMesh(mesh,sceneMin,sceneMax);
+		}
+		else {
+			aiVector3D min, max;
+			ArrayBounds(mesh->mVertices,mesh->mNumVertices,min,max);
+			QuantizeMesh(mesh,min,max);
+		}
+	}
+
+	if (!DefaultLogger::isNullLogger()) {
+		float pos = 0.f, nor = 0.f, uv = 0.f;
+		for (int i = 0; i < numMeshes; ++i) {
+			const aiQuantizedAttributes* q = pScene->mMeshes[i]->mQuantization;
+			pos = std::max(pos,q->mMaxPositionError);
+			nor = std::max(nor,q->mMaxNormalError);
+			uv = std::max(uv,q->mMaxTextureCoordError);
+		}
+		DefaultLogger::get()->info((Formatter::format("QuantizeAttributesProcess finished. Max. errors: position "),
+			pos,", normal ",AI_RAD_TO_DEG(nor)," deg, texture coordinate ",uv));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Quantize the attributes of a single mesh
+void QuantizeAttributesProcess::QuantizeMesh(aiMesh* pMesh, const aiVector3D& pMin, const aiVector3D& pMax)
+{
+	delete pMesh->mQuantization;
+	aiQuantizedAttributes* q = pMesh->mQuantization = new aiQuantizedAttributes();
+
+	const unsigned int num = pMesh->mNumVertices;
+	q->mNumVertices = num;
+
+	// positions
+	GetPositionQuantization(pMin,pMax,q->mPositionOffset,q->mPositionScale);
+
+	uint16_t* pos = new uint16_t[num*3];
+	q->mPositions = pos;
+	for (unsigned int i = 0; i < num; ++i, pos += 3) {
+		const aiVector3D& v = pMesh->mVertices[i];
+		QuantizePosition(v,q->mPositionOffset,q->mPositionScale,pos);
+
+		const aiVector3D d = DequantizePosition(pos,q->mPositionOffset,q->mPositionScale) - v;
+		q->mMaxPositionError = std::max(q->mMaxPositionError,
+			std::max(fabs(d.x),std::max(fabs(d.y),fabs(d.z))));
+	}
+
+	// normals, tangents and bitangents
+	float minCos = 1.f;
+	const aiVector3D* const dirs[3] = {pMesh->mNormals,pMesh->mTangents,pMesh->mBitangents};
+	short** const outDirs[3] = {&q->mNormals,&q->mTangents,&q->mBitangents};
+	for (unsigned int a = 0; a < 3; ++a) {
+		if (!dirs[a]) {
+			continue;
+		}
+		int16_t* out = *outDirs[a] = new int16_t[num*2];
+		for (unsigned int i = 0; i < num; ++i, out += 2) {
+			minCos = std::min(minCos,EncodeOctahedral(dirs[a][i],out));
+		}
+	}
+	q->mMaxNormalError = GetAngularError(minCos);
+
+	// texture coordinates
+	for (unsigned int a = 0; pMesh->HasTextureCoords(a); ++a) {
+		const unsigned int comp = pMesh->mNumUVComponents[a];
+		q->mNumUVComponents[a] = comp;
+
+		uint16_t* out = q->mTextureCoords[a] = new uint16_t[num*comp];
+		for (unsigned int i = 0; i < num; ++i) {
+			for (unsigned int c = 0; c < comp; ++c, ++out) {
+				const float f = pMesh->mTextureCoords[a][i][c];
+				*out = FloatToHalf(f);
+				q->mMaxTextureCoordError = std::max(q->mMaxTextureCoordError,fabs(HalfToFloat(*out) - f));
+			}
+		}
+	}
+}
+
+#endif // !! ASSIMP_BUILD_NO_QUANTIZEATTRIBUTES_PROCESS
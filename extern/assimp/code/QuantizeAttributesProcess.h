@@ -0,0 +1,96 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file QuantizeAttributesProcess.h
+ *  @brief Defines a post processing step to store compact, quantized copies
+ *    of the vertex attributes of all meshes.
+ */
+#ifndef AI_QUANTIZEATTRIBUTESPROCESS_H_INC
+#define AI_QUANTIZEATTRIBUTESPROCESS_H_INC
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** The QuantizeAttributesProcess generates an #aiQuantizedAttributes structure
+ *  for each mesh, see #aiProcess_QuantizeAttributes. Meshes are processed in
+ *  parallel.
+ */
+class QuantizeAttributesProcess : public BaseProcess
+{
+public:
+
+	QuantizeAttributesProcess();
+	~QuantizeAttributesProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	void Execute( aiScene* pScene);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Quantize the attributes of a single mesh.
+	 *  @param pMesh Mesh to be processed, its previous quantized 
+	 *    attributes, if any, are replaced.
+	 *  @param pMin Minimum of the bounds to quantize the positions to
+	 *  @param pMax Maximum of the bounds */
+	static void QuantizeMesh(aiMesh* pMesh, const aiVector3D& pMin, const aiVector3D& pMax);
+
+private:
+
+	bool configSceneBounds;
+	int configNumThreads;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_QUANTIZEATTRIBUTESPROCESS_H_INC
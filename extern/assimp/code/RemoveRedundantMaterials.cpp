@@ -48,12 +48,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "ProcessHelper.h"
 #include "MaterialSystem.h"
+#include "ParallelHelper.h"
 
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 RemoveRedundantMatsProcess::RemoveRedundantMatsProcess()
+: configNumThreads (1)
 {
 	// nothing to do here
 }
@@ -78,6 +80,8 @@ void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp)
 {
 	// Get value of AI_CONFIG_PP_RRM_EXCLUDE_LIST
 	configFixedMaterials = pImp->GetPropertyString(AI_CONFIG_PP_RRM_EXCLUDE_LIST,"");
+
+	configNumThreads = GetNumThreads(pImp);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -86,7 +90,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("RemoveRedundantMatsProcess begin");
 
-	unsigned int iCnt = 0, unreferenced = 0;
+	unsigned int iCnt = 0, unreferenced = 0, collisions = 0;
 	if (pScene->mNumMaterials)
 	{
 		// Find out which materials are referenced by meshes
@@ -131,12 +135,26 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 		unsigned int* aiMappingTable = new unsigned int[pScene->mNumMaterials];
 		unsigned int iNewNum = 0;
 
-		// Iterate through all materials and calculate a hash for them
-		// store all hashes in a list and so a quick search whether
-		// we do already have a specific hash. This allows us to
+		// Calculate a hash for all materials. This is independent for
+		// every material, so it is done in parallel.
+		std::vector<uint32_t> aiHashes(pScene->mNumMaterials,0);
+		const int iNumMaterials = static_cast<int>(pScene->mNumMaterials);
+#ifdef _OPENMP
+#		pragma omp parallel for schedule(dynamic,64) num_threads(configNumThreads) if(iNumMaterials > 256)
+#endif
+		for (int i = 0; i < iNumMaterials;++i)
+		{
+			if (abReferenced[i]) {
+				aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
+			}
+		}
+
+		// Sort all materials into buckets by their hash. A material is only
+		// compared to the materials in its bucket, which are the unique 
+		// materials seen so far with the same hash. This allows us to
 		// determine which materials are identical.
-		uint32_t* aiHashes;
-		aiHashes = new uint32_t[pScene->mNumMaterials];
+		typedef std::map<uint32_t, std::vector<unsigned int> > HashBuckets;
+		HashBuckets buckets;
 		for (unsigned int i = 0; i < pScene->mNumMaterials;++i)
 		{
 			// if the material is not referenced ... remove it
@@ -145,18 +163,23 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 				continue;
 			}
 
-			uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-			for (unsigned int a = 0; a < i;++a)
+			std::vector<unsigned int>& bucket = buckets[aiHashes[i]];
+			std::vector<unsigned int>::const_iterator it = bucket.begin();
+			for (; it != bucket.end(); ++it)
 			{
-				if (abReferenced[a] && me == aiHashes[a]) {
-					++iCnt;
-					me = 0;
-					aiMappingTable[i] = aiMappingTable[a];
-					delete pScene->mMaterials[i];
+				if (CompareMaterials(pScene->mMaterials[*it],pScene->mMaterials[i])) {
 					break;
 				}
+				++collisions;
+			}
+
+			if (it != bucket.end()) {
+				++iCnt;
+				aiMappingTable[i] = aiMappingTable[*it];
+				delete pScene->mMaterials[i];
 			}
-			if (me)	{
+			else {
+				bucket.push_back(i);
 				aiMappingTable[i] = iNewNum++;
 			}
 		}
@@ -191,15 +214,14 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 			pScene->mNumMaterials = iNewNum;
 		}
 		// delete temporary storage
-		delete[] aiHashes;
 		delete[] aiMappingTable;
 	}
 	if (!iCnt)DefaultLogger::get()->debug("RemoveRedundantMatsProcess finished ");
 	else 
 	{
-		char szBuffer[128]; // should be sufficiently large
-		::sprintf(szBuffer,"RemoveRedundantMatsProcess finished. %i redundant and %i unused materials",
-			iCnt,unreferenced);
+		char szBuffer[192]; // should be sufficiently large
+		::sprintf(szBuffer,"RemoveRedundantMatsProcess finished. %i redundant and %i unused materials, "
+			"%i hash collisions",iCnt,unreferenced,collisions);
 		DefaultLogger::get()->info(szBuffer);
 	}
 }
@@ -95,6 +95,9 @@ private:
 
 	//! Configuration option: list of all fixed materials
 	std::string configFixedMaterials;
+
+	//! Number of threads to be used, see #AI_CONFIG_GLOB_MULTITHREADING
+	int configNumThreads;
 };
 
 } // end of namespace Assimp
@@ -55,57 +55,129 @@ void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 	// invoke the exporter 
 	STLExporter exporter(pFile, pScene);
 
-	// we're still here - export successfully completed. Write the file.
+	// the output is streamed to the file directly
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	exporter.WriteFile(outfile.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Worker function for exporting a scene to binary Stereolithograpy. Prototyped and registered in Exporter.cpp
+void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
+{
+	// invoke the exporter 
+	STLExporter exporter(pFile, pScene, true);
+
+	// the output is streamed to the file directly
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
+	exporter.WriteFile(outfile.get());
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene)
+STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool binary)
 : filename(_filename)
 , pScene(pScene)
+, binary(binary)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
+}
 
-	const std::string& name = "AssimpScene";
+// ------------------------------------------------------------------------------------------------
+void STLExporter :: WriteFile(IOStream* outfile)
+{
+	StreamWriterLE out(outfile);
+
+	if (binary) {
+		// 80 byte header, which must not start with 'solid' or readers will take us for ASCII STL
+		char header[80] = {0};
+		::strncpy(header,"Binary STL file produced by Open Asset Import Library (http://www.assimp.sf.net)",79);
+		out.PutBytes(header,80);
+
+		// only triangles can be represented, everything else is skipped
+		uint32_t triangles = 0;
+		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			const aiMesh* const m = pScene->mMeshes[i];
+			for (unsigned int f = 0; f < m->mNumFaces; ++f) {
+				triangles += m->mFaces[f].mNumIndices == 3;
+			}
+		}
+		out.PutU4(triangles);
+
+		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			WriteMeshBinary(out,pScene->mMeshes[i]);
+		}
+	}
+	else {
+		const std::string& name = "AssimpScene";
 	
-	mOutput << "solid " << name << endl;
-	for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-		WriteMesh(pScene->mMeshes[i]);
+		out << "solid " << name << endl;
+		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			WriteMesh(out,pScene->mMeshes[i]);
+		}
+		out << "endsolid " << name << endl;
 	}
-	mOutput << "endsolid " << name << endl;
+	out.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
-void STLExporter :: WriteMesh(const aiMesh* m)
+aiVector3D STLExporter :: GetFaceNormal(const aiMesh* m, const aiFace& f)
+{
+	// we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
+	// but nonetheless we have to expect per-vertex normals.
+	aiVector3D nor;
+	if (m->mNormals) {
+		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
+			nor += m->mNormals[f.mIndices[a]];
+		}
+		nor.Normalize();
+	}
+	return nor;
+}
+
+// ------------------------------------------------------------------------------------------------
+void STLExporter :: WriteMesh(StreamWriterLE& out, const aiMesh* m)
 {
 	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
 		const aiFace& f = m->mFaces[i];
 
-		// we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
-		// but nonetheless we have to expect per-vertex normals.
-		aiVector3D nor;
-		if (m->mNormals) {
-			for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-				nor += m->mNormals[f.mIndices[a]];
-			}
-			nor.Normalize();
-		}
-		mOutput << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
-		mOutput << "  outer loop" << endl; 
+		const aiVector3D nor = GetFaceNormal(m,f);
+		out << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
+		out << "  outer loop" << endl; 
 		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
 			const aiVector3D& v  = m->mVertices[f.mIndices[a]];
-			mOutput << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
+			out << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
+		}
+
+		out << "  endloop" << endl; 
+		out << " endfacet" << endl << endl; 
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void STLExporter :: WriteMeshBinary(StreamWriterLE& out, const aiMesh* m)
+{
+	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+		const aiFace& f = m->mFaces[i];
+		if (f.mNumIndices != 3) {
+			continue;
+		}
+
+		const aiVector3D nor = GetFaceNormal(m,f);
+		out.PutF4(nor.x);
+		out.PutF4(nor.y);
+		out.PutF4(nor.z);
+
+		for(unsigned int a = 0; a < 3; ++a) {
+			const aiVector3D& v  = m->mVertices[f.mIndices[a]];
+			out.PutF4(v.x);
+			out.PutF4(v.y);
+			out.PutF4(v.z);
 		}
 
-		mOutput << "  endloop" << endl; 
-		mOutput << " endfacet" << endl << endl; 
+		// attribute byte count, unused
+		out.PutU2(0);
 	}
 }
 
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "StreamWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -53,27 +53,32 @@ namespace Assimp
 {
 
 // ------------------------------------------------------------------------------------------------
-/** Helper class to export a given scene to a STL file. */
+/** Helper class to export a given scene to a STL file. The output is streamed to the
+ *  target file, either as ASCII or as binary STL. */
 // ------------------------------------------------------------------------------------------------
 class STLExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	STLExporter(const char* filename, const aiScene* pScene);
+	STLExporter(const char* filename, const aiScene* pScene, bool binary = false);
 
 public:
 
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	/// Write the whole file to a stream
+	void WriteFile(IOStream* outfile);
 
 private:
 
-	void WriteMesh(const aiMesh* m);
+	void WriteMesh(StreamWriterLE& out, const aiMesh* m);
+	void WriteMeshBinary(StreamWriterLE& out, const aiMesh* m);
+
+	aiVector3D GetFaceNormal(const aiMesh* m, const aiFace& f);
 
 private:
 
 	const std::string filename;
 	const aiScene* const pScene;
+	const bool binary;
 
 	// this endl() doesn't flush() the stream
 	const std::string endl;
@@ -1004,6 +1004,54 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 		aiFace& f = dest->mFaces[i];
 		GetArrayCopy(f.mIndices,f.mNumIndices);
 	}
+
+	// and of the quantized vertex attributes and meshlets
+	if (dest->mQuantization) {
+		Copy(&dest->mQuantization,src->mQuantization);
+	}
+	if (dest->mMeshlets) {
+		Copy(&dest->mMeshlets,src->mMeshlets);
+	}
+
+	// make a deep copy of all levels of detail
+	CopyPtrArray(dest->mLODs,src->mLODs,dest->mNumLODs);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy (aiMeshletTable** _dest, const aiMeshletTable* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiMeshletTable* dest = *_dest = new aiMeshletTable();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiMeshletTable));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mMeshlets,  dest->mNumMeshlets );
+	GetArrayCopy( dest->mVertices,  dest->mNumVertices );
+	GetArrayCopy( dest->mTriangles, dest->mNumTriangles * 3 );
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy (aiQuantizedAttributes** _dest, const aiQuantizedAttributes* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiQuantizedAttributes* dest = *_dest = new aiQuantizedAttributes();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiQuantizedAttributes));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mPositions,  dest->mNumVertices * 3 );
+	GetArrayCopy( dest->mNormals,    dest->mNumVertices * 2 );
+	GetArrayCopy( dest->mTangents,   dest->mNumVertices * 2 );
+	GetArrayCopy( dest->mBitangents, dest->mNumVertices * 2 );
+
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		GetArrayCopy( dest->mTextureCoords[n], dest->mNumVertices * dest->mNumUVComponents[n] );
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -335,6 +335,8 @@ public:
 	static void Copy  (aiBone** dest, const aiBone* src);
 	static void Copy  (aiLight** dest, const aiLight* src);
 	static void Copy  (aiNodeAnim** dest, const aiNodeAnim* src);
+	static void Copy  (aiQuantizedAttributes** dest, const aiQuantizedAttributes* src);
+	static void Copy  (aiMeshletTable** dest, const aiMeshletTable* src);
 
 	// recursive, of course
 	static void Copy     (aiNode** dest, const aiNode* src);
@@ -50,11 +50,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Reorder the faces of a mesh so that each run of mNumFaces/numChunks faces
+// covers a compact region. Splitting the mesh at these boundaries then yields
+// submeshes with tight bounds and few shared vertices.
+static void SortFacesSpatially(aiMesh* pMesh, unsigned int numChunks)
+{
+	std::vector<unsigned int> order;
+	ComputeFaceSpatialOrder(pMesh,numChunks,order);
+
+	aiFace* pcFaces = new aiFace[pMesh->mNumFaces];
+	for (unsigned int a = 0; a < pMesh->mNumFaces;++a)
+	{
+		// take over the index array, the old face must not delete it
+		aiFace& src = pMesh->mFaces[order[a]];
+		pcFaces[a].mNumIndices = src.mNumIndices;
+		pcFaces[a].mIndices = src.mIndices;
+		src.mIndices = NULL;
+	}
+	delete[] pMesh->mFaces;
+	pMesh->mFaces = pcFaces;
+}
 
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle()
 {
 	LIMIT = AI_SLM_DEFAULT_MAX_TRIANGLES;
+	SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -106,6 +128,7 @@ void SplitLargeMeshesProcess_Triangle::SetupProperties( const Importer* pImp)
 {
     // get the current value of the split property
 	this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,AI_SLM_DEFAULT_MAX_TRIANGLES);
+	this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -161,6 +184,10 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 		const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes;
 		const unsigned int iOutVertexNum = iOutFaceNum * 3;
 
+		// group spatially close faces in the ranges we are going to copy
+		if (SPATIAL)
+			SortFacesSpatially(pMesh,iSubMeshes);
+
 		// now generate all submeshes
 		for (unsigned int i = 0; i < iSubMeshes;++i)
 		{
@@ -353,6 +380,7 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 SplitLargeMeshesProcess_Vertex::SplitLargeMeshesProcess_Vertex()
 {
 	LIMIT = AI_SLM_DEFAULT_MAX_VERTICES;
+	SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -403,6 +431,7 @@ void SplitLargeMeshesProcess_Vertex::Execute( aiScene* pScene)
 void SplitLargeMeshesProcess_Vertex::SetupProperties( const Importer* pImp)
 {
 	this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,AI_SLM_DEFAULT_MAX_VERTICES);
+	this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -425,6 +454,12 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 		const unsigned int iSubMeshes = (pMesh->mNumVertices / SplitLargeMeshesProcess_Vertex::LIMIT) + 1;
 		//const unsigned int iOutVertexNum2 = pMesh->mNumVertices /iSubMeshes;
 
+		// group spatially close faces. A submesh is always finished at the end
+		// of such a group, even if it could take more vertices.
+		const unsigned int iChunkSize = std::max(pMesh->mNumFaces / iSubMeshes,1u);
+		if (SPATIAL)
+			SortFacesSpatially(pMesh,iSubMeshes);
+
 		// create a std::vector<unsigned int> to indicate which vertices
 		// have already been copied
 		std::vector<unsigned int> avWasCopied;
@@ -498,6 +533,12 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 			// (we will also need to copy the array of indices)
 			while (iBase < pMesh->mNumFaces)
 			{
+				if (SPATIAL && !vFaces.empty() && 0 == iBase % iChunkSize && iBase / iChunkSize < iSubMeshes)
+				{
+					// start a new submesh with the next group of faces
+					break;
+				}
+
 				// allocate a new array
 				const unsigned int iNumIndices = pMesh->mFaces[iBase].mNumIndices;
 
@@ -117,6 +117,10 @@ public:
 	inline unsigned int GetLimit() const
 		{return LIMIT;}
 
+	//! Enable or disable splitting by spatial locality
+	inline void SetSpatial(bool b)
+		{SPATIAL = b;}
+
 public:
 
 	// -------------------------------------------------------------------
@@ -140,6 +144,9 @@ public:
 public:
 	//! Triangle limit 
 	unsigned int LIMIT;
+
+	//! Sort faces by spatial locality before splitting
+	bool SPATIAL;
 };
 
 
@@ -181,6 +188,10 @@ public:
 	inline unsigned int GetLimit() const
 		{return LIMIT;}
 
+	//! Enable or disable splitting by spatial locality
+	inline void SetSpatial(bool b)
+		{SPATIAL = b;}
+
 public:
 
 	// -------------------------------------------------------------------
@@ -200,6 +211,9 @@ public:
 public:
 	//! Triangle limit 
 	unsigned int LIMIT;
+
+	//! Sort faces by spatial locality before splitting
+	bool SPATIAL;
 };
 
 } // end of namespace Assimp
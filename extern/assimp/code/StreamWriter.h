@@ -0,0 +1,289 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines the StreamWriter class which writes text and binary data
+ *  to an IOStream through a fixed-size buffer. */
+
+#ifndef AI_STREAMWRITER_H_INCLUDED
+#define AI_STREAMWRITER_H_INCLUDED
+
+#include "ByteSwap.h"
+#include "StringComparison.h"
+#include "Exceptional.h"
+
+/** Default size of the intermediate buffer of a StreamWriter, in bytes */
+#ifndef AI_STREAMWRITER_BUFFER_SIZE
+#	define AI_STREAMWRITER_BUFFER_SIZE (1 << 16)
+#endif
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** Wrapper class around IOStream to write text and binary data through a buffer of bounded
+ *  size. Exporters use it to stream their output directly to the target file instead of
+ *  building the whole file in memory first. Don't attempt to instance the template directly.
+ *  Use StreamWriterLE to write little-endian binary data and StreamWriterBE to write
+ *  big-endian binary data. Text output is not affected by the byte order.
+ *
+ *  Numbers written through operator<< are formatted like std::ostream does with the
+ *  "C" locale, floats are converted by #ASSIMP_ftoa.
+ *
+ *  All write errors are reported by throwing DeadlyExportError. */
+// --------------------------------------------------------------------------------------------
+template <bool SwapEndianess = false>
+class StreamWriter
+{
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Construction from a given stream. 
+	 *
+	 *  The StreamWriter does NOT take ownership of the stream. 
+	 *  @param stream Output stream, writing starts at the current
+	 *    file pointer position.
+	 *  @param capacity Size of the intermediate buffer, in bytes. */
+	StreamWriter(IOStream* stream, size_t capacity = AI_STREAMWRITER_BUFFER_SIZE)
+		: stream(stream)
+		, capacity(std::max(capacity,static_cast<size_t>(AI_FTOA_BUFFER_SIZE)))
+	{
+		if (!stream) {
+			throw DeadlyExportError("StreamWriter: Unable to open file");
+		}
+		current = buffer = new char[this->capacity];
+		end = buffer + this->capacity;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Destruction. Any pending data is written to the stream, but errors
+	 *  are silently ignored. Call Flush() to get them reported. */
+	~StreamWriter() {
+		if (current != buffer) {
+			stream->Write(buffer,1,current - buffer);
+		}
+		delete[] buffer;
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Write all buffered data to the underlying stream */
+	void Flush() {
+		const size_t size = current - buffer;
+		current = buffer;
+		if (size && stream->Write(buffer,1,size) != size) {
+			throw DeadlyExportError("StreamWriter: Failed to write to the output stream");
+		}
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a raw chunk of memory */
+	void PutBytes(const void* data, size_t size) {
+		if (size > static_cast<size_t>(end - current)) {
+			Flush();
+			if (size >= capacity) {
+				// no point in copying large chunks around
+				if (stream->Write(data,1,size) != size) {
+					throw DeadlyExportError("StreamWriter: Failed to write to the output stream");
+				}
+				return;
+			}
+		}
+		::memcpy(current,data,size);
+		current += size;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a float to the stream  */
+	void PutF4(float f)	{
+		Put(f);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a double to the stream  */
+	void PutF8(double f)	{
+		Put(f);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a signed 16 bit integer to the stream */
+	void PutI2(int16_t i)	{
+		Put(i);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a signed 8 bit integer to the stream */
+	void PutI1(int8_t i)	{
+		Reserve(1);
+		*current++ = static_cast<char>(i);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write an signed 32 bit integer to the stream */
+	void PutI4(int32_t i)	{
+		Put(i);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write an unsigned 16 bit integer to the stream */
+	void PutU2(uint16_t i)	{
+		Put(i);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write a unsigned 8 bit integer to the stream */
+	void PutU1(uint8_t i)	{
+		Reserve(1);
+		*current++ = static_cast<char>(i);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Write an unsigned 32 bit integer to the stream */
+	void PutU4(uint32_t i)	{
+		Put(i);
+	}
+
+public:
+
+	// text output, chaining of << ops is allowed
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (const char* s) {
+		PutBytes(s,::strlen(s));
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (const std::string& s) {
+		PutBytes(s.data(),s.length());
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (char c) {
+		Reserve(1);
+		*current++ = c;
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (unsigned int n) {
+		Reserve(AI_FTOA_BUFFER_SIZE);
+
+		char tmp[16];
+		unsigned int i = 0;
+		do {
+			tmp[i++] = static_cast<char>('0' + n % 10);
+			n /= 10;
+		}
+		while (n);
+		while (i) {
+			*current++ = tmp[--i];
+		}
+		return *this;
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (int n) {
+		if (n < 0) {
+			*this << '-';
+			return *this << static_cast<unsigned int>(-static_cast<int64_t>(n));
+		}
+		return *this << static_cast<unsigned int>(n);
+	}
+
+	// ---------------------------------------------------------------------
+	StreamWriter& operator << (float f) {
+		Reserve(AI_FTOA_BUFFER_SIZE);
+		current += ASSIMP_ftoa(current,f);
+		return *this;
+	}
+
+private:
+
+	// ---------------------------------------------------------------------
+	/** Generic binary write method. ByteSwap::Swap(T*) *must* be defined */
+	template <typename T>
+	void Put(T f)	{
+		if (SwapEndianess) {
+			ByteSwap::Swap(&f);
+		}
+		Reserve(sizeof(T));
+		::memcpy(current,&f,sizeof(T));
+		current += sizeof(T);
+	}
+
+	// ---------------------------------------------------------------------
+	/** Make sure there are at least n free bytes in the buffer */
+	void Reserve(size_t n)	{
+		ai_assert(n <= capacity);
+		if (static_cast<size_t>(end - current) < n) {
+			Flush();
+		}
+	}
+
+private:
+
+	// noncopyable
+	StreamWriter(const StreamWriter&);
+	StreamWriter& operator= (const StreamWriter&);
+
+private:
+
+	IOStream* const stream;
+	const size_t capacity;
+	char *buffer, *current, *end;
+};
+
+
+// --------------------------------------------------------------------------------------------
+// `static` StreamWriters. Their byte order is fixed and they might be a little bit faster.
+#ifdef AI_BUILD_BIG_ENDIAN
+	typedef StreamWriter<true>  StreamWriterLE;
+	typedef StreamWriter<false> StreamWriterBE;
+#else
+	typedef StreamWriter<true>  StreamWriterBE;
+	typedef StreamWriter<false> StreamWriterLE;
+#endif
+
+} // end namespace Assimp
+
+#endif // !! AI_STREAMWRITER_H_INCLUDED
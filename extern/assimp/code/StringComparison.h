@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** @file Definition of platform independent string workers:
 
    ASSIMP_itoa10
+   ASSIMP_ftoa
    ASSIMP_stricmp
    ASSIMP_strincmp
 
@@ -51,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_STRING_WORKERS_H
 
 #include "../include/assimp/ai_assert.h"
+#include <cstdio>
 
 namespace Assimp	{
 
@@ -114,6 +116,102 @@ inline unsigned int ASSIMP_itoa10( char(& out)[length], int32_t number)
 	return ASSIMP_itoa10(out,length,number);
 }
 
+// -------------------------------------------------------------------------------
+/** @brief Fast float to string conversion.
+ *
+ *  The output is identical to printf("%g") and to the default formatting of
+ *  std::ostream (6 significant digits, trailing zeroes dropped), but the
+ *  common case - magnitudes between 1e-4 and 1e6 - is handled without any
+ *  locale or stream machinery. Everything else is passed on to sprintf().
+ *  @param out Output buffer, must be able to hold at least
+ *    #AI_FTOA_BUFFER_SIZE characters.
+ *  @param number Number to be written
+ *  @return Length of the output string, excluding the '\0'
+ */
+#define AI_FTOA_BUFFER_SIZE 32
+
+inline unsigned int ASSIMP_ftoa( char* out, float number)
+{
+	ai_assert(NULL != out);
+
+	static const double pow10[] = {
+		1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+	};
+
+	const double d = number;
+	const double a = d < 0. ? -d : d;
+	if (d == 0.) {
+		out[0] = '0';
+		out[1] = '\0';
+		return 1u;
+	}
+
+	// NaNs fail this comparison as well
+	if (!(a >= 1e-4 && a < 1e6)) {
+		return static_cast<unsigned int>(::sprintf(out,"%g",d));
+	}
+
+	// decimal exponent, in [-4,5]
+	int e = 5;
+	while (a < pow10[e+4]) {
+		--e;
+	}
+
+	// 6 significant digits, so there are 5-e digits after the decimal point
+	const unsigned int decimals = static_cast<unsigned int>(5 - e);
+
+	// the product is exact (24 bit mantissa times at most 10^9), so ties
+	// can be detected reliably and rounded to even just like printf does.
+	const double t = a * pow10[decimals+4];
+	unsigned int scaled = static_cast<unsigned int>(t);
+	const double frac = t - scaled;
+	if (frac > 0.5 || (frac == 0.5 && (scaled & 0x1))) {
+		++scaled;
+	}
+	if (scaled >= 1000000u) {
+		// rounding carried into the next decade (i.e. 9.999999 -> 10),
+		// rare enough not to care about the extra cost.
+		return static_cast<unsigned int>(::sprintf(out,"%g",d));
+	}
+
+	char* const begin = out;
+	if (d < 0.) {
+		*out++ = '-';
+	}
+
+	const unsigned int div = static_cast<unsigned int>(pow10[decimals+4]);
+	unsigned int ipart = scaled / div, fpart = scaled % div;
+
+	char tmp[16];
+	unsigned int n = 0;
+	do {
+		tmp[n++] = static_cast<char>('0' + ipart % 10);
+		ipart /= 10;
+	}
+	while (ipart);
+	while (n) {
+		*out++ = tmp[--n];
+	}
+
+	if (fpart) {
+		unsigned int digits = decimals;
+		while (!(fpart % 10)) {
+			fpart /= 10;
+			--digits;
+		}
+
+		*out++ = '.';
+		for (unsigned int i = digits; i > 0; --i) {
+			out[i-1] = static_cast<char>('0' + fpart % 10);
+			fpart /= 10;
+		}
+		out += digits;
+	}
+
+	*out = '\0';
+	return static_cast<unsigned int>(out - begin);
+}
+
 // -------------------------------------------------------------------------------
 /** @brief Helper function to do platform independent string comparison.
  *
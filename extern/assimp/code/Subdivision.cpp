@@ -47,7 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Vertex.h"
 
 using namespace Assimp;
-void mydummy() {}
+
+// Minimum number of faces to evaluate a subdivision step in parallel
+#define AI_SUBDIVISION_PARALLEL_THRESHOLD 1024
 
 // ------------------------------------------------------------------------------------------------
 /** Subdivider stub class to implement the Catmull-Clarke subdivision algorithm. The 
@@ -63,41 +65,7 @@ public:
 	void Subdivide (aiMesh** smesh, size_t nmesh,
 		aiMesh** out, unsigned int num, bool discard_input);
 
-	// ---------------------------------------------------------------------------
-	/** Intermediate description of an edge between two corners of a polygon*/
-	// ---------------------------------------------------------------------------
-	struct Edge
-	{
-		Edge()
-			: ref(0)
-		{}
-		Vertex edge_point, midpoint;
-		unsigned int ref;
-	};
-
-
-
 	typedef std::vector<unsigned int> UIntVector;
-	typedef std::map<uint64_t,Edge> EdgeMap;
-
-	// ---------------------------------------------------------------------------
-	// Hashing function to derive an index into an #EdgeMap from two given
-	// 'unsigned int' vertex coordinates (!!distinct coordinates - same 
-	// vertex position == same index!!). 
-	// NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-	// and (id[0]>2^32-1 or id[0]>2^32-1).
-	// MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-	// at the head of every function which is about to use MAKE_EDGE_HASH().
-	// Reason is that the hash is that hash construction needs to hold the
-	// invariant id0<id1 to identify an edge - else two hashes would refer
-	// to the same edge.
-	// ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0,id1) (eh_tmp0__=id0,eh_tmp1__=id1,\
-	(eh_tmp0__<eh_tmp1__?std::swap(eh_tmp0__,eh_tmp1__):mydummy()),(uint64_t)eh_tmp0__^((uint64_t)eh_tmp1__<<32u))
-
-
-#define INIT_EDGE_HASH_TEMPORARIES()\
-	unsigned int eh_tmp0__, eh_tmp1__;
 
 private:
 
@@ -217,25 +185,28 @@ void CatmullClarkSubdivider::Subdivide (
 }
 
 // ------------------------------------------------------------------------------------------------
-// Note - this is an implementation of the standard (recursive) Cm-Cl algorithm without further 
-// optimizations (except we're using some nice LUTs). A description of the algorithm can be found
-// here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
+// Note - this is an implementation of the standard (recursive) Cm-Cl algorithm. A description of
+// the algorithm can be found here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
-// The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
-// mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
-// in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings). 
-// Previous data is replaced/deleted then.
+// All connectivity is kept in flat tables indexed by 'corners' - a corner is a face-vertex pair,
+// corners are numbered continuously over all faces of all meshes. Every corner also stands for
+// the edge leading to the next corner of its face. With these tables, face points, edge points
+// and vertex points can be computed independently of each other, so all three passes as well
+// as the generation of the output meshes run in parallel. Only the spatial sort is O(nlogn),
+// everything else is O(n).
+//
+// Calling #InternSubdivide() directly is not encouraged. The code can operate in-place unless
+// 'smesh' and 'out' are equal (no strange overlaps or reorderings). Previous data is
+// replaced/deleted then.
 // ------------------------------------------------------------------------------------------------
 void CatmullClarkSubdivider::InternSubdivide (
-	const aiMesh* const * smesh, 
+	const aiMesh* const * smesh,
 	size_t nmesh,
-	aiMesh** out, 
+	aiMesh** out,
 	unsigned int num
 	)
 {
 	ai_assert(NULL != smesh && NULL != out);
-	INIT_EDGE_HASH_TEMPORARIES();
 
 	// no subdivision requested or end of recursive refinement
 	if (!num) {
@@ -251,7 +222,7 @@ void CatmullClarkSubdivider::InternSubdivide (
 	// ---------------------------------------------------------------------
 	typedef std::pair<unsigned int,unsigned int> IntPair;
 	std::vector<IntPair> moffsets(nmesh);
-	unsigned int totfaces = 0, totvert = 0;
+	unsigned int totfaces = 0, totvert = 0, totcorners = 0;
 	for (size_t t = 0; t < nmesh; ++t) {
 		const aiMesh* mesh = smesh[t];
 
@@ -260,82 +231,165 @@ void CatmullClarkSubdivider::InternSubdivide (
 
 		totfaces += mesh->mNumFaces;
 		totvert  += mesh->mNumVertices;
+
+		for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+			totcorners += mesh->mFaces[i].mNumIndices;
+		}
 	}
 
 	spatial.Finalize();
 	const unsigned int num_unique = spatial.GenerateMappingTable(maptbl,ComputePositionEpsilon(smesh,nmesh));
 
-
-#define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second+vert_idx)
-#define   FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first+face_idx)
-
 	// ---------------------------------------------------------------------
-	// 1. Compute the centroid point for all faces
+	// 1. Build the flat face and corner tables. For each face, we store
+	// the mesh it belongs to and its first corner, for each corner, the
+	// face, the vertex index in its mesh and the distinct vertex index.
 	// ---------------------------------------------------------------------
-	std::vector<Vertex> centroids(totfaces);
-	unsigned int nfacesout = 0;
-	for (size_t t = 0, n = 0; t < nmesh; ++t) {
+	UIntVector facemesh(totfaces), faceofs(totfaces+1);
+	UIntVector cornerface(totcorners), cornervert(totcorners), corners(totcorners);
+	for (size_t t = 0, n = 0, c = 0; t < nmesh; ++t) {
 		const aiMesh* mesh = smesh[t];
-		for (unsigned int i = 0; i < mesh->mNumFaces;++i,++n)
-		{
+		for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++n) {
 			const aiFace& face = mesh->mFaces[i];
-			Vertex& c = centroids[n];
 
-			for (unsigned int a = 0; a < face.mNumIndices;++a) {
-				c += Vertex(mesh,face.mIndices[a]);
+			facemesh[n] = static_cast<unsigned int>(t);
+			faceofs[n] = static_cast<unsigned int>(c);
+			for (unsigned int a = 0; a < face.mNumIndices; ++a, ++c) {
+				cornerface[c] = static_cast<unsigned int>(n);
+				cornervert[c] = face.mIndices[a];
+				corners[c] = maptbl[moffsets[t].second+face.mIndices[a]];
 			}
+		}
+	}
+	faceofs[totfaces] = totcorners;
+
+#define CORNER_VERTEX(c) Vertex(smesh[facemesh[cornerface[c]]],cornervert[c])
+#define NEXT_CORNER(c) (c+1 == faceofs[cornerface[c]+1] ? faceofs[cornerface[c]] : c+1)
+#define PREV_CORNER(c) (c == faceofs[cornerface[c]] ? faceofs[cornerface[c]+1]-1 : c-1)
 
-			c /= static_cast<float>(face.mNumIndices);
-			nfacesout += face.mNumIndices;
+	// ---------------------------------------------------------------------
+	// 2. Compute the centroid point for all faces
+	// ---------------------------------------------------------------------
+	std::vector<Vertex> centroids(totfaces);
+#ifdef _OPENMP
+#	pragma omp parallel for num_threads(numThreads) if(totfaces > AI_SUBDIVISION_PARALLEL_THRESHOLD)
+#endif
+	for (int i = 0; i < static_cast<int>(totfaces); ++i) {
+		Vertex& c = centroids[i];
+		for (unsigned int a = faceofs[i]; a < faceofs[i+1]; ++a) {
+			c += CORNER_VERTEX(a);
 		}
+
+		c /= static_cast<float>(faceofs[i+1]-faceofs[i]);
 	}
-	
-	EdgeMap edges;
 
 	// ---------------------------------------------------------------------
-	// 2. Set each edge point to be the average of all neighbouring 
-	// face points and original points. Every edge exists twice
-	// if there is a neighboring face.
+	// 3. Compute a vertex-corner adjacency table. We can't reuse the code
+	// from VertexTriangleAdjacency because we need the table for multiple
+	// meshes and out vertex indices need to be mapped to distinct values
+	// first. Corners are added in ascending order, so the first entry for
+	// a vertex is always the corner where it is referenced first.
 	// ---------------------------------------------------------------------
-	for (size_t t = 0; t < nmesh; ++t) {
-		const aiMesh* mesh = smesh[t];
+	UIntVector adjcorners(totcorners), ofsadj(num_unique+2,0); {
+	for (unsigned int c = 0; c < totcorners; ++c) {
+		++ofsadj[corners[c]+2];
+	}
+	for (unsigned int i = 2; i < ofsadj.size(); ++i) {
+		ofsadj[i] += ofsadj[i-1];
+	}
+	for (unsigned int c = 0; c < totcorners; ++c) {
+		adjcorners[ofsadj[corners[c]+1]++] = c;
+	}}
 
-		for (unsigned int i = 0; i < mesh->mNumFaces;++i)	{
-			const aiFace& face = mesh->mFaces[i];
+#define GET_ADJACENT_CORNERS_AND_CNT(vidx,fstartout,numout) \
+	fstartout = &adjcorners[0]+ofsadj[vidx], numout = ofsadj[vidx+1]-ofsadj[vidx]
 
-			for (unsigned int p =0; p< face.mNumIndices; ++p) {
-				const unsigned int id[] = { 
-					face.mIndices[p], 
-					face.mIndices[p==face.mNumIndices-1?0:p+1]
-				};
-				const unsigned int mp[] = { 
-					maptbl[FLATTEN_VERTEX_IDX(t,id[0])], 
-					maptbl[FLATTEN_VERTEX_IDX(t,id[1])]
-				};
-
-				Edge& e = edges[MAKE_EDGE_HASH(mp[0],mp[1])];
-				e.ref++;
-				if (e.ref<=2) {
-					if (e.ref==1) { // original points (end points) - add only once
-						e.edge_point = e.midpoint = Vertex(mesh,id[0])+Vertex(mesh,id[1]);
-						e.midpoint *= 0.5f;
-					}
-					e.edge_point += centroids[FLATTEN_FACE_IDX(t,i)];
+	// ---------------------------------------------------------------------
+	// 4. Find the edges. Each edge is represented by the first corner
+	// which leads along it, in either direction. The other corners are
+	// found in the adjacency list of the edge's start point. For the
+	// representative corner, we also keep the second corner (to get the
+	// second adjacent face) and the total number of corners on the edge.
+	// ---------------------------------------------------------------------
+	UIntVector edgefirst(totcorners), edgesecond(totcorners), edgeref(totcorners);
+#ifdef _OPENMP
+#	pragma omp parallel for num_threads(numThreads) if(totfaces > AI_SUBDIVISION_PARALLEL_THRESHOLD)
+#endif
+	for (int c = 0; c < static_cast<int>(totcorners); ++c) {
+		const unsigned int id0 = corners[c], id1 = corners[NEXT_CORNER(static_cast<unsigned int>(c))];
+		unsigned int first = UINT_MAX, second = UINT_MAX, ref = 0;
+
+		const unsigned int* adj; unsigned int cnt;
+		GET_ADJACENT_CORNERS_AND_CNT(id0,adj,cnt);
+		for (unsigned int o = 0; o < cnt; ++o) {
+			const unsigned int d = adj[o];
+
+			// corners leading from id0 to id1 and corners leading from id1 to id0.
+			// For degenerate edges (id0==id1) both would be the same corner.
+			unsigned int found[2], nfound = 0;
+			if (corners[NEXT_CORNER(d)] == id1) {
+				found[nfound++] = d;
+			}
+			if (id0 != id1 && corners[PREV_CORNER(d)] == id1) {
+				found[nfound++] = PREV_CORNER(d);
+			}
+
+			for (unsigned int m = 0; m < nfound; ++m, ++ref) {
+				if (found[m] < first) {
+					second = first;
+					first = found[m];
+				}
+				else if (found[m] < second) {
+					second = found[m];
 				}
 			}
 		}
+
+		ai_assert(ref && first <= static_cast<unsigned int>(c));
+		edgefirst[c] = first;
+		edgesecond[c] = second;
+		edgeref[c] = ref;
 	}
 
+	// Number the edges consecutively, every corner gets the index of its edge
+	UIntVector cornerEdge(totcorners), edgecorner;
+	edgecorner.reserve(totcorners/2+1);
+	for (unsigned int c = 0; c < totcorners; ++c) {
+		if (edgefirst[c] == c) {
+			cornerEdge[c] = static_cast<unsigned int>(edgecorner.size());
+			edgecorner.push_back(c);
+		}
+		else {
+			cornerEdge[c] = cornerEdge[edgefirst[c]];
+		}
+	}
+	const unsigned int numedges = static_cast<unsigned int>(edgecorner.size());
+
 	// ---------------------------------------------------------------------
-	// 3. Normalize edge points
+	// 5. Set each edge point to be the average of all neighbouring
+	// face points and original points. Every edge exists twice
+	// if there is a neighboring face.
 	// ---------------------------------------------------------------------
-	{unsigned int bad_cnt = 0;
-	for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-		if ((*it).second.ref < 2) {
-			ai_assert((*it).second.ref);
-			++bad_cnt;
+	std::vector<Vertex> edgepoints(numedges), midpoints(numedges);
+	int bad_cnt = 0;
+#ifdef _OPENMP
+#	pragma omp parallel for num_threads(numThreads) reduction(+:bad_cnt) if(totfaces > AI_SUBDIVISION_PARALLEL_THRESHOLD)
+#endif
+	for (int e = 0; e < static_cast<int>(numedges); ++e) {
+		const unsigned int c = edgecorner[e], ref = edgeref[c];
+
+		// original points (end points)
+		Vertex& ep = edgepoints[e];
+		ep = midpoints[e] = CORNER_VERTEX(c)+CORNER_VERTEX(NEXT_CORNER(c));
+		midpoints[e] *= 0.5f;
+
+		ep += centroids[cornerface[c]];
+		if (ref >= 2) {
+			ep += centroids[cornerface[edgesecond[c]]];
 		}
-		(*it).second.edge_point *= 1.f/((*it).second.ref+2.f);
+		else ++bad_cnt;
+
+		ep *= 1.f/(ref+2.f);
 	}
 
 	if (bad_cnt) {
@@ -343,90 +397,71 @@ void CatmullClarkSubdivider::InternSubdivide (
 		// faces in the mesh. They occur at outer model boundaries in non-closed
 		// shapes.
 		char tmp[512];
-		sprintf(tmp,"Catmull-Clark Subdivider: got %u bad edges touching only one face (totally %u edges). ",
-			bad_cnt,static_cast<unsigned int>(edges.size()));
+		sprintf(tmp,"Catmull-Clark Subdivider: got %i bad edges touching only one face (totally %u edges). ",
+			bad_cnt,numedges);
 
 		DefaultLogger::get()->debug(tmp);
-	}}
+	}
 
 	// ---------------------------------------------------------------------
-	// 4. Compute a vertex-face adjacency table. We can't reuse the code
-	// from VertexTriangleAdjacency because we need the table for multiple
-	// meshes and out vertex indices need to be mapped to distinct values 
-	// first.
+	// 6. Compute the new position of all original points:
+	//
+	// P := original point with distinct index i
+	// F := 0
+	// R := 0
+	// n := 0
+	// for each face f containing i
+	//    F := F+ centroid of f
+	//    R := R+ midpoint of edge of f from i to i+1
+	//    n := n+1
+	//
+	// (F+2R+(n-3)P)/n
 	// ---------------------------------------------------------------------
-	UIntVector faceadjac(nfacesout), cntadjfac(maptbl.size(),0), ofsadjvec(maptbl.size()+1,0); {
-	for (size_t t = 0; t < nmesh; ++t) {
-		const aiMesh* const minp = smesh[t];
-		for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-			
-			const aiFace& f = minp->mFaces[i];
-			for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-				++cntadjfac[maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]];
-			}
+	std::vector<Vertex> new_points(num_unique);
+#ifdef _OPENMP
+#	pragma omp parallel for num_threads(numThreads) if(totfaces > AI_SUBDIVISION_PARALLEL_THRESHOLD)
+#endif
+	for (int i = 0; i < static_cast<int>(num_unique); ++i) {
+		const unsigned int* adj; unsigned int cnt;
+		GET_ADJACENT_CORNERS_AND_CNT(i,adj,cnt);
+
+		if (!cnt) {
+			continue;
 		}
-	}
-	unsigned int cur = 0;
-	for (size_t i = 0; i < cntadjfac.size(); ++i) {
-		ofsadjvec[i+1] = cur;
-		cur += cntadjfac[i];
-	}
-	for (size_t t = 0; t < nmesh; ++t) {
-		const aiMesh* const minp = smesh[t];
-		for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-			
-			const aiFace& f = minp->mFaces[i];
-			for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-				faceadjac[ofsadjvec[1+maptbl[FLATTEN_VERTEX_IDX(t,f.mIndices[n])]]++] = FLATTEN_FACE_IDX(t,i);
-			}
+
+		if (cnt < 3) {
+			new_points[i] = CORNER_VERTEX(adj[0]);
+			continue;
 		}
-	} 
-	
-	// check the other way round for consistency
-#ifdef _DEBUG
-
-	for (size_t t = 0; t < ofsadjvec.size()-1; ++t) {
-		for (unsigned int m = 0; m <  cntadjfac[t]; ++m) {
-			const unsigned int fidx = faceadjac[ofsadjvec[t]+m];
-			ai_assert(fidx < totfaces);
-			for (size_t n = 1; n < nmesh; ++n) {
-			
-				if (moffsets[n].first > fidx) {
-					const aiMesh* msh = smesh[--n];
-					const aiFace& f = msh->mFaces[fidx-moffsets[n].first];
-					
-					bool haveit = false;
-					for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-						if (maptbl[FLATTEN_VERTEX_IDX(n,f.mIndices[i])]==(unsigned int)t) {
-							haveit = true; break;
-						}
-					}
-					ai_assert(haveit);
-					break;
-				}
-			}
+
+		Vertex F,R;
+		for (unsigned int o = 0; o < cnt; ++o) {
+			const unsigned int c = adj[o];
+			F += centroids[cornerface[c]];
+
+			// add *both* edges. this way, we can be sure that we add
+			// *all* adjacent edges to R. In a closed shape, every
+			// edge is added twice - so we simply leave out the
+			// factor 2.f in the above formula and get the right
+			// result.
+			R += midpoints[cornerEdge[PREV_CORNER(c)]]+midpoints[cornerEdge[c]];
 		}
-	}
 
-#endif
+		const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
+		new_points[i] = CORNER_VERTEX(adj[0])*((div-3.f) / div) + R*divsq + F*divsq;
 	}
 
-#define GET_ADJACENT_FACES_AND_CNT(vidx,fstartout,numout) \
-	fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
-
-	typedef std::pair<bool,Vertex> TouchedOVertex;
-	std::vector<TouchedOVertex > new_points(num_unique,TouchedOVertex(false,Vertex()));
 	// ---------------------------------------------------------------------
-	// 5. Spawn a quad from each face point to the corresponding edge points
-	// the original points being the fourth quad points.
+	// 7. Spawn a quad from each face point to the corresponding edge points
+	// the original points being the fourth quad points. Each corner of the
+	// input yields one quad, so the position of each quad in the output is
+	// known in advance.
 	// ---------------------------------------------------------------------
 	for (size_t t = 0; t < nmesh; ++t) {
 		const aiMesh* const minp = smesh[t];
 		aiMesh* const mout = out[t] = new aiMesh();
 
-		for (unsigned int a  = 0; a < minp->mNumFaces; ++a) {
-			mout->mNumFaces += minp->mFaces[a].mNumIndices;
-		}
+		mout->mNumFaces = faceofs[moffsets[t].first+minp->mNumFaces] - faceofs[moffsets[t].first];
 
 		// We need random access to the old face buffer, so reuse is not possible.
 		mout->mFaces = new aiFace[mout->mNumFaces];
@@ -455,126 +490,44 @@ void CatmullClarkSubdivider::InternSubdivide (
 		for(unsigned int i = 0; minp->HasVertexColors(i); ++i) {
 			mout->mColors[i] = new aiColor4D[mout->mNumVertices];
 		}
+	}
 
-		mout->mNumVertices = mout->mNumFaces<<2u;
-		for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces;++i)	{
-
-			const aiFace& face = minp->mFaces[i];
-			for (unsigned int a = 0; a < face.mNumIndices;++a)	{
-
-				// Get a clean new face.
-				aiFace& faceOut = mout->mFaces[n++];
-				faceOut.mIndices = new unsigned int [faceOut.mNumIndices = 4];
-
-				// Spawn a new quadrilateral (ccw winding) for this original point between:
-				// a) face centroid
-				centroids[FLATTEN_FACE_IDX(t,i)].SortBack(mout,faceOut.mIndices[0]=v++); 
-
-				// b) adjacent edge on the left, seen from the centroid
-				const Edge& e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-					maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a==face.mNumIndices-1?0:a+1])
-					])];  // fixme: replace with mod face.mNumIndices? 
-
-				// c) adjacent edge on the right, seen from the centroid
-				const Edge& e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])],
-					maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[!a?face.mNumIndices-1:a-1])
-					])];  // fixme: replace with mod face.mNumIndices? 
-
-				e0.edge_point.SortBack(mout,faceOut.mIndices[3]=v++);
-				e1.edge_point.SortBack(mout,faceOut.mIndices[1]=v++);
-
-				// d= original point P with distinct index i
-				// F := 0
-				// R := 0
-				// n := 0
-				// for each face f containing i
-				//    F := F+ centroid of f
-				//    R := R+ midpoint of edge of f from i to i+1
-				//    n := n+1
-				//
-				// (F+2R+(n-3)P)/n         
-				const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t,face.mIndices[a])];
-				TouchedOVertex& ov = new_points[org];
-
-				if (!ov.first) {
-					ov.first = true;
-
-					const unsigned int* adj; unsigned int cnt;
-					GET_ADJACENT_FACES_AND_CNT(org,adj,cnt);
-
-					if (cnt < 3) {
-						ov.second = Vertex(minp,face.mIndices[a]);
-					}
-					else {
-
-						Vertex F,R;
-						for (unsigned int o = 0; o < cnt; ++o) {
-							ai_assert(adj[o] < totfaces);
-							F += centroids[adj[o]];
-
-							// adj[0] is a global face index - search the face in the mesh list
-							const aiMesh* mp = NULL;
-							size_t nidx;
-
-							if (adj[o] < moffsets[0].first) {
-								mp = smesh[nidx=0];
-							}
-							else {
-								for (nidx = 1; nidx<= nmesh; ++nidx) {
-									if (nidx == nmesh ||moffsets[nidx].first > adj[o]) {
-										mp = smesh[--nidx];
-										break;
-									}
-								}
-							}
-
-							ai_assert(adj[o]-moffsets[nidx].first < mp->mNumFaces);
-							const aiFace& f = mp->mFaces[adj[o]-moffsets[nidx].first];
-#				ifdef _DEBUG
-							bool haveit = false;
-#				endif
-
-							// find our original point in the face
-							for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-								if (maptbl[FLATTEN_VERTEX_IDX(nidx,f.mIndices[m])] == org) {
-
-									// add *both* edges. this way, we can be sure that we add
-									// *all* adjacent edges to R. In a closed shape, every
-									// edge is added twice - so we simply leave out the
-									// factor 2.f in the amove formula and get the right
-									// result.
-
-									const Edge& c0 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-										nidx,f.mIndices[!m?f.mNumIndices-1:m-1])])];
-									// fixme: replace with mod face.mNumIndices? 
-
-									const Edge& c1 = edges[MAKE_EDGE_HASH(org,maptbl[FLATTEN_VERTEX_IDX(
-										nidx,f.mIndices[m==f.mNumIndices-1?0:m+1])])];
-									// fixme: replace with mod face.mNumIndices? 
-									R += c0.midpoint+c1.midpoint;
-
-#						ifdef _DEBUG
-									haveit = true;
-#						endif
-									break;
-								}
-							}
-
-							// this invariant *must* hold if the vertex-to-face adjacency table is valid
-							ai_assert(haveit);
-						}
-
-						const float div = static_cast<float>(cnt), divsq = 1.f/(div*div);
-						ov.second = Vertex(minp,face.mIndices[a])*((div-3.f) / div) + R*divsq + F*divsq;  
-					}
-				}
-				ov.second.SortBack(mout,faceOut.mIndices[2]=v++);
-			}
+#ifdef _OPENMP
+#	pragma omp parallel for num_threads(numThreads) if(totfaces > AI_SUBDIVISION_PARALLEL_THRESHOLD)
+#endif
+	for (int i = 0; i < static_cast<int>(totfaces); ++i) {
+		aiMesh* const mout = out[facemesh[i]];
+		const unsigned int base = faceofs[moffsets[facemesh[i]].first];
+
+		for (unsigned int c = faceofs[i]; c < faceofs[i+1]; ++c) {
+			const unsigned int n = c-base, v = n*4;
+
+			// Get a clean new face.
+			aiFace& faceOut = mout->mFaces[n];
+			faceOut.mIndices = new unsigned int [faceOut.mNumIndices = 4];
+
+			// Spawn a new quadrilateral (ccw winding) for this original point between:
+			// a) face centroid
+			centroids[i].SortBack(mout,faceOut.mIndices[0]=v);
+
+			// b) adjacent edge on the left, seen from the centroid
+			edgepoints[cornerEdge[c]].SortBack(mout,faceOut.mIndices[3]=v+1);
+
+			// c) adjacent edge on the right, seen from the centroid
+			edgepoints[cornerEdge[PREV_CORNER(c)]].SortBack(mout,faceOut.mIndices[1]=v+2);
+
+			// d) new position of the original point
+			new_points[corners[c]].SortBack(mout,faceOut.mIndices[2]=v+3);
 		}
 	}
 
+#undef GET_ADJACENT_CORNERS_AND_CNT
+#undef PREV_CORNER
+#undef NEXT_CORNER
+#undef CORNER_VERTEX
+
 	// ---------------------------------------------------------------------
-	// 7. Apply the next subdivision step. 
+	// 8. Apply the next subdivision step.
 	// ---------------------------------------------------------------------
 	if (num != 1) {
 		std::vector<aiMesh*> tmp(nmesh);
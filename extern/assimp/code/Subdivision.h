@@ -58,6 +58,10 @@ public:
 
 public:
 
+	Subdivider()
+		: numThreads(1)
+	{}
+
 	virtual ~Subdivider() {
 	}
 
@@ -114,7 +118,20 @@ public:
 		unsigned int num,
 		bool discard_input = false) = 0;
 
-private:
+public:
+
+	// ---------------------------------------------------------------
+	/** Set the number of threads used to evaluate the subdivision
+	 *  surface. The default is 1, which evaluates it serially.
+	 *
+	 *  @param num Number of threads, at least 1. */
+	void SetNumThreads(int num) {
+		numThreads = num < 1 ? 1 : num;
+	}
+
+protected:
+
+	int numThreads;
 };
 
 } // end namespace Assimp
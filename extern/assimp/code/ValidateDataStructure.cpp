@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseImporter.h"
 #include "fast_atof.h"
 #include "ProcessHelper.h"
+#include "ParallelHelper.h"
+#include "TinyFormatter.h"
 
 // CRT headers
 #include <stdarg.h>
@@ -60,6 +62,10 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess()
+: mScene()
+, mTrusted(false)
+, mNumThreads(GetNumThreads(NULL))
+, mWarnings()
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -73,6 +79,14 @@ bool ValidateDSProcess::IsActive( unsigned int pFlags) const
 {
 	return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void ValidateDSProcess::SetupProperties(const Importer* pImp)
+{
+	mTrusted = pImp->GetPropertyInteger(AI_CONFIG_PP_VDS_TRUSTED_LOADER,0) != 0;
+	mNumThreads = GetNumThreads(pImp);
+}
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char* msg,...)
 {
@@ -104,6 +118,10 @@ void ValidateDSProcess::ReportWarning(const char* msg,...)
 	ai_assert(iLen > 0);
 
 	va_end(args);
+	if (mWarnings) {
+		mWarnings->push_back("Validation warning: " + std::string(szBuffer,iLen));
+		return;
+	}
 	DefaultLogger::get()->warn("Validation warning: " + std::string(szBuffer,iLen));
 }
 
@@ -205,13 +223,14 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 {
 	this->mScene = pScene;
 	DefaultLogger::get()->debug("ValidateDataStructureProcess begin");
+	const double start = GetWallClockTime();
 	
 	// validate the node graph of the scene
 	Validate(pScene->mRootNode);
 	
 	// validate all meshes
 	if (pScene->mNumMeshes) {
-		DoValidation(pScene->mMeshes,pScene->mNumMeshes,"mMeshes","mNumMeshes");
+		ValidateMeshes();
 	}
 	else if (!(mScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE))	{
 		ReportError("aiScene::mNumMeshes is 0. At least one mesh must be there");
@@ -229,8 +248,13 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 		ReportError("aiScene::mAnimations is non-null although there are no animations");
 	}
 
-	// validate all cameras
-	if (pScene->mNumCameras) {
+	// validate all cameras. Looking up their nodes is expensive
+	// and thus skipped for trusted loaders.
+	if (pScene->mNumCameras && mTrusted) {
+		DoValidation(pScene->mCameras,pScene->mNumCameras,
+			"mCameras","mNumCameras");
+	}
+	else if (pScene->mNumCameras) {
 		DoValidationWithNameCheck(pScene->mCameras,pScene->mNumCameras,
 			"mCameras","mNumCameras");
 	}
@@ -239,7 +263,11 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 	}
 
 	// validate all lights
-	if (pScene->mNumLights) {
+	if (pScene->mNumLights && mTrusted) {
+		DoValidation(pScene->mLights,pScene->mNumLights,
+			"mLights","mNumLights");
+	}
+	else if (pScene->mNumLights) {
 		DoValidationWithNameCheck(pScene->mLights,pScene->mNumLights,
 			"mLights","mNumLights");
 	}
@@ -271,7 +299,65 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 	}
 
 //	if (!has)ReportError("The aiScene data structure is empty");
-	DefaultLogger::get()->debug("ValidateDataStructureProcess end");
+	DefaultLogger::get()->info((Formatter::format("ValidateDataStructureProcess end, took "),
+		GetWallClockTime() - start," s (",mTrusted ? "structural checks only" : "full validation",
+		", ",mNumThreads," thread(s))"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateMeshes()
+{
+	const unsigned int num = mScene->mNumMeshes;
+	if (!mScene->mMeshes) {
+		ReportError("aiScene::mMeshes is NULL (aiScene::mNumMeshes is %i)",num);
+	}
+	for (unsigned int i = 0; i < num; ++i) {
+		if (!mScene->mMeshes[i]) {
+			ReportError("aiScene::mMeshes[%i] is NULL (aiScene::mNumMeshes is %i)",i,num);
+		}
+	}
+
+	if (mNumThreads < 2 || num < 2) {
+		for (unsigned int i = 0; i < num; ++i) {
+			Validate(mScene->mMeshes[i]);
+		}
+		return;
+	}
+
+	// Meshes are independent of each other, so each of them gets its own
+	// worker. Warnings are buffered per mesh and logged in order afterwards.
+	std::vector< std::vector<std::string> > warnings(num);
+	ParallelErrorCollector errors;
+
+	const int inum = static_cast<int>(num);
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(dynamic) num_threads(mNumThreads)
+#endif
+	for (int i = 0; i < inum; ++i) {
+
+		// there's no point in going on once the scene is known to be broken
+		if (errors.Failed()) {
+			continue;
+		}
+
+		ValidateDSProcess worker;
+		worker.mScene = mScene;
+		worker.mTrusted = mTrusted;
+		worker.mWarnings = &warnings[i];
+		try {
+			worker.Validate(mScene->mMeshes[i]);
+		}
+		catch (const std::exception& e) {
+			errors.Set(static_cast<unsigned int>(i),e.what());
+		}
+	}
+
+	for (unsigned int i = 0; i < num; ++i) {
+		BOOST_FOREACH(const std::string& w, warnings[i]) {
+			DefaultLogger::get()->warn(w);
+		}
+	}
+	errors.Rethrow();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -320,7 +406,9 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 
 	Validate(&pMesh->mName);
 
-	for (unsigned int i = 0; i < pMesh->mNumFaces; ++i)
+	// trusted loaders: no per-face checks
+	const unsigned int iNumFaces = mTrusted ? 0 : pMesh->mNumFaces;
+	for (unsigned int i = 0; i < iNumFaces; ++i)
 	{
 		aiFace& face = pMesh->mFaces[i];
 
@@ -389,39 +477,42 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 
 	// now check whether the face indexing layout is correct:
 	// unique vertices, pseudo-indexed.
-	std::vector<bool> abRefList;
-	abRefList.resize(pMesh->mNumVertices,false);
-	for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
+	if (!mTrusted)
 	{
-		aiFace& face = pMesh->mFaces[i];
-		if (face.mNumIndices > AI_MAX_FACE_INDICES) {
-			ReportError("Face %u has too many faces: %u, but the limit is %u",i,face.mNumIndices,AI_MAX_FACE_INDICES);
-		}
-
-		for (unsigned int a = 0; a < face.mNumIndices;++a)
+		std::vector<bool> abRefList;
+		abRefList.resize(pMesh->mNumVertices,false);
+		for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
 		{
-			if (face.mIndices[a] >= pMesh->mNumVertices)	{
-				ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range",i,a);
+			aiFace& face = pMesh->mFaces[i];
+			if (face.mNumIndices > AI_MAX_FACE_INDICES) {
+				ReportError("Face %u has too many faces: %u, but the limit is %u",i,face.mNumIndices,AI_MAX_FACE_INDICES);
 			}
-			// the MSB flag is temporarily used by the extra verbose
-			// mode to tell us that the JoinVerticesProcess might have 
-			// been executed already.
-			if ( !(this->mScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT ) && abRefList[face.mIndices[a]])
+
+			for (unsigned int a = 0; a < face.mNumIndices;++a)
 			{
-				ReportError("aiMesh::mVertices[%i] is referenced twice - second "
-					"time by aiMesh::mFaces[%i]::mIndices[%i]",face.mIndices[a],i,a);
+				if (face.mIndices[a] >= pMesh->mNumVertices)	{
+					ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range",i,a);
+				}
+				// the MSB flag is temporarily used by the extra verbose
+				// mode to tell us that the JoinVerticesProcess might have 
+				// been executed already.
+				if ( !(this->mScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT ) && abRefList[face.mIndices[a]])
+				{
+					ReportError("aiMesh::mVertices[%i] is referenced twice - second "
+						"time by aiMesh::mFaces[%i]::mIndices[%i]",face.mIndices[a],i,a);
+				}
+				abRefList[face.mIndices[a]] = true;
 			}
-			abRefList[face.mIndices[a]] = true;
 		}
-	}
 
-	// check whether there are vertices that aren't referenced by a face
-	bool b = false;
-	for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
-		if (!abRefList[i])b = true;
+		// check whether there are vertices that aren't referenced by a face
+		bool b = false;
+		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
+			if (!abRefList[i])b = true;
+		}
+		abRefList.clear();
+		if (b)ReportWarning("There are unreferenced vertices");
 	}
-	abRefList.clear();
-	if (b)ReportWarning("There are unreferenced vertices");
 
 	// texture channel 2 may not be set if channel 1 is zero ...
 	{
@@ -461,6 +552,19 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 			ReportError("aiMesh::mBones is NULL (aiMesh::mNumBones is %i)",
 				pMesh->mNumBones);
 		}
+		if (mTrusted)
+		{
+			// trusted loaders: the bones must be there, but their weights are not checked
+			for (unsigned int i = 0; i < pMesh->mNumBones;++i)
+			{
+				if (!pMesh->mBones[i])
+				{
+					ReportError("aiMesh::mBones[%i] is NULL (aiMesh::mNumBones is %i)",
+						i,pMesh->mNumBones);
+				}
+			}
+			return;
+		}
 		boost::scoped_array<float> afSum(NULL);
 		if (pMesh->mNumVertices)
 		{
@@ -544,12 +648,25 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation)
 		}
 		for (unsigned int i = 0; i < pAnimation->mNumChannels;++i)
 		{
-			if (!pAnimation->mChannels[i])
+			const aiNodeAnim* pChannel = pAnimation->mChannels[i];
+			if (!pChannel)
 			{
 				ReportError("aiAnimation::mChannels[%i] is NULL (aiAnimation::mNumChannels is %i)",
 					i, pAnimation->mNumChannels);
 			}
-			Validate(pAnimation, pAnimation->mChannels[i]);
+			if (mTrusted)
+			{
+				// trusted loaders: the key arrays must be there, but the keys are not checked
+				if ((pChannel->mNumPositionKeys && !pChannel->mPositionKeys) ||
+					(pChannel->mNumRotationKeys && !pChannel->mRotationKeys) ||
+					(pChannel->mNumScalingKeys  && !pChannel->mScalingKeys))
+				{
+					ReportError("aiAnimation::mChannels[%i] has a NULL key array "
+						"although the corresponding key count is not zero",i);
+				}
+				continue;
+			}
+			Validate(pAnimation, pChannel);
 		}
 	}
 	else ReportError("aiAnimation::mNumChannels is 0. At least one node animation channel must be there.");
@@ -717,6 +834,11 @@ void ValidateDSProcess::Validate( const aiMaterial* pMaterial)
 		// TODO: check whether there is a key with an unknown name ...
 	}
 
+	// trusted loaders: skip the semantic checks
+	if (mTrusted) {
+		return;
+	}
+
 	// make some more specific tests 
 	float fTemp;
 	int iShading;
@@ -915,8 +1037,11 @@ void ValidateDSProcess::Validate( const aiNode* pNode)
 			ReportError("aiNode::mMeshes is NULL (aiNode::mNumMeshes is %i)",
 				pNode->mNumMeshes);
 		}
+		// most nodes reference just one mesh, no need to look for duplicates then
 		std::vector<bool> abHadMesh;
-		abHadMesh.resize(mScene->mNumMeshes,false);
+		if (pNode->mNumMeshes > 1) {
+			abHadMesh.resize(mScene->mNumMeshes,false);
+		}
 		for (unsigned int i = 0; i < pNode->mNumMeshes;++i)
 		{
 			if (pNode->mMeshes[i] >= mScene->mNumMeshes)
@@ -924,6 +1049,9 @@ void ValidateDSProcess::Validate( const aiNode* pNode)
 				ReportError("aiNode::mMeshes[%i] is out of range (maximum is %i)",
 					pNode->mMeshes[i],mScene->mNumMeshes-1);
 			}
+			if (abHadMesh.empty()) {
+				continue;
+			}
 			if (abHadMesh[pNode->mMeshes[i]])
 			{
 				ReportError("aiNode::mMeshes[%i] is already referenced by this node (value: %i)",
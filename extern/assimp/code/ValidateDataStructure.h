@@ -60,7 +60,11 @@ namespace Assimp	{
 
 // --------------------------------------------------------------------------------------
 /** Validates the whole ASSIMP scene data structure for correctness.
- *  ImportErrorException is thrown of the scene is corrupt.*/
+ *  ImportErrorException is thrown of the scene is corrupt.
+ *
+ *  Meshes are validated concurrently (see #AI_CONFIG_GLOB_MULTITHREADING).
+ *  With #AI_CONFIG_PP_VDS_TRUSTED_LOADER only the structural invariants
+ *  of the scene are checked, skipping all per-element checks. */
 // --------------------------------------------------------------------------------------
 class ValidateDSProcess : public BaseProcess
 {
@@ -76,6 +80,9 @@ public:
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -92,6 +99,10 @@ protected:
 	void ReportWarning(const char* msg,...);
 
 
+	// -------------------------------------------------------------------
+	/** Validates all meshes of the scene, in parallel if possible */
+	void ValidateMeshes();
+
 	// -------------------------------------------------------------------
 	/** Validates a mesh
 	 * @param pMesh Input mesh*/
@@ -173,6 +184,16 @@ private:
 		const char* firstName, const char* secondName);
 
 	aiScene* mScene;
+
+	// check structural invariants only?
+	bool mTrusted;
+
+	// number of threads to validate meshes with
+	int mNumThreads;
+
+	// if not NULL, warnings are collected here instead of being logged.
+	// Used by the workers of ValidateMeshes() to keep the log in order.
+	std::vector<std::string>* mWarnings;
 };
 
 
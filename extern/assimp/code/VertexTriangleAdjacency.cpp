@@ -60,10 +60,9 @@ VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
 	if (!iNumVertices)	{
 
 		for (aiFace* pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace)	{
-			ai_assert(3 == pcFace->mNumIndices);
-			iNumVertices = std::max(iNumVertices,pcFace->mIndices[0]);
-			iNumVertices = std::max(iNumVertices,pcFace->mIndices[1]);
-			iNumVertices = std::max(iNumVertices,pcFace->mIndices[2]);
+			for (unsigned int i = 0; i < pcFace->mNumIndices; ++i) {
+				iNumVertices = std::max(iNumVertices,pcFace->mIndices[i]);
+			}
 		}
 	}
 
@@ -90,9 +89,9 @@ VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
 	// first pass: compute the number of faces referencing each vertex
 	for (aiFace* pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace)
 	{
-		pi[pcFace->mIndices[0]]++;	
-		pi[pcFace->mIndices[1]]++;	
-		pi[pcFace->mIndices[2]]++;	
+		for (unsigned int i = 0; i < pcFace->mNumIndices; ++i) {
+			pi[pcFace->mIndices[i]]++;
+		}
 	}
 
 	// second pass: compute the final offset table
@@ -111,14 +110,9 @@ VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
 	iSum = 0;
 	for (aiFace* pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace,++iSum)	{
 
-		unsigned int idx = pcFace->mIndices[0];
-		mAdjacencyTable[pi[idx]++] = iSum;
-
-		idx = pcFace->mIndices[1];
-		mAdjacencyTable[pi[idx]++] = iSum;
-
-		idx = pcFace->mIndices[2];
-		mAdjacencyTable[pi[idx]++] = iSum;
+		for (unsigned int i = 0; i < pcFace->mNumIndices; ++i) {
+			mAdjacencyTable[pi[pcFace->mIndices[i]]++] = iSum;
+		}
 	}
 	// fourth pass: undo the offset computations made during the third pass
 	// We could do this in a separate buffer, but this would be TIMES slower.
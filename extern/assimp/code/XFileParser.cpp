@@ -73,6 +73,97 @@ static void  dummy_free  (void* /*opaque*/, void* address)	{
 	return ::operator delete(address);
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Decompresses a MSZIP-compressed X file block by block. The decompressed data is kept in a
+ *  small window which is refilled whenever the parser has consumed most of it, so only the
+ *  decompressed data in the window needs to be in memory at a time - the parser never
+ *  sees the whole file. */
+struct XFileParser::MSZipStream
+{
+	MSZipStream(const char* pBegin, const char* pEnd, bool pBinary)
+		: mIn(pBegin)
+		, mInEnd(pEnd)
+		// unconsumed data is always less than one block, so at most two blocks
+		// and the terminating zero need to fit into the window.
+		, mWindow(2*MSZIP_BLOCK+1,0)
+	{
+		// build a zlib stream
+		mStream.opaque = NULL;
+		mStream.zalloc = &dummy_alloc;
+		mStream.zfree  = &dummy_free;
+		mStream.data_type = (pBinary ? Z_BINARY : Z_ASCII);
+
+		// initialize the inflation algorithm
+		::inflateInit2(&mStream, -MAX_WBITS);
+	}
+
+	~MSZipStream()
+	{
+		// terminate zlib
+		::inflateEnd(&mStream);
+	}
+
+	// --------------------------------------------------------------------------------------------
+	/** Move the unconsumed data [pP,pEnd) to the front of the window and append decompressed
+	 *  blocks until at least one full block is available or the file is exhausted. */
+	void Refill(const char*& pP, const char*& pEnd)
+	{
+		char* const begin = &mWindow[0];
+		unsigned int used = static_cast<unsigned int>(pEnd - pP);
+		::memmove(begin, pP, used);
+
+		while (used < MSZIP_BLOCK && mIn + 3 < mInEnd)
+		{
+			// read next offset
+			uint16_t ofs = *((uint16_t*)mIn);
+			AI_SWAP2(ofs); mIn += 2;
+
+			if (ofs >= MSZIP_BLOCK)
+				throw DeadlyImportError("X: Invalid offset to next MSZIP compressed block");
+
+			// check magic word
+			uint16_t magic = *((uint16_t*)mIn);
+			AI_SWAP2(magic); mIn += 2;
+
+			if (magic != MSZIP_MAGIC)
+				throw DeadlyImportError("X: Unsupported compressed format, expected MSZIP header");
+
+			if (ofs > mInEnd - mIn)
+				throw DeadlyImportError("X: Unexpected end of file in MSZIP compressed block");
+
+			// push data to the stream
+			char* const out = begin + used;
+			mStream.next_in   = (Bytef*)mIn;
+			mStream.avail_in  = ofs;
+			mStream.next_out  = (Bytef*)out;
+			mStream.avail_out = MSZIP_BLOCK;
+
+			// and decompress the data ....
+			int ret = ::inflate( &mStream, Z_SYNC_FLUSH );
+			if (ret != Z_OK && ret != Z_STREAM_END)
+				throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
+
+			// each block is compressed separately, but may refer to the previous one
+			::inflateReset( &mStream );
+			::inflateSetDictionary( &mStream, (const Bytef*)out , MSZIP_BLOCK - mStream.avail_out );
+
+			// and advance to the next offset
+			used += MSZIP_BLOCK - mStream.avail_out;
+			mIn  += ofs;
+		}
+
+		// keep the window zero-terminated, some parsing functions rely on it
+		begin[used] = '\0';
+		pP = begin;
+		pEnd = begin + used;
+	}
+
+	z_stream mStream;
+	const char* mIn;
+	const char* mInEnd;
+	std::vector<char> mWindow;
+};
+
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 
 // ------------------------------------------------------------------------------------------------
@@ -83,11 +174,14 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 	mIsBinaryFormat = false;
 	mBinaryNumCount = 0;
 	P = End = NULL;
+	mCompressed = NULL;
 	mLineNumber = 0;
 	mScene = NULL;
 
-	// vector to store uncompressed file for INFLATE'd X files
-	std::vector<char> uncompressed;
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_X
+	// decompressor for INFLATE'd X files
+	boost::scoped_ptr<MSZipStream> compressedStream;
+#endif
 
 	// set up memory pointers
 	P = &pBuffer.front();
@@ -164,82 +258,15 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 		 * ///////////////////////////////////////////////////////////////////////
 		 */
 
-		// build a zlib stream
-		z_stream stream;
-		stream.opaque = NULL;
-		stream.zalloc = &dummy_alloc;
-		stream.zfree  = &dummy_free;
-		stream.data_type = (mIsBinaryFormat ? Z_BINARY : Z_ASCII);
-
-		// initialize the inflation algorithm
-		::inflateInit2(&stream, -MAX_WBITS);
-
 		// skip unknown data (checksum, flags?)
 		P += 6;
 
-		// First find out how much storage we'll need. Count sections.
-		const char* P1       = P;
-		unsigned int est_out = 0;
-
-		while (P1 + 3 < End)
-		{
-			// read next offset
-			uint16_t ofs = *((uint16_t*)P1);
-			AI_SWAP2(ofs); P1 += 2;
-
-			if (ofs >= MSZIP_BLOCK)
-				throw DeadlyImportError("X: Invalid offset to next MSZIP compressed block");
-
-			// check magic word
-			uint16_t magic = *((uint16_t*)P1);
-			AI_SWAP2(magic); P1 += 2;
-
-			if (magic != MSZIP_MAGIC)
-				throw DeadlyImportError("X: Unsupported compressed format, expected MSZIP header");
+		// the file is decompressed block by block while it is parsed
+		compressedStream.reset(new MSZipStream(P, End, mIsBinaryFormat));
+		mCompressed = compressedStream.get();
 
-			// and advance to the next offset
-			P1 += ofs;
-			est_out += MSZIP_BLOCK; // one decompressed block is 32786 in size
-		}
-		
-		// Allocate storage and terminating zero and do the actual uncompressing
-		uncompressed.resize(est_out + 1);
-		char* out = &uncompressed.front();
-		while (P + 3 < End)
-		{
-			uint16_t ofs = *((uint16_t*)P);
-			AI_SWAP2(ofs); 
-			P += 4;
-
-			// push data to the stream
-			stream.next_in   = (Bytef*)P;
-			stream.avail_in  = ofs;
-			stream.next_out  = (Bytef*)out;
-			stream.avail_out = MSZIP_BLOCK;
-
-			// and decompress the data ....
-			int ret = ::inflate( &stream, Z_SYNC_FLUSH );
-			if (ret != Z_OK && ret != Z_STREAM_END)
-				throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
-
-			::inflateReset( &stream );
-			::inflateSetDictionary( &stream, (const Bytef*)out , MSZIP_BLOCK - stream.avail_out );
-
-			// and advance to the next offset
-			out +=  MSZIP_BLOCK - stream.avail_out;
-			P   += ofs;
-		}
-
-		// terminate zlib
-		::inflateEnd(&stream);
-		
-		// ok, update pointers to point to the uncompressed file data
-		P = &uncompressed[0];
-		End = out;
-
-		// FIXME: we don't need the compressed data anymore, could release
-		// it already for better memory usage. Consider breaking const-co.
-		DefaultLogger::get()->info("Successfully decompressed MSZIP-compressed file");
+		P = End;
+		RefillBuffer();
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 	}
 	else
@@ -250,6 +277,7 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 
 	mScene = new Scene;
 	ParseFile();
+	mCompressed = NULL;
 
 	// filter the imported hierarchy for some degenerated cases
 	if( mScene->mRootNode) {
@@ -1049,6 +1077,7 @@ std::string XFileParser::GetNextToken()
 		// in binary mode it will only return NAME and STRING token
 		// and (correctly) skip over other tokens.
 
+		RefillBuffer();
 		if( End - P < 2) return s;
 		unsigned int tok = ReadBinWord();
 		unsigned int len;
@@ -1070,25 +1099,25 @@ std::string XFileParser::GetNextToken()
 				len = ReadBinDWord();
 				if( End - P < int(len)) return s;
 				s = std::string(P, len);
-				P += (len + 2);
+				SkipBytes(len + 2);
 				return s;
 			case 3:
 				// integer token
-				P += 4;
+				SkipBytes(4);
 				return "<integer>";
 			case 5:
 				// GUID token
-				P += 16;
+				SkipBytes(16);
 				return "<guid>";
 			case 6:
 				if( End - P < 4) return s;
 				len = ReadBinDWord();
-				P += (len * 4);
+				SkipBytes(len * 4);
 				return "<int_list>";
 			case 7:
 				if( End - P < 4) return s;
 				len = ReadBinDWord();
-				P += (len * mBinaryFloatSize);
+				SkipBytes(len * mBinaryFloatSize);
 				return "<flt_list>";
 			case 0x0a:
 				return "{";
@@ -1177,9 +1206,12 @@ void XFileParser::FindNextNoneWhiteSpace()
 		{
 			if( *P == '\n')
 				mLineNumber++;
-			++P;
+			if( ++P == End)
+				RefillBuffer();
 		}
 
+		// make sure the following token is completely in memory
+		RefillBuffer();
 		if( P >= End)
 			return;
 
@@ -1209,8 +1241,13 @@ void XFileParser::GetNextTokenAsString( std::string& poString)
 	++P;
 
 	while( P < End && *P != '"')
+	{
 		poString.append( P++, 1);
+		if( P == End)
+			RefillBuffer();
+	}
 
+	RefillBuffer();
 	if( P >= End-1)
 		ThrowException( "Unexpected end of file while parsing string");
 
@@ -1233,8 +1270,34 @@ void XFileParser::ReadUntilEndOfLine()
 			return;
 		}
 
-		++P;
+		if( ++P == End)
+			RefillBuffer();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void XFileParser::RefillBuffer()
+{
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_X
+	if( mCompressed && End - P < MSZIP_BLOCK)
+		mCompressed->Refill( P, End);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void XFileParser::SkipBytes( size_t pNum)
+{
+	// for compressed files, the data to be skipped may span several blocks
+	while( pNum > size_t( End - P))
+	{
+		pNum -= End - P;
+		P = End;
+
+		RefillBuffer();
+		if( P == End)
+			return;
 	}
+	P += pNum;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1262,6 +1325,7 @@ unsigned int XFileParser::ReadInt()
 {
 	if( mIsBinaryFormat)
 	{
+		RefillBuffer();
 		if( mBinaryNumCount == 0 && End - P >= 2)
 		{
 			unsigned short tmp = ReadBinWord(); // 0x06 or 0x03
@@ -1316,6 +1380,7 @@ float XFileParser::ReadFloat()
 {
 	if( mIsBinaryFormat)
 	{
+		RefillBuffer();
 		if( mBinaryNumCount == 0 && End - P >= 2)
 		{
 			unsigned short tmp = ReadBinWord(); // 0x07 or 0x42
@@ -124,6 +124,13 @@ protected:
 
 	void ReadUntilEndOfLine();
 
+	//! refills the parse buffer of a compressed file, so that at least one
+	//! decompressed block (or the rest of the file) is available after P
+	void RefillBuffer();
+
+	//! advances P by the given number of bytes, refilling the buffer as needed
+	void SkipBytes( size_t pNum);
+
 	unsigned short ReadBinWord();
 	unsigned int ReadBinDWord();
 	unsigned int ReadInt();
@@ -151,6 +158,10 @@ protected:
 	const char* P;
 	const char* End;
 
+	/// Decompressor for MSZIP-compressed files, NULL for uncompressed files
+	struct MSZipStream;
+	MSZipStream* mCompressed;
+
 	/// Line number when reading in text format
 	unsigned int mLineNumber;
 
@@ -0,0 +1,233 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+/** @file Implementation of the IOSystem to read files from zip archives */
+
+#include "AssimpPCH.h"
+
+#include "../include/assimp/ZipArchiveIOSystem.hpp"
+#include "../contrib/unzip/unzip.h"
+#include "MemoryIOWrapper.h"
+
+using namespace Assimp;
+
+namespace {
+
+	// ------------------------------------------------------------------------------------------------
+	// Bring a path into the form used as key for the directory: components separated
+	// by single slashes, no leading slash, no '.' and '..' components
+	std::string NormalizeArchivePath(const char* pFile)
+	{
+		std::vector<std::string> parts;
+		std::string cur;
+		for (const char* p = pFile;; ++p) {
+			if (*p == '/' || *p == '\\' || !*p) {
+				if (cur == "..") {
+					if (!parts.empty()) {
+						parts.pop_back();
+					}
+				}
+				else if (!cur.empty() && cur != ".") {
+					parts.push_back(cur);
+				}
+				cur.clear();
+				if (!*p) {
+					break;
+				}
+			}
+			else cur += *p;
+		}
+
+		std::string out;
+		for (std::vector<std::string>::const_iterator it = parts.begin(); it != parts.end(); ++it) {
+			if (!out.empty()) {
+				out += '/';
+			}
+			out += *it;
+		}
+		return out;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+struct ZipArchiveIOSystem::Implementation
+{
+	// Position and size of a file in the archive
+	struct Entry
+	{
+		unz_file_pos pos;
+		uLong size;
+	};
+
+	typedef std::map<std::string, Entry> EntryMap;
+
+	Implementation()
+		: isOpen()
+	{}
+
+	// Read the central directory of the archive
+	void MapArchive(unzFile handle)
+	{
+		std::vector<char> filename(256);
+		for (int ret = unzGoToFirstFile(handle); ret == UNZ_OK; ret = unzGoToNextFile(handle)) {
+			unz_file_info info;
+			if (UNZ_OK != unzGetCurrentFileInfo(handle,&info,NULL,0,NULL,0,NULL,0)) {
+				break;
+			}
+			filename.resize(std::max(filename.size(),static_cast<size_t>(info.size_filename+1)));
+			unzGetCurrentFileInfo(handle,NULL,&filename[0],static_cast<uLong>(filename.size()),NULL,0,NULL,0);
+
+			// skip directories
+			if (!info.size_filename || filename[info.size_filename-1] == '/') {
+				continue;
+			}
+
+			Entry& entry = entries[NormalizeArchivePath(&filename[0])];
+			unzGetFilePos(handle,&entry.pos);
+			entry.size = info.uncompressed_size;
+		}
+	}
+
+	std::string path;
+	EntryMap entries;
+	bool isOpen;
+};
+
+// ------------------------------------------------------------------------------------------------
+ZipArchiveIOSystem::ZipArchiveIOSystem( const std::string& rFile )
+: pimpl(new Implementation())
+{
+	pimpl->path = rFile;
+	if (!rFile.empty()) {
+		unzFile handle = unzOpen(rFile.c_str());
+		if (handle) {
+			pimpl->MapArchive(handle);
+			pimpl->isOpen = true;
+			unzClose(handle);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+ZipArchiveIOSystem::~ZipArchiveIOSystem()
+{
+	delete pimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::Exists( const char* pFile) const
+{
+	ai_assert(NULL != pFile);
+	return pimpl->entries.find(NormalizeArchivePath(pFile)) != pimpl->entries.end();
+}
+
+// ------------------------------------------------------------------------------------------------
+char ZipArchiveIOSystem::getOsSeparator() const
+{
+	return '/';
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ZipArchiveIOSystem::Open( const char* pFile, const char* pMode)
+{
+	ai_assert(NULL != pFile);
+	ai_assert(NULL != pMode);
+
+	// archives are read-only
+	if (::strchr(pMode,'w') || ::strchr(pMode,'a') || ::strchr(pMode,'+')) {
+		return NULL;
+	}
+
+	const Implementation::EntryMap::const_iterator it = pimpl->entries.find(NormalizeArchivePath(pFile));
+	if (it == pimpl->entries.end()) {
+		return NULL;
+	}
+
+	// Every stream opens its own handle to the archive, so several files can be
+	// decompressed at the same time. unzOpen() only reads the end of the central
+	// directory, and we already know where to find the file.
+	unzFile handle = unzOpen(pimpl->path.c_str());
+	if (!handle) {
+		return NULL;
+	}
+
+	const uLong size = it->second.size;
+	uint8_t* data = new uint8_t[std::max(size,static_cast<uLong>(1))];
+
+	unz_file_pos pos = it->second.pos;
+	bool ok = UNZ_OK == unzGoToFilePos(handle,&pos) && UNZ_OK == unzOpenCurrentFile(handle);
+	if (ok) {
+		const int ret = unzReadCurrentFile(handle,data,static_cast<unsigned int>(size));
+		ok = ret >= 0 && static_cast<uLong>(ret) == size;
+
+		// this also checks the CRC of the data
+		ok = UNZ_OK == unzCloseCurrentFile(handle) && ok;
+	}
+	unzClose(handle);
+
+	if (!ok) {
+		DefaultLogger::get()->error(std::string("Failed to decompress ") + pFile + " from " + pimpl->path);
+		delete[] data;
+		return NULL;
+	}
+	return new MemoryIOStream(data,size,true);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipArchiveIOSystem::Close( IOStream* pFile)
+{
+	delete pFile;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::isOpen() const
+{
+	return pimpl->isOpen;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipArchiveIOSystem::getFileList( std::vector<std::string>& rFileList ) const
+{
+	rFileList.clear();
+	rFileList.reserve(pimpl->entries.size());
+	for (Implementation::EntryMap::const_iterator it = pimpl->entries.begin(); it != pimpl->entries.end(); ++it) {
+		rFileList.push_back(it->first);
+	}
+}
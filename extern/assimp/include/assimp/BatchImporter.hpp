@@ -0,0 +1,187 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file BatchImporter.hpp
+ *  @brief Defines a C++-API to import many files concurrently.
+*/
+
+#ifndef AI_BATCHIMPORTER_H_INC
+#define AI_BATCHIMPORTER_H_INC
+
+#ifndef __cplusplus
+#	error This header requires C++ to be used.
+#endif
+
+#include "Importer.hpp"
+#include <string>
+#include <vector>
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** @brief Result of importing a single file of a batch. */
+struct BatchImportResult
+{
+	BatchImportResult()
+		: mScene(NULL)
+		, mSeconds(0.0)
+	{}
+
+	/** Path of the file, as given to BatchImporter::Import() */
+	std::string mFile;
+
+	/** Imported scene, NULL if the import failed. The scene is owned
+	 *  by the caller and must be released with 'delete'. */
+	aiScene* mScene;
+
+	/** Error message for failed imports, empty otherwise */
+	std::string mError;
+
+	/** Time spent to import and post-process the file, in seconds */
+	double mSeconds;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Aggregate statistics of the last BatchImporter::Import() call. */
+struct BatchImportStatistics
+{
+	BatchImportStatistics()
+		: mNumFiles(0)
+		, mNumFailed(0)
+		, mNumThreads(0)
+		, mNumMeshes(0)
+		, mNumVertices(0)
+		, mNumFaces(0)
+		, mWallSeconds(0.0)
+		, mImportSeconds(0.0)
+	{}
+
+	/** Number of files in the batch and number of failed imports */
+	unsigned int mNumFiles, mNumFailed;
+
+	/** Number of threads which were used */
+	unsigned int mNumThreads;
+
+	/** Total amount of geometry in all imported scenes */
+	unsigned int mNumMeshes, mNumVertices, mNumFaces;
+
+	/** Elapsed time for the whole batch, in seconds */
+	double mWallSeconds;
+
+	/** Sum of the import times of all files, in seconds. The
+	 *  ratio to mWallSeconds is the effective parallel speedup. */
+	double mImportSeconds;
+
+	/** Throughput, in files per second */
+	double GetFilesPerSecond() const {
+		return mWallSeconds > 0.0 ? mNumFiles / mWallSeconds : 0.0;
+	}
+};
+
+// ---------------------------------------------------------------------------
+/** @brief CPP-API: Imports a list of files concurrently.
+ *
+ *  One #Importer (and thus one set of loader instances) is created per
+ *  worker thread, and each thread picks the next pending file from the
+ *  list as soon as it is done with the previous one. All importers share
+ *  the configuration properties of the batch importer, which can be
+ *  accessed through GetConfiguration().
+ *
+ *  The number of threads is taken from the #AI_CONFIG_GLOB_MULTITHREADING
+ *  property of the configuration. If several files are imported at once,
+ *  the post-processing steps of each file run single-threaded.
+ *
+ *  @note The DefaultLogger is shared by all threads. It serializes the
+ *    writes to its log streams, so the messages of the files are 
+ *    interleaved but intact. Don't create or kill the logger while a 
+ *    batch is being imported.
+ *  @note Custom IO handlers and progress handlers are not propagated to
+ *    the worker importers, files are read with the default IO system.
+ */
+class ASSIMP_API BatchImporter
+{
+public:
+
+	/** Construct a batch importer with an empty configuration */
+	BatchImporter();
+
+	/** Construct a batch importer which copies the configuration
+	 *  properties of an existing #Importer */
+	explicit BatchImporter(const Importer& config);
+
+	~BatchImporter();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Access the configuration to be used for all files. Use the
+	 *  SetPropertyXXX() members of the returned importer to change it. */
+	Importer& GetConfiguration();
+
+	// -------------------------------------------------------------------
+	/** Import a list of files.
+	 *
+	 *  @param pFiles Paths of the files to be imported
+	 *  @param pFlags Post-processing flags, see #Importer::ReadFile
+	 *  @param pResults Receives one result per file, in the order of
+	 *    pFiles. Scenes are owned by the caller afterwards.
+	 *  @return Number of files which were imported successfully */
+	unsigned int Import(const std::vector<std::string>& pFiles,
+		unsigned int pFlags,
+		std::vector<BatchImportResult>& pResults);
+
+	// -------------------------------------------------------------------
+	/** Get the statistics of the last Import() call */
+	const BatchImportStatistics& GetStatistics() const;
+
+private:
+
+	// not copyable
+	BatchImporter(const BatchImporter&);
+	BatchImporter& operator=(const BatchImporter&);
+
+	Importer* mConfig;
+	BatchImportStatistics mStatistics;
+};
+
+} //! namespace Assimp
+
+#endif // AI_BATCHIMPORTER_H_INC
@@ -0,0 +1,126 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file ZipArchiveIOSystem.hpp
+ *  @brief File system wrapper to read files from zip archives.
+*/
+
+#ifndef AI_ZIPARCHIVEIOSYSTEM_H_INC
+#define AI_ZIPARCHIVEIOSYSTEM_H_INC
+
+#ifndef __cplusplus
+#	error This header requires C++ to be used.
+#endif
+
+#include "IOSystem.hpp"
+#include <vector>
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** @brief CPP-API: IOSystem to read files from a zip archive.
+ *
+ *  Pass an instance to Importer::SetIOHandler() to import a model packed
+ *  in a zip archive (this includes pk3 files), along with all its external
+ *  files such as materials or textures. Paths are relative to the root of
+ *  the archive, use '/' or '\' to separate directories.
+ *
+ *  The central directory of the archive is read once when the archive is
+ *  opened, opening a file is then a simple lookup. Files are decompressed
+ *  into memory when they are opened. Different files can be opened and
+ *  read from multiple threads at the same time.
+ *
+ *  @code
+ *  Assimp::Importer importer;
+ *  importer.SetIOHandler(new Assimp::ZipArchiveIOSystem("assets.zip"));
+ *  const aiScene* scene = importer.ReadFile("models/house.obj",0);
+ *  @endcode */
+class ASSIMP_API ZipArchiveIOSystem : public IOSystem
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Open a zip archive. 
+	 *
+	 *  Check isOpen() to find out whether this succeeded. 
+	 *  @param rFile Path to the archive in the file system */
+	ZipArchiveIOSystem( const std::string& rFile );
+
+	~ZipArchiveIOSystem();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** @brief Tests for the existence of a file in the archive */
+	bool Exists( const char* pFile) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Returns '/', the directory separator used in archives */
+	char getOsSeparator() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Open a file in the archive, for reading only.
+	 *  @return New stream or NULL if the file doesn't exist, it can't
+	 *    be decompressed or pMode requests write access. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb");
+
+	// -------------------------------------------------------------------
+	/** @brief Close a stream returned by Open() */
+	void Close( IOStream* pFile);
+
+	// -------------------------------------------------------------------
+	/** @brief Check whether the archive was opened successfully */
+	bool isOpen() const;
+
+	// -------------------------------------------------------------------
+	/** @brief Get the paths of all files in the archive, in sorted order.
+	 *  Directory entries are not included. */
+	void getFileList( std::vector<std::string>& rFileList ) const;
+
+private:
+
+	struct Implementation;
+	Implementation* pimpl;
+};
+
+} //!ns Assimp
+
+#endif //AI_ZIPARCHIVEIOSYSTEM_H_INC
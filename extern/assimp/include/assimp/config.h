@@ -91,12 +91,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 
-# if 0 // not implemented yet
 // ---------------------------------------------------------------------------
 /** @brief Set Assimp's multithreading policy.
  *
- * This setting is ignored if Assimp was built without boost.thread
- * support (ASSIMP_BUILD_NO_THREADING, which is implied by ASSIMP_BUILD_BOOST_WORKAROUND).
+ * This setting is ignored if Assimp was built without OpenMP support.
  * Possible values are: -1 to let Assimp decide what to do, 0 to disable
  * multithreading entirely and any number larger than 0 to force a specific
  * number of threads. Assimp is always free to ignore this settings, which is
@@ -104,12 +102,54 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Assimp is used concurrently from multiple user threads, it might be useful
  * to limit each Importer instance to a specific number of cores.
  *
- * For more information, see the @link threading Threading page@endlink.
+ * Post processing steps which process meshes in parallel honour this setting.
  * Property type: int, default value: -1.
  */
 #define AI_CONFIG_GLOB_MULTITHREADING  \
 	"GLOB_MULTITHREADING"
-#endif
+
+// ---------------------------------------------------------------------------
+/** @brief Restricts the import to a subset of the nodes in the file.
+ *
+ * This is a list of 1 to n node names, with the same syntax as
+ * #AI_CONFIG_PP_OG_EXCLUDE_LIST. Each listed node is imported together
+ * with its whole subtree. Its ancestors are kept as plain transformation
+ * nodes, all other branches of the node graph are skipped, which includes
+ * reading and post-processing their geometry. Node names are matched
+ * against the names in the file, prior to any renaming done by assimp.
+ * This is currently supported by the FBX loader, the OBJ loader (objects
+ * and groups) and the IFC loader (products, matched by name or GlobalId).
+ * Other loaders ignore it and import the whole file.
+ * Property type: String. Default value: n/a (import everything)
+ */
+#define AI_CONFIG_IMPORT_NODE_FILTER \
+	"IMPORT_NODE_FILTER"
+
+// ---------------------------------------------------------------------------
+/** @brief Restricts the import to a subset of the animations in the file.
+ *
+ * This is a list of 1 to n animation names (i.e. FBX takes), with the same
+ * syntax as #AI_CONFIG_PP_OG_EXCLUDE_LIST. Animations which are not listed
+ * are not read at all. Supported by the FBX loader.
+ * Property type: String. Default value: n/a (import everything)
+ */
+#define AI_CONFIG_IMPORT_ANIMATION_FILTER \
+	"IMPORT_ANIMATION_FILTER"
+
+// ---------------------------------------------------------------------------
+/** @brief Imports the structure of a file only, to query its contents.
+ *
+ * Supporting loaders (FBX, OBJ, IFC) read the node graph and the names and
+ * durations of all animations, but no geometry and no animation channels.
+ * Such scenes are flagged #AI_SCENE_FLAGS_STRUCTURE_ONLY and
+ * #AI_SCENE_FLAGS_INCOMPLETE and no post-processing is applied to them,
+ * other loaders ignore the property. This is a cheap way to obtain the names
+ * to be passed to #AI_CONFIG_IMPORT_NODE_FILTER and
+ * #AI_CONFIG_IMPORT_ANIMATION_FILTER for the actual import.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_IMPORT_STRUCTURE_ONLY \
+	"IMPORT_STRUCTURE_ONLY"
 
 // ###########################################################################
 // POST PROCESSING SETTINGS
@@ -157,6 +197,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX \
 	"PP_CT_TEXTURE_CHANNEL_INDEX"
 
+// ---------------------------------------------------------------------------
+/** @brief Compute MikkTSpace tangents instead of assimp's own ones.
+ *
+ * MikkTSpace is the tangent space used by Blender and many other tools,
+ * normal maps baked there only display correctly with these tangents.
+ * Meshes are processed in parallel, see #AI_CONFIG_GLOB_MULTITHREADING.
+ * #AI_CONFIG_PP_CT_MAX_SMOOTHING_ANGLE is ignored in this mode.
+ * This requires assimp to be built with ASSIMP_BUILD_WITH_MIKKTSPACE,
+ * otherwise a warning is printed and the default algorithm is used.
+ * Property type: bool. Default value: false
+ */
+#define AI_CONFIG_PP_CT_MIKKTSPACE \
+	"PP_CT_MIKKTSPACE"
+
 // ---------------------------------------------------------------------------
 /** @brief  Specifies the maximum angle that may be between two face normals
  *          at the same vertex position that their are smoothed together.
@@ -299,6 +353,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	define AI_SLM_DEFAULT_MAX_VERTICES		1000000
 #endif
 
+// ---------------------------------------------------------------------------
+/** @brief  Split large meshes by spatial locality instead of face order.
+ *
+ * This is used by the "SplitLargeMeshes" PostProcess-Step. If enabled, the
+ * faces of a mesh that must be split are partitioned by recursively
+ * bisecting it in space first. The submeshes then cover compact regions
+ * with tight bounding boxes and share fewer vertices, which makes culling
+ * and streaming them much more efficient. Note that the face order of the
+ * split meshes is changed.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_SLM_SPATIAL \
+	"PP_SLM_SPATIAL"
+
 // ---------------------------------------------------------------------------
 /** @brief Set the maximum number of bones affecting a single vertex
  *
@@ -336,6 +404,91 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_PP_DB_ALL_OR_NONE \
 	"PP_DB_ALL_OR_NONE"
 
+// ---------------------------------------------------------------------------
+/** @brief Quantize the positions of all meshes relative to the bounding box
+ *    of the whole scene instead of the bounding box of each mesh.
+ *
+ * This is used by the #aiProcess_QuantizeAttributes PostProcess-Step. Use
+ * this if meshes share vertices along their borders, with per-mesh bounds
+ * these vertices could be rounded differently, resulting in small cracks.
+ * The bounds are computed in mesh space, so this is only useful if the
+ * meshes share a coordinate system (i.e. with #aiProcess_PreTransformVertices).
+ * @note The default value is 0
+ * Property type: bool.*/
+#define AI_CONFIG_PP_QA_SCENE_BOUNDS \
+	"PP_QA_SCENE_BOUNDS"
+
+// ---------------------------------------------------------------------------
+/** @brief Maximum number of vertices per meshlet.
+ *
+ * This is used by the #aiProcess_GenMeshlets PostProcess-Step. The
+ * meshlet triangles use 8 bit indices, so the limit is 256.
+ * @note The default value is AI_MESHLET_MAX_VERTICES
+ * Property type: integer.*/
+#define AI_CONFIG_PP_ML_MAX_VERTICES \
+	"PP_ML_MAX_VERTICES"
+
+// default value for AI_CONFIG_PP_ML_MAX_VERTICES
+#if (!defined AI_MESHLET_MAX_VERTICES)
+#	define AI_MESHLET_MAX_VERTICES	64
+#endif // !! AI_MESHLET_MAX_VERTICES
+
+// ---------------------------------------------------------------------------
+/** @brief Maximum number of triangles per meshlet.
+ *
+ * This is used by the #aiProcess_GenMeshlets PostProcess-Step.
+ * @note The default value is AI_MESHLET_MAX_TRIANGLES
+ * Property type: integer.*/
+#define AI_CONFIG_PP_ML_MAX_TRIANGLES \
+	"PP_ML_MAX_TRIANGLES"
+
+// default value for AI_CONFIG_PP_ML_MAX_TRIANGLES
+#if (!defined AI_MESHLET_MAX_TRIANGLES)
+#	define AI_MESHLET_MAX_TRIANGLES	124
+#endif // !! AI_MESHLET_MAX_TRIANGLES
+
+// ---------------------------------------------------------------------------
+/** @brief Number of levels of detail to be generated for each mesh.
+ *
+ * This is used by the #aiProcess_GenLODs PostProcess-Step. Fewer levels
+ * are generated if a mesh cannot be simplified any further.
+ * @note The default value is AI_LOD_LEVELS
+ * Property type: integer.*/
+#define AI_CONFIG_PP_LOD_LEVELS \
+	"PP_LOD_LEVELS"
+
+// default value for AI_CONFIG_PP_LOD_LEVELS
+#if (!defined AI_LOD_LEVELS)
+#	define AI_LOD_LEVELS	3
+#endif // !! AI_LOD_LEVELS
+
+// ---------------------------------------------------------------------------
+/** @brief Ratio of the triangle counts of two successive levels of detail.
+ *
+ * This is used by the #aiProcess_GenLODs PostProcess-Step. Level n gets
+ * about ratio^n times the triangles of the original mesh.
+ * @note The default value is AI_LOD_RATIO
+ * Property type: float.*/
+#define AI_CONFIG_PP_LOD_RATIO \
+	"PP_LOD_RATIO"
+
+// default value for AI_CONFIG_PP_LOD_RATIO
+#if (!defined AI_LOD_RATIO)
+#	define AI_LOD_RATIO	0.5f
+#endif // !! AI_LOD_RATIO
+
+// ---------------------------------------------------------------------------
+/** @brief Maximum geometric error of a level of detail, relative to the
+ *    size of the mesh.
+ *
+ * This is used by the #aiProcess_GenLODs PostProcess-Step. Edges whose
+ * collapse would exceed this error are kept, even if the triangle count
+ * of the level is not reached. 
+ * @note The default value is 1.0, which effectively imposes no limit.
+ * Property type: float.*/
+#define AI_CONFIG_PP_LOD_MAX_ERROR \
+	"PP_LOD_MAX_ERROR"
+
 /** @brief Default value for the #AI_CONFIG_PP_ICL_PTCACHE_SIZE property
  */
 #ifndef PP_ICL_PTCACHE_SIZE
@@ -492,6 +645,21 @@ enum aiComponent
 #define AI_CONFIG_PP_TUV_EVALUATE				\
 	"PP_TUV_EVALUATE"
 
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_ValidateDataStructure step:
+ *  Restricts validation to the structural invariants of the scene.
+ *
+ *  If enabled, the step checks array pointers against their counts, the
+ *  node graph, mesh and material references, limits and the order of
+ *  vertex attribute channels, but skips the per-element checks of face 
+ *  indices, bone weights, animation keys and material properties. This is 
+ *  meant for loaders whose output is trusted and cuts validation time 
+ *  to a fraction on large scenes.
+ *  Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_VDS_TRUSTED_LOADER				\
+	"PP_VDS_TRUSTED_LOADER"
+
 // ---------------------------------------------------------------------------
 /** @brief A hint to assimp to favour speed against import quality.
  *
@@ -438,6 +438,189 @@ struct aiAnimMesh
 };
 
 
+// ---------------------------------------------------------------------------
+/** @brief A compact, quantized copy of the vertex attributes of an #aiMesh.
+ *
+ *  Generated by the #aiProcess_QuantizeAttributes post processing step and
+ *  attached to the mesh as aiMesh::mQuantization. The full precision arrays
+ *  of the host mesh are left untouched, applications which upload the
+ *  quantized data to the GPU (or write it to disk) may free them afterwards
+ *  by deleting the arrays and setting the pointers to NULL - except for
+ *  aiMesh::mVertices, which is required by Assimp.
+ *
+ *  All arrays are mNumVertices in size (times the number of components
+ *  per vertex), arrays are NULL if the host mesh lacks the attribute.
+ */
+struct aiQuantizedAttributes
+{
+	/** Vertex positions, three unsigned 16 bit values per vertex.
+	 *  The position of vertex i is reconstructed as 
+	 *  <tt>mPositionOffset + mPositions[i*3+c] * mPositionScale</tt>,
+	 *  component-wise. */
+	unsigned short* mPositions;
+
+	/** Minimum of the bounding box the positions were quantized to */
+	C_STRUCT aiVector3D mPositionOffset;
+
+	/** Size of a quantization step along each axis. Zero if all
+	 *  positions share the same coordinate on that axis. */
+	C_STRUCT aiVector3D mPositionScale;
+
+	/** Vertex normals, two signed normalized 16 bit values per vertex
+	 *  in octahedral encoding. For a pair (u,v), divided by 32767, the
+	 *  unit vector is (u, v, 1-|u|-|v|) if the last component is not
+	 *  negative, else ((1-|v|)*sign(u), (1-|u|)*sign(v), 1-|u|-|v|),
+	 *  normalized. sign(0) is +1. */
+	short* mNormals;
+
+	/** Vertex tangents, encoded like #mNormals */
+	short* mTangents;
+
+	/** Vertex bitangents, encoded like #mNormals */
+	short* mBitangents;
+
+	/** Texture coordinates as IEEE 754 half precision floats,
+	 *  #mNumUVComponents values per vertex. */
+	unsigned short* mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+	/** Number of components of each texture coordinate set, same as
+	 *  in the host mesh. */
+	unsigned int mNumUVComponents[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+
+	/** Number of vertices, same as in the host mesh. Duplicated here
+	 *  to make the length of the arrays accessible without the host
+	 *  mesh, as for #aiAnimMesh. */
+	unsigned int mNumVertices;
+
+	/** Largest distance between a reconstructed and an original 
+	 *  vertex position, along any axis */
+	float mMaxPositionError;
+
+	/** Largest angle, in radians, between a reconstructed and an
+	 *  original normal, tangent or bitangent */
+	float mMaxNormalError;
+
+	/** Largest difference between a reconstructed and an original
+	 *  texture coordinate component */
+	float mMaxTextureCoordError;
+
+#ifdef __cplusplus
+
+	aiQuantizedAttributes()
+		: mPositions()
+		, mNormals()
+		, mTangents()
+		, mBitangents()
+		, mNumVertices()
+		, mMaxPositionError()
+		, mMaxNormalError()
+		, mMaxTextureCoordError()
+	{
+		for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+			mTextureCoords[a] = NULL;
+			mNumUVComponents[a] = 0;
+		}
+	}
+
+	~aiQuantizedAttributes()
+	{
+		delete [] mPositions;
+		delete [] mNormals;
+		delete [] mTangents;
+		delete [] mBitangents;
+		for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+			delete [] mTextureCoords[a];
+		}
+	}
+#endif
+};
+
+// ---------------------------------------------------------------------------
+/** @brief A small cluster of triangles of a mesh, see #aiMeshletTable.
+ *
+ *  Each meshlet references up to aiMeshletTable::mMaxVertices vertices of
+ *  its mesh and up to aiMeshletTable::mMaxTriangles triangles built from
+ *  them. The bounding sphere and normal cone allow to cull whole meshlets
+ *  on the GPU.
+ */
+struct aiMeshlet
+{
+	/** Index of the first vertex of the meshlet in aiMeshletTable::mVertices */
+	unsigned int mVertexOffset;
+
+	/** Index of the first triangle of the meshlet in aiMeshletTable::mTriangles */
+	unsigned int mTriangleOffset;
+
+	/** Number of vertices and triangles in the meshlet */
+	unsigned int mNumVertices, mNumTriangles;
+
+	/** Bounding sphere of the meshlet, in mesh space */
+	C_STRUCT aiVector3D mCenter;
+	float mRadius;
+
+	/** Normal cone of the meshlet. All triangles of the meshlet are 
+	 *  backfacing for a viewer at position p if
+	 *  <tt>dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff</tt>.
+	 *  If the triangles face too many directions, mConeAxis is zero
+	 *  and mConeCutoff is 1, so the test never succeeds. */
+	C_STRUCT aiVector3D mConeApex;
+	C_STRUCT aiVector3D mConeAxis;
+	float mConeCutoff;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Partitioning of the triangles of an #aiMesh into meshlets.
+ *
+ *  Generated by the #aiProcess_GenMeshlets post processing step and attached 
+ *  to the mesh as aiMesh::mMeshlets. The triangles of each meshlet refer to 
+ *  their vertices with 8 bit local indices, which map to the vertices of
+ *  the host mesh through #mVertices.
+ */
+struct aiMeshletTable
+{
+	/** The meshlets, mNumMeshlets in size */
+	C_STRUCT aiMeshlet* mMeshlets;
+	unsigned int mNumMeshlets;
+
+	/** Vertex index lists of all meshlets. The local index i of
+	 *  meshlet m refers to vertex <tt>mVertices[m.mVertexOffset + i]</tt>
+	 *  of the host mesh. mNumVertices in size. */
+	unsigned int* mVertices;
+	unsigned int mNumVertices;
+
+	/** Triangles of all meshlets, three local vertex indices each. 
+	 *  Triangle t of meshlet m starts at 
+	 *  <tt>mTriangles[(m.mTriangleOffset + t) * 3]</tt>. 
+	 *  mNumTriangles * 3 in size. */
+	unsigned char* mTriangles;
+	unsigned int mNumTriangles;
+
+	/** Limits the meshlets were generated with */
+	unsigned int mMaxVertices, mMaxTriangles;
+
+#ifdef __cplusplus
+
+	aiMeshletTable()
+		: mMeshlets()
+		, mNumMeshlets()
+		, mVertices()
+		, mNumVertices()
+		, mTriangles()
+		, mNumTriangles()
+		, mMaxVertices()
+		, mMaxTriangles()
+	{
+	}
+
+	~aiMeshletTable()
+	{
+		delete [] mMeshlets;
+		delete [] mVertices;
+		delete [] mTriangles;
+	}
+#endif
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material. 
 *
@@ -599,6 +782,27 @@ struct aiMesh
 	 *  mesh'es vertex components (usually positions, normals). */
 	C_STRUCT aiAnimMesh** mAnimMeshes;
 
+	/** Quantized copy of the vertex attributes, NULL if not present.
+	 *  Generated by the #aiProcess_QuantizeAttributes step. */
+	C_STRUCT aiQuantizedAttributes* mQuantization;
+
+	/** Partitioning of the faces into meshlets, NULL if not present.
+	 *  Generated by the #aiProcess_GenMeshlets step. */
+	C_STRUCT aiMeshletTable* mMeshlets;
+
+	/** The number of simplified versions of this mesh */
+	unsigned int mNumLODs;
+
+	/** Simplified versions of this mesh, generated by the 
+	 *  #aiProcess_GenLODs step. Ordered from the most to the least
+	 *  detailed level, NULL if mNumLODs is 0. The LOD meshes use the
+	 *  material of this mesh and don't have LODs of their own. */
+	C_STRUCT aiMesh** mLODs;
+
+	/** For LOD meshes, the estimated geometric error with respect to
+	 *  the original mesh, as a distance in mesh space. 0 otherwise. */
+	float mLODError;
+
 
 #ifdef __cplusplus
 
@@ -627,6 +831,11 @@ struct aiMesh
 		mMaterialIndex = 0;
 		mNumAnimMeshes = 0;
 		mAnimMeshes = NULL;
+		mQuantization = NULL;
+		mMeshlets = NULL;
+		mNumLODs = 0;
+		mLODs = NULL;
+		mLODError = 0.f;
 	}
 
 	//! Deletes all storage allocated for the mesh
@@ -658,6 +867,15 @@ struct aiMesh
 			delete [] mAnimMeshes;
 		}
 
+		delete mQuantization;
+		delete mMeshlets;
+
+		if (mNumLODs && mLODs)	{
+			for( unsigned int a = 0; a < mNumLODs; a++) {
+				delete mLODs[a];
+			}
+			delete [] mLODs;
+		}
 		delete [] mFaces;
 	}
 
@@ -683,6 +901,18 @@ struct aiMesh
 	bool HasTangentsAndBitangents() const 
 		{ return mTangents != NULL && mBitangents != NULL && mNumVertices > 0; }
 
+	//! Check whether the mesh carries quantized vertex attributes
+	bool HasQuantizedAttributes() const 
+		{ return mQuantization != NULL && mQuantization->mPositions != NULL; }
+
+	//! Check whether the mesh has simplified versions
+	bool HasLODs() const 
+		{ return mLODs != NULL && mNumLODs > 0; }
+
+	//! Check whether the mesh has been partitioned into meshlets
+	bool HasMeshlets() const 
+		{ return mMeshlets != NULL && mMeshlets->mNumMeshlets > 0; }
+
 	//! Check whether the mesh contains a vertex color set
 	//! \param pIndex Index of the vertex color set
 	bool HasVertexColors( unsigned int pIndex) const
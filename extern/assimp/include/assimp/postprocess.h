@@ -520,7 +520,57 @@ enum aiPostProcessSteps
 	 *  Use <tt>#AI_CONFIG_PP_DB_ALL_OR_NONE</tt> if you want bones removed if and 
 	 *	only if all bones within the scene qualify for removal.
     */
-	aiProcess_Debone  = 0x4000000
+	aiProcess_Debone  = 0x4000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step stores a compact, quantized copy of the vertex attributes
+	 *  of each mesh in aiMesh::mQuantization.
+	 *
+	 *  Positions are stored as 16 bit unsigned integers relative to the 
+	 *  bounding box of the mesh, normals, tangents and bitangents as two 16
+	 *  bit values in octahedral encoding and texture coordinates as half 
+	 *  precision floats. This cuts the vertex size to about a third, which
+	 *  is helpful for applications which upload large scenes to the GPU
+	 *  or store them in a cache. The error introduced by the quantization
+	 *  is reported in the #aiQuantizedAttributes structure. 
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_QA_SCENE_BOUNDS</tt> to quantize all meshes to
+	 *  a common lattice, so that vertices shared by adjacent meshes stay
+	 *  identical. The full precision data is not modified by this step.
+    */
+	aiProcess_QuantizeAttributes  = 0x8000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step partitions the triangles of each mesh into small clusters
+	 *  (meshlets) and stores them in aiMesh::mMeshlets.
+	 *
+	 *  Each meshlet has a bounding sphere and a normal cone, which renderers
+	 *  use to cull whole clusters on the GPU before processing their 
+	 *  triangles. Triangles are grouped greedily so that the meshlets are
+	 *  compact and share few vertices. The faces of the mesh are not 
+	 *  modified, meshes which contain other primitives than triangles are
+	 *  skipped (use #aiProcess_Triangulate and #aiProcess_SortByPType).
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_ML_MAX_VERTICES</tt> and 
+	 *  <tt>#AI_CONFIG_PP_ML_MAX_TRIANGLES</tt> to set the size of the meshlets.
+    */
+	aiProcess_GenMeshlets  = 0x10000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step generates a chain of simplified versions (levels of 
+	 *  detail) of each triangle mesh and stores them in aiMesh::mLODs.
+	 *
+	 *  The meshes are simplified by collapsing edges in the order given by
+	 *  their quadric error. Vertices on open borders and UV seams only move
+	 *  along the border or seam, so the LODs don't tear open, and collapses 
+	 *  between vertices with different bone weights are penalized. The 
+	 *  estimated error of each level is stored in aiMesh::mLODError.
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_LOD_LEVELS</tt>, <tt>#AI_CONFIG_PP_LOD_RATIO</tt>
+	 *  and <tt>#AI_CONFIG_PP_LOD_MAX_ERROR</tt> to configure the chain. Meshes
+	 *  which contain other primitives than triangles are skipped.
+    */
+	aiProcess_GenLODs  = 0x20000000
 
 	// aiProcess_GenEntityMeshes = 0x100000,
 	// aiProcess_OptimizeAnimations = 0x200000
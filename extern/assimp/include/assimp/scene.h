@@ -214,6 +214,14 @@ struct aiNode
  */
 #define AI_SCENE_FLAGS_TERRAIN 0x10
 
+/** @def AI_SCENE_FLAGS_STRUCTURE_ONLY
+ * This flag is set by loaders which honoured #AI_CONFIG_IMPORT_STRUCTURE_ONLY.
+ * The scene holds the node graph and the names and durations of the 
+ * animations, but no geometry and no animation channels. No post processing
+ * is applied to such scenes, they are also flagged #AI_SCENE_FLAGS_INCOMPLETE.
+ */
+#define AI_SCENE_FLAGS_STRUCTURE_ONLY 0x20
+
 
 // -------------------------------------------------------------------------------
 /** The root structure of the imported data. 
@@ -0,0 +1,217 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Test of the GenVertexNormalsProcess post processing step. 
+ *  Returns a non-zero exit code if a test fails.
+ */
+
+#include "../../code/AssimpPCH.h"
+#include "../../code/GenVertexNormalsProcess.h"
+
+#include <stdio.h>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+// Friend of GenVertexNormalsProcess, the steps are normally driven by an Importer
+class GenNormalsTest
+{
+public:
+
+	// Build a unit cube as loaders emit it for a textured cube: every side has
+	// its own four vertices, shared by the two triangles of the side. Each 
+	// corner of the cube is thus a seam of three vertices at the same position.
+	static aiMesh* CreateSeamedCube()
+	{
+		static const float corners[6][4][3] = {
+			{{-1,-1, 1},{ 1,-1, 1},{ 1, 1, 1},{-1, 1, 1}},
+			{{ 1,-1,-1},{-1,-1,-1},{-1, 1,-1},{ 1, 1,-1}},
+			{{ 1,-1, 1},{ 1,-1,-1},{ 1, 1,-1},{ 1, 1, 1}},
+			{{-1,-1,-1},{-1,-1, 1},{-1, 1, 1},{-1, 1,-1}},
+			{{-1, 1, 1},{ 1, 1, 1},{ 1, 1,-1},{-1, 1,-1}},
+			{{-1,-1,-1},{ 1,-1,-1},{ 1,-1, 1},{-1,-1, 1}}};
+
+		aiMesh* mesh = new aiMesh();
+		mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		mesh->mNumVertices = 24;
+		mesh->mVertices = new aiVector3D[24];
+		mesh->mNumFaces = 12;
+		mesh->mFaces = new aiFace[12];
+
+		for (unsigned int side = 0; side < 6; ++side) {
+			for (unsigned int i = 0; i < 4; ++i) {
+				const float* c = corners[side][i];
+				mesh->mVertices[side*4+i] = aiVector3D(c[0],c[1],c[2]);
+			}
+			for (unsigned int t = 0; t < 2; ++t) {
+				aiFace& face = mesh->mFaces[side*2+t];
+				face.mNumIndices = 3;
+				face.mIndices = new unsigned int[3];
+				face.mIndices[0] = side*4;
+				face.mIndices[1] = side*4+1+t;
+				face.mIndices[2] = side*4+2+t;
+			}
+		}
+		return mesh;
+	}
+
+	// The same mesh with a separate copy of every vertex for each face
+	static aiMesh* CreateVerboseCopy(const aiMesh* mesh)
+	{
+		aiMesh* verbose = new aiMesh();
+		verbose->mPrimitiveTypes = mesh->mPrimitiveTypes;
+		verbose->mNumVertices = mesh->mNumFaces * 3;
+		verbose->mVertices = new aiVector3D[verbose->mNumVertices];
+		verbose->mNumFaces = mesh->mNumFaces;
+		verbose->mFaces = new aiFace[mesh->mNumFaces];
+
+		for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+			aiFace& face = verbose->mFaces[a];
+			face.mNumIndices = 3;
+			face.mIndices = new unsigned int[3];
+			for (unsigned int i = 0; i < 3; ++i) {
+				face.mIndices[i] = a*3+i;
+				verbose->mVertices[a*3+i] = mesh->mVertices[mesh->mFaces[a].mIndices[i]];
+			}
+		}
+		return verbose;
+	}
+
+	static void GenNormals(aiMesh* mesh, float maxAngleDeg, int numThreads)
+	{
+		GenVertexNormalsProcess process;
+		process.configMaxAngle = AI_DEG_TO_RAD(maxAngleDeg);
+		process.configNumThreads = numThreads;
+		process.GenMeshVertexNormals(mesh,0);
+	}
+
+	// Smoothed without an angle limit, all vertices at a corner of the cube
+	// must get the same normal, pointing away from the center.
+	static bool TestSmoothSeams(int numThreads)
+	{
+		aiMesh* mesh = CreateSeamedCube();
+		GenNormals(mesh,175.f,numThreads);
+
+		bool ok = true;
+		for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+			const aiVector3D& n = mesh->mNormals[i];
+			if (!(n * mesh->mVertices[i] > 0.f) || fabs(n.SquareLength() - 1.f) > 1e-4f) {
+				printf("smooth seam, vertex %u: normal (%f %f %f) does not point outwards\n", i, n.x, n.y, n.z);
+				ok = false;
+			}
+			for (unsigned int j = 0; j < i; ++j) {
+				const aiVector3D& nj = mesh->mNormals[j];
+				if (mesh->mVertices[j] == mesh->mVertices[i] && (n - nj).SquareLength() > 1e-6f) {
+					printf("smooth seam, vertices %u and %u: normals (%f %f %f) and (%f %f %f) differ\n", j, i, 
+						nj.x, nj.y, nj.z, n.x, n.y, n.z);
+					ok = false;
+				}
+			}
+		}
+		delete mesh;
+		return ok;
+	}
+
+	// With an angle limit below 90 degrees the edges of the cube stay hard,
+	// every vertex gets the normal of its own side.
+	static bool TestHardEdges(int numThreads)
+	{
+		aiMesh* mesh = CreateSeamedCube();
+		GenNormals(mesh,80.f,numThreads);
+
+		bool ok = true;
+		for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+			const aiFace& face = mesh->mFaces[(i/4)*2];
+			const aiVector3D& v1 = mesh->mVertices[face.mIndices[0]];
+			aiVector3D expected = (mesh->mVertices[face.mIndices[1]] - v1) ^ (mesh->mVertices[face.mIndices[2]] - v1);
+			expected.Normalize();
+			if ((mesh->mNormals[i] - expected).SquareLength() > 1e-6f) {
+				printf("hard edge, vertex %u: normal (%f %f %f), expected (%f %f %f)\n", i, 
+					mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z,
+					expected.x, expected.y, expected.z);
+				ok = false;
+			}
+		}
+		delete mesh;
+		return ok;
+	}
+
+	// Meshes with shared vertices must be smoothed exactly like their verbose 
+	// counterpart, for any angle limit.
+	static bool TestMatchesVerbose(float maxAngleDeg, int numThreads)
+	{
+		aiMesh* mesh = CreateSeamedCube();
+		aiMesh* verbose = CreateVerboseCopy(mesh);
+		GenNormals(mesh,maxAngleDeg,numThreads);
+		GenNormals(verbose,maxAngleDeg,numThreads);
+
+		bool ok = true;
+		for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+			for (unsigned int i = 0; i < 3; ++i) {
+				const aiVector3D& n = mesh->mNormals[mesh->mFaces[a].mIndices[i]];
+				const aiVector3D& nv = verbose->mNormals[verbose->mFaces[a].mIndices[i]];
+				if ((n - nv).SquareLength() > 1e-6f) {
+					printf("angle %.0f, face %u, corner %u: normal (%f %f %f), verbose (%f %f %f)\n", 
+						maxAngleDeg, a, i, n.x, n.y, n.z, nv.x, nv.y, nv.z);
+					ok = false;
+				}
+			}
+		}
+		delete mesh;
+		delete verbose;
+		return ok;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+int main()
+{
+	bool ok = true;
+	for (int numThreads = 1; numThreads <= 2; ++numThreads) {
+		ok = GenNormalsTest::TestSmoothSeams(numThreads) && ok;
+		ok = GenNormalsTest::TestHardEdges(numThreads) && ok;
+		ok = GenNormalsTest::TestMatchesVerbose(175.f,numThreads) && ok;
+		ok = GenNormalsTest::TestMatchesVerbose(100.f,numThreads) && ok;
+		ok = GenNormalsTest::TestMatchesVerbose(45.f,numThreads) && ok;
+	}
+	printf("GenVertexNormalsProcess: %s\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
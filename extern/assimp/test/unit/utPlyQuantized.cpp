@@ -0,0 +1,164 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Round trip test of the quantized Ply exporter ("plyq") and the Ply importer. 
+ *  Returns a non-zero exit code if a test fails.
+ */
+
+#include "../../include/assimp/Importer.hpp"
+#include "../../include/assimp/Exporter.hpp"
+#include "../../include/assimp/scene.h"
+#include "../../include/assimp/postprocess.h"
+
+#include <math.h>
+#include <stdio.h>
+
+// ------------------------------------------------------------------------------------------------
+// A quad with normals and texture coordinates, size and position are given
+static aiMesh* CreateQuad(const aiVector3D& origin, float size, unsigned int materialIndex)
+{
+	static const float corners[4][2] = {{0,0},{1,0},{1,1},{0,1}};
+
+	aiMesh* mesh = new aiMesh();
+	mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+	mesh->mMaterialIndex = materialIndex;
+	mesh->mNumVertices = 4;
+	mesh->mVertices = new aiVector3D[4];
+	mesh->mNormals = new aiVector3D[4];
+	mesh->mNumUVComponents[0] = 2;
+	mesh->mTextureCoords[0] = new aiVector3D[4];
+
+	for (unsigned int i = 0; i < 4; ++i) {
+		const float u = corners[i][0], v = corners[i][1];
+		// a slightly bent quad, so the normals differ
+		mesh->mVertices[i] = origin + aiVector3D(u * size, v * size, u * v * size * 0.25f);
+		mesh->mNormals[i] = aiVector3D(-0.25f * v, -0.25f * u, 1.f).Normalize();
+		mesh->mTextureCoords[0][i] = aiVector3D(u * 0.75f + 0.1f, v * 0.5f + 0.3f, 0.f);
+	}
+
+	mesh->mNumFaces = 2;
+	mesh->mFaces = new aiFace[2];
+	for (unsigned int t = 0; t < 2; ++t) {
+		aiFace& face = mesh->mFaces[t];
+		face.mNumIndices = 3;
+		face.mIndices = new unsigned int[3];
+		face.mIndices[0] = 0;
+		face.mIndices[1] = 1+t;
+		face.mIndices[2] = 2+t;
+	}
+	return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Two meshes of very different size, each one with its own material so the
+// export keeps them apart and quantizes each to its own bounding box.
+static aiScene* CreateScene()
+{
+	aiScene* scene = new aiScene();
+	scene->mNumMaterials = 2;
+	scene->mMaterials = new aiMaterial*[2];
+	scene->mMaterials[0] = new aiMaterial();
+	scene->mMaterials[1] = new aiMaterial();
+
+	scene->mNumMeshes = 2;
+	scene->mMeshes = new aiMesh*[2];
+	scene->mMeshes[0] = CreateQuad(aiVector3D(0.f,0.f,0.f),1.f,0);
+	scene->mMeshes[1] = CreateQuad(aiVector3D(100.f,-500.f,20.f),1000.f,1);
+
+	scene->mRootNode = new aiNode();
+	scene->mRootNode->mNumMeshes = 2;
+	scene->mRootNode->mMeshes = new unsigned int[2];
+	scene->mRootNode->mMeshes[0] = 0;
+	scene->mRootNode->mMeshes[1] = 1;
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+int main()
+{
+	aiScene* scene = CreateScene();
+
+	Assimp::Exporter exporter;
+	const aiExportDataBlob* blob = exporter.ExportToBlob(scene,"plyq");
+	if (!blob) {
+		printf("export failed: %s\n", exporter.GetErrorString());
+		return 1;
+	}
+
+	Assimp::Importer importer;
+	const aiScene* result = importer.ReadFileFromMemory(blob->data,blob->size,0,"ply");
+	if (!result || result->mNumMeshes != 1) {
+		printf("import failed: %s\n", importer.GetErrorString());
+		return 1;
+	}
+
+	// the importer doesn't share vertices, every face corner has its own
+	const aiMesh* mesh = result->mMeshes[0];
+	bool ok = mesh->mNumFaces == 4 && mesh->HasNormals() && mesh->HasTextureCoords(0);
+	for (unsigned int f = 0; ok && f < mesh->mNumFaces; ++f) {
+		const aiMesh* source = scene->mMeshes[f / 2];
+		const aiFace& sourceFace = source->mFaces[f % 2];
+
+		// quantization steps of 1/65535 of the mesh size, so the small mesh must
+		// not use the lattice of the large one
+		const float posTolerance = (f < 2 ? 1.f : 1000.f) / 65535.f;
+
+		for (unsigned int i = 0; i < 3; ++i) {
+			const unsigned int a = mesh->mFaces[f].mIndices[i], b = sourceFace.mIndices[i];
+
+			const aiVector3D d = mesh->mVertices[a] - source->mVertices[b];
+			const float posError = std::max(fabs(d.x),std::max(fabs(d.y),fabs(d.z)));
+			const float norCos = mesh->mNormals[a] * source->mNormals[b];
+			const aiVector3D uv = mesh->mTextureCoords[0][a] - source->mTextureCoords[0][b];
+			const float uvError = std::max(fabs(uv.x),fabs(uv.y));
+
+			if (posError > posTolerance || norCos < 0.99999f || uvError > 1e-3f) {
+				printf("face %u, corner %u: position error %g, normal cosine %g, uv error %g\n",
+					f, i, posError, norCos, uvError);
+				ok = false;
+			}
+		}
+	}
+
+	delete scene;
+	printf("Quantized Ply round trip: %s\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
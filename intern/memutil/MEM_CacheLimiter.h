@@ -139,7 +139,7 @@ public:
 	typedef int    (*MEM_CacheLimiter_ItemPriority_Func) (void *item, int default_priority);
 
 	MEM_CacheLimiter(MEM_CacheLimiter_DataSize_Func getDataSize_)
-		: getDataSize(getDataSize_) {
+		: getDataSize(getDataSize_), getItemPriority(NULL) {
 	}
 
 	~MEM_CacheLimiter() {
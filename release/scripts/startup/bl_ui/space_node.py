@@ -266,10 +266,12 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(tree, "render_quality", text="Render")
         col.prop(tree, "edit_quality", text="Edit")
         col.prop(tree, "chunk_size")
+        col.prop(tree, "buffer_memory_limit")
 
         col = layout.column()
         col.prop(tree, "use_opencl")
         col.prop(tree, "use_groupnode_buffer")
+        col.prop(tree, "use_half_float_buffers")
         col.prop(tree, "two_pass")
         col.prop(tree, "use_viewer_border")
         col.prop(snode, "show_highlight")
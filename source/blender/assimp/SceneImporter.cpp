@@ -130,6 +130,29 @@ void SceneImporter::configure_importer()
 
 	// do not generate skeleton meshes, Blender's armature viz does the same job much better
 	importer.SetPropertyInteger(AI_CONFIG_IMPORT_NO_SKELETON_MESHES,1);
+
+	if (settings.validate == 2) {
+		importer.SetPropertyInteger(AI_CONFIG_PP_VDS_TRUSTED_LOADER,1);
+	}
+
+	// if assimp's log is piped to the reports, include the time spent in each stage
+	if (settings.enableAssimpLog) {
+		importer.SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,1);
+	}
+
+	// let the loaders skip the parts of the file we don't convert anyway,
+	// rather than reading and post-processing them first.
+	importer.SetPropertyInteger(AI_CONFIG_IMPORT_FBX_READ_ANIMATIONS,settings.read_animations);
+	importer.SetPropertyInteger(AI_CONFIG_IMPORT_FBX_READ_CAMERAS,settings.read_cameras);
+	importer.SetPropertyInteger(AI_CONFIG_IMPORT_FBX_READ_LIGHTS,settings.read_lights);
+	importer.SetPropertyInteger(AI_CONFIG_IMPORT_FBX_READ_MATERIALS,settings.read_materials);
+
+	if (settings.node_filter) {
+		importer.SetPropertyString(AI_CONFIG_IMPORT_NODE_FILTER,settings.node_filter);
+	}
+	if (settings.animation_filter) {
+		importer.SetPropertyString(AI_CONFIG_IMPORT_ANIMATION_FILTER,settings.animation_filter);
+	}
 }
 
 
@@ -147,9 +170,9 @@ unsigned int SceneImporter::get_assimp_flags() const
 		flags |= aiProcess_Triangulate;
 	}
 
-#ifdef _DEBUG
-	flags |= aiProcess_ValidateDataStructure;
-#endif
+	if (settings.validate) {
+		flags |= aiProcess_ValidateDataStructure;
+	}
 
 	return flags;
 }
@@ -98,6 +98,15 @@ extern "C"
 		defaults_out->read_cameras = 1;
 		defaults_out->read_lights = 1;
 		defaults_out->read_materials = 1;
+
+		defaults_out->node_filter = NULL;
+		defaults_out->animation_filter = NULL;
+
+#ifdef _DEBUG
+		defaults_out->validate = 1;
+#else
+		defaults_out->validate = 0;
+#endif
 	}
 
 
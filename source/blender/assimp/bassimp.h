@@ -74,6 +74,20 @@ extern "C" {
 		int read_armature;
 		int read_materials;
 
+		/* validate the imported data structure before converting it:
+		 *  0 - no validation
+		 *  1 - full validation
+		 *  2 - structural checks only, much cheaper for loaders that are trusted */
+		int validate;
+
+		/* partial import: space-separated lists of the names of the nodes
+		 * (which are imported with all their children) and animations to
+		 * be read, names containing spaces are enclosed in single quotes.
+		 * NULL or an empty string import everything. Loaders which support
+		 * this (FBX, OBJ, IFC) don't read the rest of the file at all. */
+		const char* node_filter;
+		const char* animation_filter;
+
 	} bassimp_import_settings;
 
 
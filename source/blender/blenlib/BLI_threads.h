@@ -68,6 +68,8 @@ void BLI_end_threaded_malloc(void);
 /* System Information */
 
 int     BLI_system_thread_count(void); /* gets the number of threads the system can make use of */
+void    BLI_system_num_threads_override_set(int num); /* overrides the system thread count, 0 to disable */
+int     BLI_system_num_threads_override_get(void);
 
 /* Global Mutex Locks
  * 
@@ -121,6 +123,16 @@ void BLI_rw_mutex_lock(ThreadRWMutex *mutex, int mode);
 void BLI_rw_mutex_unlock(ThreadRWMutex *mutex);
 void BLI_rw_mutex_end(ThreadRWMutex *mutex);
 
+/* Condition */
+
+typedef pthread_cond_t ThreadCondition;
+
+void BLI_condition_init(ThreadCondition *cond);
+void BLI_condition_wait(ThreadCondition *cond, ThreadMutex *mutex);
+void BLI_condition_notify_one(ThreadCondition *cond);
+void BLI_condition_notify_all(ThreadCondition *cond);
+void BLI_condition_end(ThreadCondition *cond);
+
 /* ThreadedWorker
  *
  * A simple tool for dispatching work to a limited number of threads
@@ -302,9 +302,15 @@ void BLI_end_threads(ListBase *threadbase)
 /* System Information */
 
 /* how many threads are native on this system? */
+static int num_threads_override = 0;
+
 int BLI_system_thread_count(void)
 {
 	int t;
+
+	if (num_threads_override > 0)
+		return num_threads_override;
+
 #ifdef WIN32
 	SYSTEM_INFO info;
 	GetSystemInfo(&info);
@@ -331,6 +337,16 @@ int BLI_system_thread_count(void)
 	return t;
 }
 
+void BLI_system_num_threads_override_set(int num)
+{
+	num_threads_override = num;
+}
+
+int BLI_system_num_threads_override_get(void)
+{
+	return num_threads_override;
+}
+
 /* Global Mutex Locks */
 
 void BLI_lock_thread(int type)
@@ -464,6 +480,33 @@ void BLI_rw_mutex_end(ThreadRWMutex *mutex)
 	pthread_rwlock_destroy(mutex);
 }
 
+/* Condition */
+
+void BLI_condition_init(ThreadCondition *cond)
+{
+	pthread_cond_init(cond, NULL);
+}
+
+void BLI_condition_wait(ThreadCondition *cond, ThreadMutex *mutex)
+{
+	pthread_cond_wait(cond, mutex);
+}
+
+void BLI_condition_notify_one(ThreadCondition *cond)
+{
+	pthread_cond_signal(cond);
+}
+
+void BLI_condition_notify_all(ThreadCondition *cond)
+{
+	pthread_cond_broadcast(cond);
+}
+
+void BLI_condition_end(ThreadCondition *cond)
+{
+	pthread_cond_destroy(cond);
+}
+
 /* ************************************************ */
 
 typedef struct ThreadedWorker {
@@ -226,6 +226,9 @@ extern "C" {
  * for a specific Device.
  * the work-scheduler will find work for the device and the device will be asked to execute the WorkPackage
  *
+ * Every CPU thread has its own queue. Neighbouring chunks are placed in the same queue, so a thread reuses the
+ * input data it has just read. A thread without work steals from the end of the queues of the other threads.
+ *
  * @subsection singlethread Single threaded
  * For debugging reasons the multi-threading can be disabled. This is done by changing the COM_CURRENT_THREADING_MODEL
  * to COM_TM_NOTHREAD. When compiling the work-scheduler
@@ -72,7 +72,9 @@ typedef enum CompositorPriority {
 
 // workscheduler threading models
 /**
- * COM_TM_QUEUE is a multithreaded model, which uses the BLI_thread_queue pattern. This is the default option.
+ * COM_TM_QUEUE is a multithreaded model, every CPU thread has its own work queue and steals work from the
+ * queues of the other threads when its own queue is empty. OpenCL devices use the BLI_thread_queue pattern.
+ * This is the default option.
  */
 #define COM_TM_QUEUE 1
 
@@ -107,6 +109,33 @@ typedef enum OrderOfChunks {
 
 #define COM_NUMBER_OF_CHANNELS 4
 
+/**
+ * @brief maximum number of pixels an executeRow implementation processes at once.
+ * longer rows are split into spans of this size, so the input spans fit in stack buffers.
+ */
+#define COM_ROW_SPAN 64
+
+/**
+ * @brief maximum number of pixel kernels that are fused into a single FusedOperation
+ */
+#define COM_FUSION_MAX_OPERATIONS 32
+
+/**
+ * @brief maximum number of inputs of a pixel kernel that can be fused
+ */
+#define COM_FUSION_MAX_ARGUMENTS 4
+
 #define COM_BLUR_BOKEH_PIXELS 512
 
+/**
+ * @brief minimum width and height of a kernel that is convolved with FFTConvolution
+ */
+#define COM_FFT_CONVOLUTION_MIN_SIZE 32
+
+/**
+ * @brief minimum radius of a gaussian blur that is calculated with the recursive (IIR) filter
+ * instead of the kernel, the cost of the recursive filter does not depend on the radius
+ */
+#define COM_BLUR_RECURSIVE_MIN_RADIUS 64
+
 #endif
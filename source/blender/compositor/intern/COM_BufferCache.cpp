@@ -0,0 +1,162 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <map>
+#include <string.h>
+
+#include "COM_BufferCache.h"
+#include "COM_MemoryBuffer.h"
+#include "MEM_guardedalloc.h"
+#include "MEM_CacheLimiterC-Api.h"
+
+using std::map;
+
+/* 64 bit FNV-1a, with an extra shift when hashing words */
+#define CACHE_KEY_OFFSET 0xcbf29ce484222325ULL
+#define CACHE_KEY_PRIME 0x100000001b3ULL
+
+CacheKey::CacheKey()
+{
+	this->m_hash = CACHE_KEY_OFFSET;
+}
+
+void CacheKey::addData(const void *data, size_t size)
+{
+	const unsigned char *bytes = (const unsigned char *)data;
+	uint64_t hash = this->m_hash;
+	size_t i = 0;
+
+	/* large data (image buffers) is hashed in words */
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, &bytes[i], sizeof(uint64_t));
+		hash ^= word;
+		hash *= CACHE_KEY_PRIME;
+		hash ^= hash >> 32;
+	}
+	for (; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= CACHE_KEY_PRIME;
+	}
+	this->m_hash = hash;
+}
+
+void CacheKey::addString(const char *string)
+{
+	this->addData(string, strlen(string) + 1);
+}
+
+typedef struct BufferCacheItem {
+	uint64_t key;
+	MemoryBuffer *buffer;
+	MEM_CacheLimiterHandleC *handle;
+} BufferCacheItem;
+
+static MEM_CacheLimiterC *s_limiter = NULL;
+static map<uint64_t, BufferCacheItem *> s_items;
+
+/* called by the cache limiter when the item is freed to stay within the memory limit */
+static void buffer_cache_destructor(void *data)
+{
+	BufferCacheItem *item = (BufferCacheItem *)data;
+
+	s_items.erase(item->key);
+	delete item->buffer;
+	MEM_freeN(item);
+}
+
+/* free an item that is still managed by the cache limiter */
+static void buffer_cache_free(BufferCacheItem *item)
+{
+	MEM_CacheLimiter_unmanage(item->handle);
+	buffer_cache_destructor(item);
+}
+
+static size_t buffer_cache_size(void *data)
+{
+	BufferCacheItem *item = (BufferCacheItem *)data;
+	return sizeof(BufferCacheItem) + sizeof(MemoryBuffer) + item->buffer->getMemorySize();
+}
+
+static int buffer_cache_priority(void *data, int default_priority)
+{
+	/* least recently used first, skips the buffers that are in use */
+	return default_priority;
+}
+
+bool BufferCache::restore(uint64_t key, MemoryBuffer *buffer)
+{
+	map<uint64_t, BufferCacheItem *>::iterator found = s_items.find(key);
+
+	if (found == s_items.end()) {
+		return false;
+	}
+
+	BufferCacheItem *item = found->second;
+	if (item->buffer->getWidth() != buffer->getWidth() || item->buffer->getHeight() != buffer->getHeight()) {
+		return false;
+	}
+
+	/* converts the data when the precision of the buffers changed in between */
+	buffer->copyContentFrom(item->buffer);
+	MEM_CacheLimiter_touch(item->handle);
+	return true;
+}
+
+void BufferCache::store(uint64_t key, MemoryBuffer *buffer)
+{
+	const size_t size = buffer->getMemorySize();
+	const size_t maximum = MEM_CacheLimiter_get_maximum();
+
+	/* a maximum of 0 means the memory is not limited */
+	if (size == 0 || (maximum != 0 && size > maximum)) {
+		return;
+	}
+
+	if (s_limiter == NULL) {
+		s_limiter = new_MEM_CacheLimiter(buffer_cache_destructor, buffer_cache_size);
+		MEM_CacheLimiter_ItemPriority_Func_set(s_limiter, buffer_cache_priority);
+	}
+
+	map<uint64_t, BufferCacheItem *>::iterator found = s_items.find(key);
+	if (found != s_items.end()) {
+		buffer_cache_free(found->second);
+	}
+
+	BufferCacheItem *item = (BufferCacheItem *)MEM_mallocN(sizeof(BufferCacheItem), "COM:BufferCacheItem");
+	item->key = key;
+	item->buffer = buffer->duplicate();
+	s_items[key] = item;
+
+	item->handle = MEM_CacheLimiter_insert(s_limiter, item);
+	MEM_CacheLimiter_ref(item->handle);
+	MEM_CacheLimiter_enforce_limits(s_limiter);
+	MEM_CacheLimiter_unref(item->handle);
+}
+
+void BufferCache::clear()
+{
+	while (!s_items.empty()) {
+		buffer_cache_free(s_items.begin()->second);
+	}
+
+	if (s_limiter) {
+		delete_MEM_CacheLimiter(s_limiter);
+		s_limiter = NULL;
+	}
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_BufferCache_h
+#define _COM_BufferCache_h
+
+#include <stddef.h>
+#include "BLO_sys_types.h"
+
+class MemoryBuffer;
+
+/**
+ * @brief hash of everything the result of an operation depends on
+ *
+ * The key of an operation contains the settings of the operation and its bNode, the resolution
+ * and the keys of its inputs. Two operations with the same key calculate the same pixels.
+ *
+ * Only the 64 bit hash is kept, the settings are not compared when a buffer is restored. A lookup
+ * matches one of the n cached buffers by accident with a chance of about n / 2^64, which is
+ * negligible for the few hundred buffers that fit in the cache limit. Such a collision would
+ * restore the buffer of another operation.
+ * @see BufferCache
+ * @ingroup Memory
+ */
+class CacheKey {
+private:
+	uint64_t m_hash;
+
+public:
+	CacheKey();
+
+	void addData(const void *data, size_t size);
+	void addString(const char *string);
+	void addInt(int value) { this->addData(&value, sizeof(value)); }
+	void addFloat(float value) { this->addData(&value, sizeof(value)); }
+	void addKey(uint64_t key) { this->addData(&key, sizeof(key)); }
+
+	/**
+	 * @brief get the key, never returns 0 so 0 can be used for results that can not be cached
+	 */
+	uint64_t get() const { return this->m_hash ? this->m_hash : 1; }
+};
+
+/**
+ * @brief keeps the output buffers of ExecutionGroups between executions of the compositor
+ *
+ * When a node is changed during editing only the operations that depend on it need to be
+ * calculated again, the buffers of the unchanged part of the tree are copied from this cache.
+ * The memory used by the cache is limited by MEM_CacheLimiter, the least recently used buffers
+ * are freed first.
+ * @note not thread safe, the cache is only used while holding the compositor mutex.
+ * @ingroup Memory
+ */
+class BufferCache {
+public:
+	/**
+	 * @brief copy the cached buffer of a key into a buffer
+	 * @return true when the key was found and the cached buffer has the same size
+	 */
+	static bool restore(uint64_t key, MemoryBuffer *buffer);
+
+	/**
+	 * @brief store a copy of a buffer, replaces an earlier buffer with the same key
+	 */
+	static void store(uint64_t key, MemoryBuffer *buffer);
+
+	/**
+	 * @brief free all cached buffers
+	 */
+	static void clear();
+};
+
+#endif
@@ -22,6 +22,8 @@
 
 #include "COM_CPUDevice.h"
 
+#include "PIL_time.h"
+
 void CPUDevice::execute(WorkPackage *work)
 {
 	const unsigned int chunkNumber = work->getChunkNumber();
@@ -30,7 +32,9 @@ void CPUDevice::execute(WorkPackage *work)
 
 	executionGroup->determineChunkRect(&rect, chunkNumber);
 
+	const double startTime = PIL_check_seconds_timer();
 	executionGroup->getOutputNodeOperation()->executeRegion(&rect, chunkNumber);
+	executionGroup->setChunkExecutionTimes(chunkNumber, startTime, PIL_check_seconds_timer());
 
 	executionGroup->finalizeChunkExecution(chunkNumber, NULL);
 }
@@ -180,6 +180,16 @@ public:
 	void setFastCalculation(bool fastCalculation) {this->m_fastCalculation = fastCalculation;}
 	bool isFastCalculation() {return this->m_fastCalculation;}
 	inline bool isGroupnodeBufferEnabled() {return this->getbNodeTree()->flag & NTREE_COM_GROUPNODE_BUFFER;}
+
+	/**
+	 * @brief are intermediate buffers stored as half floats
+	 */
+	inline bool isHalfFloatBufferEnabled() { return (this->getbNodeTree()->flag & NTREE_COM_HALF_FLOAT_BUFFERS) != 0; }
+
+	/**
+	 * @brief get the memory in bytes intermediate buffers can use before they are stored in scratch files, 0 is unlimited
+	 */
+	size_t getBufferMemoryLimit() { return (size_t)this->getbNodeTree()->buffer_memory_limit * 1024 * 1024; }
 };
 
 
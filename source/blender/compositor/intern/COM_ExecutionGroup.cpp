@@ -51,6 +51,8 @@ ExecutionGroup::ExecutionGroup()
 	this->m_isOutput = false;
 	this->m_complex = false;
 	this->m_chunkExecutionStates = NULL;
+	this->m_chunkStartTimes = NULL;
+	this->m_chunkEndTimes = NULL;
 	this->m_bTree = NULL;
 	this->m_height = 0;
 	this->m_width = 0;
@@ -164,6 +166,8 @@ void ExecutionGroup::initExecution()
 		for (index = 0; index < this->m_numberOfChunks; index++) {
 			this->m_chunkExecutionStates[index] = COM_ES_NOT_SCHEDULED;
 		}
+		this->m_chunkStartTimes = (double *)MEM_callocN(sizeof(double) * this->m_numberOfChunks, __func__);
+		this->m_chunkEndTimes = (double *)MEM_callocN(sizeof(double) * this->m_numberOfChunks, __func__);
 	}
 
 
@@ -188,6 +192,12 @@ void ExecutionGroup::deinitExecution()
 		MEM_freeN(this->m_chunkExecutionStates);
 		this->m_chunkExecutionStates = NULL;
 	}
+	if (this->m_chunkStartTimes != NULL) {
+		MEM_freeN(this->m_chunkStartTimes);
+		MEM_freeN(this->m_chunkEndTimes);
+		this->m_chunkStartTimes = NULL;
+		this->m_chunkEndTimes = NULL;
+	}
 	this->m_numberOfChunks = 0;
 	this->m_numberOfXChunks = 0;
 	this->m_numberOfYChunks = 0;
@@ -444,6 +454,46 @@ void ExecutionGroup::printBackgroundStats(void)
 	fflush(stdout);
 }
 
+void ExecutionGroup::setChunkExecutionTimes(unsigned int chunkNumber, double startTime, double endTime)
+{
+	/* every chunk is executed by a single thread */
+	this->m_chunkStartTimes[chunkNumber] = startTime;
+	this->m_chunkEndTimes[chunkNumber] = endTime;
+}
+
+void ExecutionGroup::determineExecutionTimes(int *r_numberOfChunks, double *r_numberOfPixels, double *r_cpuTime, double *r_wallTime)
+{
+	double firstStartTime = 0.0;
+	double lastEndTime = 0.0;
+
+	*r_numberOfChunks = 0;
+	*r_numberOfPixels = 0.0;
+	*r_cpuTime = 0.0;
+
+	for (unsigned int chunkNumber = 0; chunkNumber < this->m_numberOfChunks; chunkNumber++) {
+		const double startTime = this->m_chunkStartTimes[chunkNumber];
+		const double endTime = this->m_chunkEndTimes[chunkNumber];
+		if (endTime == 0.0) {
+			continue;
+		}
+
+		rcti rect;
+		determineChunkRect(&rect, chunkNumber);
+		*r_numberOfPixels += (double)BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+		*r_cpuTime += endTime - startTime;
+
+		if (*r_numberOfChunks == 0 || startTime < firstStartTime) {
+			firstStartTime = startTime;
+		}
+		if (endTime > lastEndTime) {
+			lastEndTime = endTime;
+		}
+		(*r_numberOfChunks)++;
+	}
+
+	*r_wallTime = lastEndTime - firstStartTime;
+}
+
 void ExecutionGroup::finalizeChunkExecution(int chunkNumber, MemoryBuffer **memoryBuffers)
 {
 	if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_SCHEDULED)
@@ -473,6 +523,26 @@ void ExecutionGroup::finalizeChunkExecution(int chunkNumber, MemoryBuffer **memo
 	}
 }
 
+void ExecutionGroup::markExecuted()
+{
+	for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+		this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+	}
+}
+
+bool ExecutionGroup::isExecuted() const
+{
+	if (this->m_numberOfChunks == 0) {
+		return false;
+	}
+	for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+		if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+			return false;
+		}
+	}
+	return true;
+}
+
 inline void ExecutionGroup::determineChunkRect(rcti *rect, const unsigned int xChunk, const unsigned int yChunk) const
 {
 	const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
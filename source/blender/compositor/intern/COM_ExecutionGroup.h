@@ -150,6 +150,13 @@ private:
 	 *   - COM_ES_EXECUTED: executed
 	 */
 	ChunkExecutionState *m_chunkExecutionStates;
+
+	/**
+	 * @brief start and end time of the execution of every chunk, 0 for chunks that were not executed
+	 * @see setChunkExecutionTimes
+	 */
+	double *m_chunkStartTimes;
+	double *m_chunkEndTimes;
 	
 	/**
 	 * @brief indicator when this ExecutionGroup has valid NodeOperations in its vector for Execution
@@ -352,6 +359,26 @@ public:
 	 */
 	void printBackgroundStats(void);
 	
+	/**
+	 * @brief store when the execution of a chunk started and ended, used for profiling
+	 * @see ExecutionSystem.printProfile
+	 */
+	void setChunkExecutionTimes(unsigned int chunkNumber, double startTime, double endTime);
+
+	/**
+	 * @brief get the timing of the chunks executed since initExecution
+	 * @param r_numberOfChunks number of executed chunks
+	 * @param r_numberOfPixels number of pixels in the executed chunks
+	 * @param r_cpuTime sum of the execution times of the chunks, over all threads
+	 * @param r_wallTime time from the start of the first chunk to the end of the last chunk
+	 */
+	void determineExecutionTimes(int *r_numberOfChunks, double *r_numberOfPixels, double *r_cpuTime, double *r_wallTime);
+
+	/**
+	 * @brief get the operations of this ExecutionGroup
+	 */
+	const vector<NodeOperation *> &getOperations() const { return this->m_operations; }
+
 	/**
 	 * @brief after a chunk is executed the needed resources can be freed or unlocked.
 	 * @param chunknumber
@@ -359,6 +386,18 @@ public:
 	 */
 	void finalizeChunkExecution(int chunkNumber, MemoryBuffer **memoryBuffers);
 	
+	/**
+	 * @brief mark all chunks as executed
+	 * @note used when the output buffer is restored from the BufferCache, the operations of this
+	 * ExecutionGroup and the ExecutionGroups it reads from will not be scheduled.
+	 */
+	void markExecuted();
+
+	/**
+	 * @brief have all chunks of this ExecutionGroup been executed
+	 */
+	bool isExecuted() const;
+
 	/**
 	 * @brief deinitExecution is called just after execution the whole graph.
 	 * @note It will release all needed resources
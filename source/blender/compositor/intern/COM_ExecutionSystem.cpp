@@ -23,11 +23,18 @@
 #include "COM_ExecutionSystem.h"
 
 #include <sstream>
+#include <algorithm>
+#include <typeinfo>
+#include <set>
 
 #include "PIL_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_threads.h"
 extern "C" {
 #include "BKE_node.h"
+#include "DNA_color_types.h"
+#include "DNA_image_types.h"
+#include "DNA_texture_types.h"
 }
 
 #include "COM_Converter.h"
@@ -40,12 +47,13 @@ extern "C" {
 #include "COM_WriteBufferOperation.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_ExecutionSystemHelper.h"
+#include "COM_FusedOperation.h"
+#include "COM_BufferCache.h"
+#include "COM_MemoryBuffer.h"
 
 #include "BKE_global.h"
 
-#ifdef WITH_CXX_GUARDEDALLOC
 #include "MEM_guardedalloc.h"
-#endif
 
 ExecutionSystem::ExecutionSystem(RenderData *rd, bNodeTree *editingtree, bool rendering, bool fastcalculation,
                                  const ColorManagedViewSettings *viewSettings, const ColorManagedDisplaySettings *displaySettings)
@@ -80,7 +88,9 @@ ExecutionSystem::ExecutionSystem(RenderData *rd, bNodeTree *editingtree, bool re
 	this->m_context.setDisplaySettings(displaySettings);
 
 	this->convertToOperations();
+	this->fuseOperations(); /* fuse chains of pixel kernels */
 	this->groupOperations(); /* group operations in ExecutionGroups */
+	this->determineBufferPrecisions();
 	unsigned int index;
 	unsigned int resolution[2];
 
@@ -154,11 +164,21 @@ void ExecutionSystem::execute()
 		}
 	}
 	unsigned int index;
+	const double executionStartTime = PIL_check_seconds_timer();
+	vector<double> initializationTimes(this->m_operations.size(), 0.0);
+
+	if (G.debug & G_DEBUG_COMPOSITOR) {
+		MEM_reset_peak_memory();
+	}
+
+	determineBufferStorage();
 
 	for (index = 0; index < this->m_operations.size(); index++) {
 		NodeOperation *operation = this->m_operations[index];
+		const double startTime = PIL_check_seconds_timer();
 		operation->setbNodeTree(this->m_context.getbNodeTree());
 		operation->initExecution();
+		initializationTimes[index] = PIL_check_seconds_timer() - startTime;
 	}
 	for (index = 0; index < this->m_operations.size(); index++) {
 		NodeOperation *operation = this->m_operations[index];
@@ -173,6 +193,8 @@ void ExecutionSystem::execute()
 		executionGroup->initExecution();
 	}
 
+	restoreCachedBuffers();
+
 	WorkScheduler::start(this->m_context);
 
 	executeGroups(COM_PRIORITY_HIGH);
@@ -184,6 +206,12 @@ void ExecutionSystem::execute()
 	WorkScheduler::finish();
 	WorkScheduler::stop();
 
+	storeCachedBuffers();
+
+	if (G.debug & G_DEBUG_COMPOSITOR) {
+		printProfile(initializationTimes, PIL_check_seconds_timer() - executionStartTime);
+	}
+
 	for (index = 0; index < this->m_operations.size(); index++) {
 		NodeOperation *operation = this->m_operations[index];
 		operation->deinitExecution();
@@ -295,9 +323,19 @@ void ExecutionSystem::convertToOperations()
 	unsigned int index;
 	for (index = 0; index < this->m_nodes.size(); index++) {
 		Node *node = (Node *)this->m_nodes[index];
+		const unsigned int first = this->m_operations.size();
 		node->convertToOperations(this, &this->m_context);
 
 		debug_check_node_connections(node);
+
+		/* remember where the operations come from, used by the cache keys */
+		for (unsigned int i = first; i < this->m_operations.size(); i++) {
+			NodeOperation *operation = this->m_operations[i];
+			if (operation->getbNode() == NULL) {
+				operation->setbNode(node->getbNode());
+			}
+			this->m_nodeOperationIndices[operation] = i - first;
+		}
 	}
 
 	for (index = 0; index < this->m_connections.size(); index++) {
@@ -340,6 +378,97 @@ void ExecutionSystem::convertToOperations()
 	}
 }
 
+/* can the operation be evaluated as part of a FusedOperation */
+static bool is_fusable_kernel(NodeOperation *operation)
+{
+	if (!operation->isPixelKernel() ||
+	    operation->getNumberOfOutputSockets() != 1 ||
+	    operation->getNumberOfInputSockets() > COM_FUSION_MAX_ARGUMENTS)
+	{
+		return false;
+	}
+	for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+		if (!operation->getInputSocket(index)->isConnected()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* can operation be fused into the operation that reads it */
+static bool is_fusable_input(NodeOperation *reader, NodeOperation *operation)
+{
+	if (!is_fusable_kernel(operation) || operation->getOutputSocket()->getNumberOfConnections() != 1) {
+		return false;
+	}
+	/* operations without inputs are constant, their resolution doesn't matter */
+	if (operation->getNumberOfInputSockets() == 0) {
+		return true;
+	}
+	return operation->getWidth() == reader->getWidth() && operation->getHeight() == reader->getHeight();
+}
+
+/* collect the chain ending in operation, inputs are added before the operations reading them */
+static void fuse_collect_chain(NodeOperation *operation, vector<NodeOperation *> &chain, int *r_tot)
+{
+	for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+		NodeOperation *input = operation->getInputSocket(index)->getOperation();
+		if (*r_tot < COM_FUSION_MAX_OPERATIONS && is_fusable_input(operation, input)) {
+			(*r_tot)++;
+			fuse_collect_chain(input, chain, r_tot);
+		}
+	}
+	chain.push_back(operation);
+}
+
+void ExecutionSystem::fuseOperations()
+{
+	/* iterate over a copy, the fused operations are removed from the system */
+	vector<NodeOperation *> operations = this->m_operations;
+	unsigned int index;
+
+	for (index = 0; index < operations.size(); index++) {
+		NodeOperation *operation = operations[index];
+
+		if (!is_fusable_kernel(operation) || operation->getNumberOfInputSockets() == 0) {
+			continue;
+		}
+
+		/* only start at the end of a chain, the other operations are collected from there */
+		OutputSocket *outputSocket = operation->getOutputSocket();
+		if (outputSocket->getNumberOfConnections() == 1) {
+			NodeOperation *reader = (NodeOperation *)outputSocket->getConnection(0)->getToNode();
+			if (is_fusable_kernel(reader) && is_fusable_input(reader, operation)) {
+				continue;
+			}
+		}
+
+		vector<NodeOperation *> chain;
+		int tot = 1;
+		fuse_collect_chain(operation, chain, &tot);
+		if (chain.size() < 2) {
+			continue;
+		}
+
+		FusedOperation *fusedOperation = new FusedOperation();
+		fusedOperation->setbNodeTree(this->m_context.getbNodeTree());
+		for (vector<NodeOperation *>::iterator iter = chain.begin(); iter != chain.end(); ++iter) {
+			(*iter)->setbNodeTree(this->m_context.getbNodeTree());
+			this->m_operations.erase(find(this->m_operations.begin(), this->m_operations.end(), *iter));
+		}
+		fusedOperation->fuse(chain);
+		this->addOperation(fusedOperation);
+
+		if (G.debug & G_DEBUG) {
+			printf("Compositor: fused %d operations into O_%p:", (int)chain.size(), fusedOperation);
+			for (vector<NodeOperation *>::iterator iter = chain.begin(); iter != chain.end(); ++iter) {
+				printf(" O_%p", *iter);
+			}
+			printf("\n");
+		}
+	}
+}
+
 void ExecutionSystem::groupOperations()
 {
 	vector<NodeOperation *> outputOperations;
@@ -362,6 +491,474 @@ void ExecutionSystem::groupOperations()
 	}
 }
 
+/* find the buffers that are read by complex operations */
+static void find_complex_read_proxies(const vector<NodeOperation *> &operations, set<MemoryProxy *> &r_proxies)
+{
+	for (unsigned int index = 0; index < operations.size(); index++) {
+		NodeOperation *operation = operations[index];
+		if (!operation->isReadBufferOperation()) {
+			continue;
+		}
+		ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+		OutputSocket *outputSocket = readOperation->getOutputSocket();
+		for (unsigned int connectionIndex = 0; connectionIndex < outputSocket->getNumberOfConnections(); connectionIndex++) {
+			NodeOperation *reader = (NodeOperation *)outputSocket->getConnection(connectionIndex)->getToNode();
+			if (reader->isComplex()) {
+				r_proxies.insert(readOperation->getMemoryProxy());
+			}
+		}
+	}
+}
+
+void ExecutionSystem::determineBufferPrecisions()
+{
+	if (!this->m_context.isHalfFloatBufferEnabled()) {
+		return;
+	}
+
+	/* buffers that are read by complex operations stay float */
+	set<MemoryProxy *> floatProxies;
+	find_complex_read_proxies(this->m_operations, floatProxies);
+
+	unsigned int index;
+	int numberOfHalfFloatBuffers = 0;
+	for (index = 0; index < this->m_operations.size(); index++) {
+		NodeOperation *operation = this->m_operations[index];
+		if (operation->isWriteBufferOperation()) {
+			MemoryProxy *memoryProxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+			const bool halfFloat = (floatProxies.find(memoryProxy) == floatProxies.end());
+			memoryProxy->setHalfFloat(halfFloat);
+			numberOfHalfFloatBuffers += halfFloat;
+		}
+	}
+
+	if (G.debug & G_DEBUG) {
+		printf("Compositor: %d buffers stored as half floats\n", numberOfHalfFloatBuffers);
+	}
+}
+
+void ExecutionSystem::determineBufferStorage()
+{
+	vector<WriteBufferOperation *> writeOperations;
+	unsigned int index;
+
+	for (index = 0; index < this->m_operations.size(); index++) {
+		NodeOperation *operation = this->m_operations[index];
+		if (operation->isWriteBufferOperation()) {
+			WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+			writeOperation->readDataTypeFromInputSocket();
+			writeOperation->getMemoryProxy()->setStoredInScratchFile(false);
+			writeOperations.push_back(writeOperation);
+		}
+	}
+
+	const size_t memoryLimit = this->m_context.getBufferMemoryLimit();
+	if (memoryLimit == 0) {
+		return;
+	}
+
+	set<MemoryProxy *> complexReadProxies;
+	find_complex_read_proxies(this->m_operations, complexReadProxies);
+
+	size_t memoryInUse = 0;
+	int numberOfScratchFiles = 0;
+	size_t scratchFileSize = 0;
+
+	/* first pass keeps the buffers read by complex operations in memory, second pass the others */
+	for (int pass = 0; pass < 2; pass++) {
+		for (index = 0; index < writeOperations.size(); index++) {
+			WriteBufferOperation *writeOperation = writeOperations[index];
+			MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+			const bool complexRead = (complexReadProxies.find(memoryProxy) != complexReadProxies.end());
+			if (complexRead != (pass == 0)) {
+				continue;
+			}
+
+			const size_t elementSize = memoryProxy->isHalfFloat() ? sizeof(unsigned short) : sizeof(float);
+			const size_t size = elementSize * MemoryBuffer::determineNumberOfChannels(memoryProxy->getDataType()) *
+			                    writeOperation->getWidth() * writeOperation->getHeight();
+
+			if (memoryInUse + size <= memoryLimit) {
+				memoryInUse += size;
+			}
+			else {
+				memoryProxy->setStoredInScratchFile(true);
+				numberOfScratchFiles++;
+				scratchFileSize += size;
+			}
+		}
+	}
+
+	if (G.debug & G_DEBUG) {
+		printf("Compositor: %d buffers (%.2fM) in memory, %d buffers (%.2fM) in scratch files\n",
+		       (int)writeOperations.size() - numberOfScratchFiles, memoryInUse / (1024.0 * 1024.0),
+		       numberOfScratchFiles, scratchFileSize / (1024.0 * 1024.0));
+	}
+}
+
+/* print the node and the type of an operation, for example "Blur/GaussianXBlurOperation" */
+static void profile_print_operation(NodeOperation *operation)
+{
+	const char *typeName = typeid(*operation).name();
+	bNode *node = operation->getbNode();
+
+	/* skip the length of the name (gcc, clang) or the "class " prefix (msvc) */
+	while (*typeName >= '0' && *typeName <= '9') {
+		typeName++;
+	}
+	if (STREQLEN(typeName, "class ", 6)) {
+		typeName += 6;
+	}
+
+	printf("%s/%s", node ? node->name : "-", typeName);
+
+	if (typeid(*operation) == typeid(FusedOperation)) {
+		const vector<NodeOperation *> &fusedOperations = ((FusedOperation *)operation)->getFusedOperations();
+		printf("[");
+		for (unsigned int index = 0; index < fusedOperations.size(); index++) {
+			if (index) {
+				printf(" ");
+			}
+			profile_print_operation(fusedOperations[index]);
+		}
+		printf("]");
+	}
+}
+
+static bool profile_compare_times(const pair<double, NodeOperation *> &a, const pair<double, NodeOperation *> &b)
+{
+	return a.first > b.first;
+}
+
+void ExecutionSystem::printProfile(const vector<double> &initializationTimes, double executionTime)
+{
+	const bNodeTree *bTree = this->m_context.getbNodeTree();
+	const RenderData *rd = this->m_context.getRenderData();
+	unsigned int index;
+
+	printf("Compositor profile: tree %s, %dx%d, %d threads, chunk size %d%s\n",
+	       bTree->id.name + 2, rd->xsch * rd->size / 100, rd->ysch * rd->size / 100,
+	       WorkScheduler::getNumberOfCPUDevices(), this->m_context.getChunksize(),
+	       this->m_context.isFastCalculation() ? ", fast calculation" : "");
+	printf("  group  chunks  megapixels  cpu time (s)  wall time (s)  Mpix/s  operations\n");
+
+	for (index = 0; index < this->m_groups.size(); index++) {
+		ExecutionGroup *group = this->m_groups[index];
+		int numberOfChunks;
+		double numberOfPixels, cpuTime, wallTime;
+
+		group->determineExecutionTimes(&numberOfChunks, &numberOfPixels, &cpuTime, &wallTime);
+		if (numberOfChunks == 0) {
+			continue;
+		}
+
+		printf("  %5u  %6d  %10.2f  %12.3f  %13.3f  %6.2f ", index, numberOfChunks, numberOfPixels / 1e6,
+		       cpuTime, wallTime, wallTime > 0.0 ? numberOfPixels / 1e6 / wallTime : 0.0);
+
+		/* operations are added from the output, print them in the order they are evaluated */
+		const vector<NodeOperation *> &operations = group->getOperations();
+		for (int operationIndex = operations.size() - 1; operationIndex >= 0; operationIndex--) {
+			NodeOperation *operation = operations[operationIndex];
+			if (!operation->isReadBufferOperation() && !operation->isWriteBufferOperation()) {
+				printf(" ");
+				profile_print_operation(operation);
+			}
+		}
+		printf("\n");
+	}
+
+	/* the slowest initializations, complex operations can calculate their whole result there */
+	vector<pair<double, NodeOperation *> > slowest;
+	for (index = 0; index < this->m_operations.size(); index++) {
+		if (initializationTimes[index] >= 0.001) {
+			slowest.push_back(make_pair(initializationTimes[index], this->m_operations[index]));
+		}
+	}
+	sort(slowest.begin(), slowest.end(), profile_compare_times);
+	for (index = 0; index < slowest.size() && index < 10; index++) {
+		printf("  initialization %.3f s ", slowest[index].first);
+		profile_print_operation(slowest[index].second);
+		printf("\n");
+	}
+
+	printf("  total %.3f s, peak memory %.2fM\n", executionTime, MEM_get_peak_memory() / (1024.0 * 1024.0));
+	fflush(stdout);
+}
+
+/* storage structs of the compositor nodes that only contain values, these are hashed as a whole */
+static const char *cache_key_value_storage[] = {
+	"MovieClipUser", "NodeBilateralBlurData", "NodeBlurData", "NodeBokehImage", "NodeBoxMask", "NodeChroma",
+	"NodeColorBalance", "NodeColorCorrection", "NodeColorspill", "NodeDBlurData", "NodeDefocus",
+	"NodeDilateErode", "NodeEllipseMask", "NodeGlare", "NodeHueSat", "NodeKeyingData", "NodeKeyingScreenData",
+	"NodeLensDist", "NodeMask", "NodeTonemap", "NodeTrackPosData", "NodeTranslateData", "NodeTwoFloats",
+	"NodeTwoXYs", NULL
+};
+
+/* the settings of a curve mapping, without the evaluation tables and the state of the curve widget */
+static void cache_key_curve_mapping(const CurveMapping *mapping, CacheKey *key)
+{
+	key->addInt(mapping->flag);
+	key->addInt(mapping->preset);
+	key->addData(&mapping->clipr, sizeof(mapping->clipr));
+	key->addData(mapping->black, sizeof(mapping->black));
+	key->addData(mapping->white, sizeof(mapping->white));
+
+	for (int i = 0; i < CM_TOT; i++) {
+		const CurveMap *map = &mapping->cm[i];
+
+		key->addInt(map->totpoint);
+		key->addInt(map->flag);
+		for (int j = 0; j < map->totpoint; j++) {
+			key->addFloat(map->curve[j].x);
+			key->addFloat(map->curve[j].y);
+			key->addInt(map->curve[j].flag & CUMA_VECTOR);
+		}
+	}
+}
+
+/* add the storage of a node to a cache key, returns false for storage types that are not known here.
+ * Pointers can't be hashed: the compositor runs on a localized copy of the tree, so they differ with
+ * every execution, and the data they point to can change while the pointer stays the same. */
+static bool cache_key_storage(bNode *node, CacheKey *key)
+{
+	const char *storagename = node->typeinfo->storagename;
+	int index;
+
+	for (index = 0; cache_key_value_storage[index]; index++) {
+		if (STREQ(storagename, cache_key_value_storage[index])) {
+			key->addData(node->storage, MEM_allocN_len(node->storage));
+			return true;
+		}
+	}
+
+	if (STREQ(storagename, "CurveMapping")) {
+		cache_key_curve_mapping((CurveMapping *)node->storage, key);
+	}
+	else if (STREQ(storagename, "ColorBand")) {
+		const ColorBand *coba = (ColorBand *)node->storage;
+
+		key->addInt(coba->flag);
+		key->addInt(coba->ipotype);
+		key->addInt(coba->tot);
+		for (index = 0; index < coba->tot; index++) {
+			const CBData *data = &coba->data[index];
+			const float values[5] = {data->r, data->g, data->b, data->a, data->pos};
+			key->addData(values, sizeof(values));
+		}
+	}
+	else if (STREQ(storagename, "ImageUser")) {
+		ImageUser iuser = *(ImageUser *)node->storage;
+
+		/* ok is the state of the image buffer, that is hashed by the image operations */
+		iuser.scene = NULL;
+		iuser.ok = 0;
+		key->addData(&iuser, sizeof(iuser));
+	}
+	else if (STREQ(storagename, "TexMapping")) {
+		TexMapping texmap = *(TexMapping *)node->storage;
+
+		texmap.ob = NULL;
+		key->addData(&texmap, sizeof(texmap));
+	}
+	else if (STREQ(storagename, "NodeImageMultiFile")) {
+		NodeImageMultiFile nimf = *(NodeImageMultiFile *)node->storage;
+		ColorManagedViewSettings *view_settings = &nimf.format.view_settings;
+
+		if (view_settings->curve_mapping) {
+			cache_key_curve_mapping(view_settings->curve_mapping, key);
+		}
+		view_settings->curve_mapping = NULL;
+		view_settings->pad2 = NULL;
+		key->addData(&nimf, sizeof(nimf));
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+/* add the settings of an operation to a cache key, returns false when the result can not be cached */
+static bool cache_key_settings(NodeOperation *operation, map<NodeOperation *, int> &indices, CacheKey *key)
+{
+	bNode *node = operation->getbNode();
+	unsigned int index;
+
+	key->addString(typeid(*operation).name());
+	key->addInt(operation->getWidth());
+	key->addInt(operation->getHeight());
+	for (index = 0; index < operation->getNumberOfOutputSockets(); index++) {
+		key->addInt(operation->getOutputSocket(index)->getDataType());
+	}
+
+	if (node) {
+		bNodeSocket *sock;
+
+		key->addInt(node->type);
+		key->addInt(node->flag & NODE_MUTED);
+		key->addInt(node->custom1);
+		key->addInt(node->custom2);
+		key->addFloat(node->custom3);
+		key->addFloat(node->custom4);
+
+		if (node->storage && !cache_key_storage(node, key)) {
+			return false;
+		}
+
+		/* some nodes use the values of unconnected sockets as settings */
+		for (sock = (bNodeSocket *)node->inputs.first; sock; sock = sock->next) {
+			if (sock->default_value) {
+				key->addData(sock->default_value, MEM_allocN_len(sock->default_value));
+			}
+		}
+
+		map<NodeOperation *, int>::iterator found = indices.find(operation);
+		key->addInt(found != indices.end() ? found->second : -1);
+	}
+
+	if (operation->isSetOperation()) {
+		float value[4];
+		operation->read(value, 0.0f, 0.0f, COM_PS_NEAREST);
+		key->addData(value, sizeof(value));
+	}
+
+	FusedOperation *fusedOperation = dynamic_cast<FusedOperation *>(operation);
+	if (fusedOperation) {
+		const vector<NodeOperation *> &operations = fusedOperation->getFusedOperations();
+		const vector<int> &arguments = fusedOperation->getArguments();
+
+		for (index = 0; index < operations.size(); index++) {
+			if (!cache_key_settings(operations[index], indices, key)) {
+				return false;
+			}
+		}
+		for (index = 0; index < arguments.size(); index++) {
+			key->addInt(arguments[index]);
+		}
+	}
+
+	return operation->updateCacheKey(key);
+}
+
+/* cache key of the result of an operation, 0 when the result can not be cached */
+static uint64_t cache_key_operation(NodeOperation *operation, const CacheKey &seed,
+                                    map<NodeOperation *, int> &indices, map<NodeOperation *, uint64_t> &keys)
+{
+	map<NodeOperation *, uint64_t>::iterator found = keys.find(operation);
+	if (found != keys.end()) {
+		return found->second;
+	}
+
+	CacheKey key = seed;
+	uint64_t result = 0;
+
+	if (cache_key_settings(operation, indices, &key)) {
+		result = 1;
+
+		if (operation->isReadBufferOperation()) {
+			/* the input of a read buffer is the write buffer of the memory proxy */
+			ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+			NodeOperation *writeOperation = readOperation->getMemoryProxy()->getWriteBufferOperation();
+			uint64_t inputKey = cache_key_operation(writeOperation, seed, indices, keys);
+			if (inputKey == 0) {
+				result = 0;
+			}
+			key.addKey(inputKey);
+		}
+
+		for (unsigned int index = 0; result && index < operation->getNumberOfInputSockets(); index++) {
+			InputSocket *socket = operation->getInputSocket(index);
+			if (socket->isConnected()) {
+				uint64_t inputKey = cache_key_operation(socket->getOperation(), seed, indices, keys);
+				if (inputKey == 0) {
+					result = 0;
+				}
+				key.addKey(inputKey);
+			}
+			else {
+				key.addInt(-1);
+			}
+		}
+
+		if (result) {
+			result = key.get();
+		}
+	}
+
+	keys[operation] = result;
+	return result;
+}
+
+void ExecutionSystem::restoreCachedBuffers()
+{
+	this->m_groupCacheKeys.assign(this->m_groups.size(), 0);
+
+	/* only while editing, the final render is not executed again with small changes */
+	if (this->m_context.isRendering()) {
+		return;
+	}
+
+	const RenderData *rd = this->m_context.getRenderData();
+	CacheKey seed;
+	seed.addInt(this->m_context.getQuality());
+	seed.addInt(this->m_context.isFastCalculation());
+	seed.addInt(rd->cfra);
+	seed.addInt(rd->size);
+	seed.addInt(rd->xsch);
+	seed.addInt(rd->ysch);
+	seed.addInt(rd->scemode & R_FULL_SAMPLE);
+
+	map<NodeOperation *, uint64_t> keys;
+	int numberOfRestoredBuffers = 0;
+
+	for (unsigned int index = 0; index < this->m_groups.size(); index++) {
+		ExecutionGroup *group = this->m_groups[index];
+		NodeOperation *operation = group->getOutputNodeOperation();
+
+		if (!operation->isWriteBufferOperation()) {
+			continue;
+		}
+
+		WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+		uint64_t key = cache_key_operation(writeOperation, seed, this->m_nodeOperationIndices, keys);
+		if (key == 0) {
+			continue;
+		}
+
+		if (BufferCache::restore(key, writeOperation->getMemoryProxy()->getBuffer())) {
+			group->markExecuted();
+			numberOfRestoredBuffers++;
+		}
+		else {
+			this->m_groupCacheKeys[index] = key;
+		}
+	}
+
+	if (G.debug & G_DEBUG) {
+		printf("Compositor: restored %d buffers from the cache\n", numberOfRestoredBuffers);
+	}
+}
+
+void ExecutionSystem::storeCachedBuffers()
+{
+	const bNodeTree *bTree = this->m_context.getbNodeTree();
+
+	/* chunks of a cancelled execution are marked as executed without being calculated */
+	if (bTree->test_break && bTree->test_break(bTree->tbh)) {
+		return;
+	}
+
+	for (unsigned int index = 0; index < this->m_groupCacheKeys.size(); index++) {
+		ExecutionGroup *group = this->m_groups[index];
+		const uint64_t key = this->m_groupCacheKeys[index];
+
+		if (key != 0 && group->isExecuted()) {
+			WriteBufferOperation *writeOperation = (WriteBufferOperation *)group->getOutputNodeOperation();
+			BufferCache::store(key, writeOperation->getMemoryProxy()->getBuffer());
+		}
+	}
+}
+
 void ExecutionSystem::addSocketConnection(SocketConnection *connection)
 {
 	this->m_connections.push_back(connection);
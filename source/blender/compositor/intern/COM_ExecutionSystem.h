@@ -28,6 +28,7 @@ class ExecutionGroup;
 #include "DNA_color_types.h"
 #include "DNA_node_types.h"
 #include <vector>
+#include <map>
 #include "COM_Node.h"
 #include "COM_SocketConnection.h"
 #include "BKE_text.h"
@@ -84,7 +85,14 @@ using namespace std;
  * @see Converter.convertDataType Datatype conversions
  * @see Converter.convertResolution Image size conversions
  *
- * @section EM_Step4 Step4: group operations in executions groups
+ * @section EM_Step4 Step4: fuse pixel kernels
+ * Chains of operations that only read the input pixels at the same position (conversions, mix, math,
+ * color corrections) are replaced by a single FusedOperation. It reads the inputs of the chain and
+ * evaluates the operations per pixel without going through the read calls between them.
+ * @see ExecutionSystem.fuseOperations method doing this step
+ * @see NodeOperation.isPixelKernel
+ *
+ * @section EM_Step5 Step5: group operations in executions groups
  * ExecutionGroup are groups of operations that are calculated as being one bigger operation.
  * All operations will be part of an ExecutionGroup.
  * Complex nodes will be added to separate groups. Between ExecutionGroup's the data will be stored in MemoryBuffers.
@@ -141,6 +149,17 @@ private:
 	 */
 	vector<SocketConnection *> m_connections;
 
+	/**
+	 * @brief index of every operation among the operations created by its node
+	 * @note part of the cache keys, to tell apart operations of the same type of a single node
+	 */
+	map<NodeOperation *, int> m_nodeOperationIndices;
+
+	/**
+	 * @brief BufferCache key of the output buffer of every group, 0 when it is not stored
+	 */
+	vector<uint64_t> m_groupCacheKeys;
+
 private: //methods
 	/**
 	 * @brief add ReadBufferOperation and WriteBufferOperation around an operation
@@ -178,8 +197,11 @@ public:
 
 	/**
 	 * @brief execute this system
+	 *  - determine which buffers are stored in scratch files
 	 *  - initialize the NodeOperation's and ExecutionGroup's
+	 *  - restore unchanged buffers from the BufferCache
 	 *  - schedule the output ExecutionGroup's based on their priority
+	 *  - store the calculated buffers in the BufferCache
 	 *  - deinitialize the ExecutionGroup's and NodeOperation's
 	 */
 	void execute();
@@ -208,12 +230,48 @@ public:
 	 */
 	void convertToOperations();
 
+	/**
+	 * @brief fuse chains of pixel kernels into FusedOperation's
+	 * @see FusedOperation
+	 * @see NodeOperation.isPixelKernel
+	 */
+	void fuseOperations();
+
 	/**
 	 * @brief group operations in ExecutionGroup's
 	 * @see ExecutionGroup
 	 */
 	void groupOperations();
 
+	/**
+	 * @brief store the buffers with half float precision when enabled in the tree
+	 *
+	 * Only buffers that are read pixel by pixel are stored as half floats, complex operations
+	 * read the float data of their input buffers directly.
+	 * @see MemoryProxy.setHalfFloat
+	 */
+	void determineBufferPrecisions();
+
+	/**
+	 * @brief determine the datatype of the buffers and which buffers are stored in scratch files
+	 *
+	 * Buffers that do not fit in the buffer memory limit of the tree are stored in scratch files.
+	 * Buffers read by complex operations are kept in memory first, they are read in neighborhoods
+	 * while the others are read once in order.
+	 * @see ScratchFile
+	 */
+	void determineBufferStorage();
+
+	/**
+	 * @brief print the execution times of the ExecutionGroup's and the slowest initializations
+	 *
+	 * The operations of an ExecutionGroup are evaluated together per chunk, their time is
+	 * reported per ExecutionGroup. Enabled with --debug-compositor.
+	 * @param initializationTimes time of initExecution of every operation
+	 * @param executionTime time from the start of the initialization to the end of the execution
+	 */
+	void printProfile(const vector<double> &initializationTimes, double executionTime);
+
 	/**
 	 * @brief get the reference to the compositor context
 	 */
@@ -249,6 +307,18 @@ private:
 	
 	void executeGroups(CompositorPriority priority);
 
+	/**
+	 * @brief calculate the cache keys of the group outputs and restore the buffers found in the BufferCache
+	 * @note the ExecutionGroups of restored buffers are marked as executed
+	 * @see BufferCache
+	 */
+	void restoreCachedBuffers();
+
+	/**
+	 * @brief store the output buffers of the fully executed ExecutionGroups in the BufferCache
+	 */
+	void storeCachedBuffers();
+
 #ifdef WITH_CXX_GUARDEDALLOC
 	MEM_CXX_CLASS_ALLOC_FUNCS("COM:ExecutionSystem")
 #endif
@@ -20,8 +20,14 @@
  *		Monique Dewanchand
  */
 
+#include <stdio.h>
+
 #include "COM_MemoryBuffer.h"
 #include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_path_util.h"
+}
 //#include "BKE_global.h"
 
 unsigned int MemoryBuffer::determineBufferSize()
@@ -43,9 +49,8 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
 	BLI_rcti_init(&this->m_rect, rect->xmin, rect->xmax, rect->ymin, rect->ymax);
 	this->m_memoryProxy = memoryProxy;
 	this->m_chunkNumber = chunkNumber;
-	this->m_buffer = (float *)MEM_mallocN(sizeof(float) * determineBufferSize() * COM_NUMBER_OF_CHANNELS, "COM_MemoryBuffer");
+	this->allocate(memoryProxy->getDataType(), memoryProxy->isHalfFloat(), memoryProxy->isStoredInScratchFile());
 	this->m_state = COM_MB_ALLOCATED;
-	this->m_datatype = COM_DT_COLOR;
 	this->m_chunkWidth = this->m_rect.xmax - this->m_rect.xmin;
 }
 
@@ -54,20 +59,92 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
 	BLI_rcti_init(&this->m_rect, rect->xmin, rect->xmax, rect->ymin, rect->ymax);
 	this->m_memoryProxy = memoryProxy;
 	this->m_chunkNumber = -1;
-	this->m_buffer = (float *)MEM_mallocN(sizeof(float) * determineBufferSize() * COM_NUMBER_OF_CHANNELS, "COM_MemoryBuffer");
+	this->allocate(COM_DT_COLOR, false, false);
+	this->m_state = COM_MB_TEMPORARILY;
+	this->m_chunkWidth = this->m_rect.xmax - this->m_rect.xmin;
+}
+
+MemoryBuffer::MemoryBuffer(DataType datatype, rcti *rect, bool halfFloat)
+{
+	BLI_rcti_init(&this->m_rect, rect->xmin, rect->xmax, rect->ymin, rect->ymax);
+	this->m_memoryProxy = NULL;
+	this->m_chunkNumber = -1;
+	this->allocate(datatype, halfFloat, false);
 	this->m_state = COM_MB_TEMPORARILY;
-	this->m_datatype = COM_DT_COLOR;
 	this->m_chunkWidth = this->m_rect.xmax - this->m_rect.xmin;
 }
+
+int MemoryBuffer::determineNumberOfChannels(DataType datatype)
+{
+	switch (datatype) {
+		case COM_DT_VALUE:
+			return 1;
+		case COM_DT_VECTOR:
+			return 3;
+		default:
+			return COM_NUMBER_OF_CHANNELS;
+	}
+}
+
+void MemoryBuffer::allocate(DataType datatype, bool halfFloat, bool storedInScratchFile)
+{
+	const unsigned int size = determineBufferSize();
+
+	this->m_datatype = datatype;
+	this->m_numberOfChannels = determineNumberOfChannels(datatype);
+	this->m_scratchFile = NULL;
+
+	if (storedInScratchFile) {
+		const size_t elementSize = halfFloat ? sizeof(unsigned short) : sizeof(float);
+		this->m_scratchFile = new ScratchFile();
+		void *data = this->m_scratchFile->open(elementSize * size * this->m_numberOfChannels);
+		if (data) {
+			this->m_buffer = halfFloat ? NULL : (float *)data;
+			this->m_halfBuffer = halfFloat ? (unsigned short *)data : NULL;
+			return;
+		}
+		printf("Compositor: could not create a scratch file in %s, buffer is kept in memory\n", BLI_temporary_dir());
+		delete this->m_scratchFile;
+		this->m_scratchFile = NULL;
+	}
+
+	if (halfFloat) {
+		this->m_buffer = NULL;
+		this->m_halfBuffer = (unsigned short *)MEM_mallocN(sizeof(unsigned short) * size * this->m_numberOfChannels, "COM_MemoryBuffer");
+	}
+	else {
+		this->m_buffer = (float *)MEM_mallocN(sizeof(float) * size * this->m_numberOfChannels, "COM_MemoryBuffer");
+		this->m_halfBuffer = NULL;
+	}
+}
+
+size_t MemoryBuffer::getMemorySize()
+{
+	const size_t elementSize = this->m_halfBuffer ? sizeof(unsigned short) : sizeof(float);
+	return elementSize * this->determineBufferSize() * this->m_numberOfChannels;
+}
+
 MemoryBuffer *MemoryBuffer::duplicate()
 {
-	MemoryBuffer *result = new MemoryBuffer(this->m_memoryProxy, &this->m_rect);
-	memcpy(result->m_buffer, this->m_buffer, this->determineBufferSize() * COM_NUMBER_OF_CHANNELS * sizeof(float));
+	MemoryBuffer *result = new MemoryBuffer(this->m_datatype, &this->m_rect, this->isHalfFloat());
+	result->m_memoryProxy = this->m_memoryProxy;
+	if (this->m_halfBuffer) {
+		memcpy(result->m_halfBuffer, this->m_halfBuffer, this->getMemorySize());
+	}
+	else {
+		memcpy(result->m_buffer, this->m_buffer, this->getMemorySize());
+	}
 	return result;
 }
 void MemoryBuffer::clear()
 {
-	memset(this->m_buffer, 0, this->determineBufferSize() * COM_NUMBER_OF_CHANNELS * sizeof(float));
+	if (this->m_halfBuffer) {
+		/* the half float zero is all bits zero too */
+		memset(this->m_halfBuffer, 0, this->getMemorySize());
+	}
+	else {
+		memset(this->m_buffer, 0, this->getMemorySize());
+	}
 }
 
 float *MemoryBuffer::convertToValueBuffer()
@@ -77,11 +154,19 @@ float *MemoryBuffer::convertToValueBuffer()
 
 	float *result = (float *)MEM_mallocN(sizeof(float) * size, __func__);
 
-	const float *fp_src = this->m_buffer;
-	float       *fp_dst = result;
+	if (this->m_halfBuffer) {
+		const unsigned short *hp_src = this->m_halfBuffer;
+		for (i = 0; i < size; i++, hp_src += this->m_numberOfChannels) {
+			result[i] = com_half_to_float(*hp_src);
+		}
+	}
+	else {
+		const float *fp_src = this->m_buffer;
+		float       *fp_dst = result;
 
-	for (i = 0; i < size; i++, fp_dst++, fp_src += COM_NUMBER_OF_CHANNELS) {
-		*fp_dst = *fp_src;
+		for (i = 0; i < size; i++, fp_dst++, fp_src += this->m_numberOfChannels) {
+			*fp_dst = *fp_src;
+		}
 	}
 
 	return result;
@@ -89,16 +174,17 @@ float *MemoryBuffer::convertToValueBuffer()
 
 float MemoryBuffer::getMaximumValue()
 {
-	float result = this->m_buffer[0];
 	const unsigned int size = this->determineBufferSize();
 	unsigned int i;
+	float color[4];
 
-	const float *fp_src = this->m_buffer;
+	loadPixel(color, 0);
+	float result = color[0];
 
-	for (i = 0; i < size; i++, fp_src += COM_NUMBER_OF_CHANNELS) {
-		float value = *fp_src;
-		if (value > result) {
-			result = value;
+	for (i = 1; i < size; i++) {
+		loadPixel(color, i);
+		if (color[0] > result) {
+			result = color[0];
 		}
 	}
 
@@ -127,10 +213,21 @@ float MemoryBuffer::getMaximumValue(rcti *rect)
 
 MemoryBuffer::~MemoryBuffer()
 {
+	if (this->m_scratchFile) {
+		/* the data is unmapped with the file */
+		delete this->m_scratchFile;
+		this->m_scratchFile = NULL;
+		this->m_buffer = NULL;
+		this->m_halfBuffer = NULL;
+	}
 	if (this->m_buffer) {
 		MEM_freeN(this->m_buffer);
 		this->m_buffer = NULL;
 	}
+	if (this->m_halfBuffer) {
+		MEM_freeN(this->m_halfBuffer);
+		this->m_halfBuffer = NULL;
+	}
 }
 
 void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
@@ -139,19 +236,38 @@ void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
 		BLI_assert(0);
 		return;
 	}
-	unsigned int otherY;
-	unsigned int minX = max(this->m_rect.xmin, otherBuffer->m_rect.xmin);
-	unsigned int maxX = min(this->m_rect.xmax, otherBuffer->m_rect.xmax);
-	unsigned int minY = max(this->m_rect.ymin, otherBuffer->m_rect.ymin);
-	unsigned int maxY = min(this->m_rect.ymax, otherBuffer->m_rect.ymax);
+	int otherY;
+	int minX = max(this->m_rect.xmin, otherBuffer->m_rect.xmin);
+	int maxX = min(this->m_rect.xmax, otherBuffer->m_rect.xmax);
+	int minY = max(this->m_rect.ymin, otherBuffer->m_rect.ymin);
+	int maxY = min(this->m_rect.ymax, otherBuffer->m_rect.ymax);
 	int offset;
 	int otherOffset;
+	const bool sameFormat = (this->m_numberOfChannels == otherBuffer->m_numberOfChannels &&
+	                         this->isHalfFloat() == otherBuffer->isHalfFloat());
 
+	if (minX >= maxX) {
+		return;
+	}
 
 	for (otherY = minY; otherY < maxY; otherY++) {
-		otherOffset = ((otherY - otherBuffer->m_rect.ymin) * otherBuffer->m_chunkWidth + minX - otherBuffer->m_rect.xmin) * COM_NUMBER_OF_CHANNELS;
-		offset = ((otherY - this->m_rect.ymin) * this->m_chunkWidth + minX - this->m_rect.xmin) * COM_NUMBER_OF_CHANNELS;
-		memcpy(&this->m_buffer[offset], &otherBuffer->m_buffer[otherOffset], (maxX - minX) * COM_NUMBER_OF_CHANNELS * sizeof(float));
+		otherOffset = (otherY - otherBuffer->m_rect.ymin) * otherBuffer->m_chunkWidth + minX - otherBuffer->m_rect.xmin;
+		offset = (otherY - this->m_rect.ymin) * this->m_chunkWidth + minX - this->m_rect.xmin;
+		if (sameFormat && this->m_halfBuffer) {
+			memcpy(&this->m_halfBuffer[offset * this->m_numberOfChannels], &otherBuffer->m_halfBuffer[otherOffset * this->m_numberOfChannels],
+			       (maxX - minX) * this->m_numberOfChannels * sizeof(unsigned short));
+		}
+		else if (sameFormat) {
+			memcpy(&this->m_buffer[offset * this->m_numberOfChannels], &otherBuffer->m_buffer[otherOffset * this->m_numberOfChannels],
+			       (maxX - minX) * this->m_numberOfChannels * sizeof(float));
+		}
+		else {
+			float color[4];
+			for (int x = 0; x < maxX - minX; x++) {
+				otherBuffer->loadPixel(color, otherOffset + x);
+				this->storePixel(offset + x, color);
+			}
+		}
 	}
 }
 
@@ -160,8 +276,8 @@ void MemoryBuffer::writePixel(int x, int y, const float color[4])
 	if (x >= this->m_rect.xmin && x < this->m_rect.xmax &&
 	    y >= this->m_rect.ymin && y < this->m_rect.ymax)
 	{
-		const int offset = (this->m_chunkWidth * (y - this->m_rect.ymin) + x - this->m_rect.xmin) * COM_NUMBER_OF_CHANNELS;
-		copy_v4_v4(&this->m_buffer[offset], color);
+		const int offset = this->m_chunkWidth * (y - this->m_rect.ymin) + x - this->m_rect.xmin;
+		storePixel(offset, color);
 	}
 }
 
@@ -170,8 +286,27 @@ void MemoryBuffer::addPixel(int x, int y, const float color[4])
 	if (x >= this->m_rect.xmin && x < this->m_rect.xmax &&
 	    y >= this->m_rect.ymin && y < this->m_rect.ymax)
 	{
-		const int offset = (this->m_chunkWidth * (y - this->m_rect.ymin) + x - this->m_rect.xmin) * COM_NUMBER_OF_CHANNELS;
-		add_v4_v4(&this->m_buffer[offset], color);
+		const int offset = this->m_chunkWidth * (y - this->m_rect.ymin) + x - this->m_rect.xmin;
+		float result[4];
+		loadPixel(result, offset);
+		add_v4_v4(result, color);
+		storePixel(offset, result);
+	}
+}
+
+void MemoryBuffer::writeRow(int x, int y, int length, const float *row)
+{
+	if (y < this->m_rect.ymin || y >= this->m_rect.ymax) {
+		return;
+	}
+
+	const int xmin = max_ii(x, this->m_rect.xmin);
+	const int xmax = min_ii(x + length, this->m_rect.xmax);
+	const int offset = this->m_chunkWidth * (y - this->m_rect.ymin) + (xmin - this->m_rect.xmin);
+	const float *input = &row[(xmin - x) * COM_NUMBER_OF_CHANNELS];
+
+	for (int i = 0; i < xmax - xmin; i++, input += COM_NUMBER_OF_CHANNELS) {
+		storePixel(offset + i, input);
 	}
 }
 
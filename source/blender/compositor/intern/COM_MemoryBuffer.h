@@ -27,6 +27,7 @@ class MemoryBuffer;
 
 #include "COM_ExecutionGroup.h"
 #include "COM_MemoryProxy.h"
+#include "COM_ScratchFile.h"
 
 extern "C" {
 	#include "BLI_math.h"
@@ -48,8 +49,65 @@ typedef enum MemoryBufferState {
 
 class MemoryProxy;
 
+/**
+ * @brief convert a half float (IEEE 754 binary16) to a float
+ */
+static inline float com_half_to_float(const unsigned short h)
+{
+	const unsigned int sign = (unsigned int)(h & 0x8000) << 16;
+	const unsigned int exponent = (h >> 10) & 0x1f;
+	const unsigned int mantissa = h & 0x3ff;
+	union { unsigned int i; float f; } result;
+
+	if (exponent == 0) {
+		/* zero and denormals, mantissa * 2^-24 is exact in a float */
+		result.f = (float)mantissa * (1.0f / 16777216.0f);
+		result.i |= sign;
+	}
+	else if (exponent == 0x1f) {
+		/* infinity and nan */
+		result.i = sign | 0x7f800000 | (mantissa << 13);
+	}
+	else {
+		result.i = sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13);
+	}
+	return result.f;
+}
+
+/**
+ * @brief convert a float to a half float (IEEE 754 binary16), rounding to nearest even
+ *
+ * Values that are too large for a half float become infinity.
+ */
+static inline unsigned short com_float_to_half(const float f)
+{
+	union { unsigned int i; float f; } value;
+	value.f = f;
+	const unsigned int sign = (value.i >> 16) & 0x8000;
+	value.i &= 0x7fffffff;
+
+	if (value.i >= 0x47800000) {
+		/* infinity, nan or too large */
+		return sign | (value.i > 0x7f800000 ? 0x7e00 : 0x7c00);
+	}
+	if (value.i < 0x38800000) {
+		/* denormal or zero, adding 0.5 lets the float unit round the mantissa */
+		value.f += 0.5f;
+		return sign | (value.i - 0x3f000000);
+	}
+	/* normal, rebias the exponent and round the mantissa */
+	const unsigned int mantissaOdd = (value.i >> 13) & 1;
+	value.i += ((unsigned int)(15 - 127) << 23) + 0xfff + mantissaOdd;
+	return sign | (value.i >> 13);
+}
+
 /**
  * @brief a MemoryBuffer contains access to the data of a chunk
+ *
+ * The buffer stores the channels of its datatype only: 1 float for values, 3 for vectors
+ * and 4 for colors. Buffers that are only read through the read methods can be stored as
+ * half floats. The read methods always return 4 channels, the channels that are not stored
+ * are zero.
  */
 class MemoryBuffer {
 private:
@@ -63,6 +121,11 @@ private:
 	 */
 	DataType m_datatype;
 	
+	/**
+	 * @brief number of channels of a pixel, the same as the value of the datatype
+	 * except for vectors that have 3
+	 */
+	int m_numberOfChannels;
 	
 	/**
 	 * @brief region of this buffer inside relative to the MemoryProxy
@@ -86,10 +149,91 @@ private:
 	MemoryBufferState m_state;
 	
 	/**
-	 * @brief the actual float buffer/data
+	 * @brief the actual float buffer/data, NULL when the buffer is stored as half floats
 	 */
 	float *m_buffer;
 
+	/**
+	 * @brief the half float data, NULL when the buffer is stored as floats
+	 */
+	unsigned short *m_halfBuffer;
+
+	/**
+	 * @brief the file the data is mapped from, NULL when the data is allocated in memory
+	 */
+	ScratchFile *m_scratchFile;
+
+	/**
+	 * @brief allocate the data for the datatype
+	 * @param storedInScratchFile map the data from a scratch file instead of allocating it in memory
+	 */
+	void allocate(DataType datatype, bool halfFloat, bool storedInScratchFile);
+
+	/**
+	 * @brief read the pixel at an offset in pixels from the start of the buffer
+	 */
+	inline void loadPixel(float result[4], const int offset) const
+	{
+		int channel;
+
+		if (this->m_halfBuffer) {
+			const unsigned short *pixel = &this->m_halfBuffer[offset * this->m_numberOfChannels];
+			for (channel = 0; channel < this->m_numberOfChannels; channel++) {
+				result[channel] = com_half_to_float(pixel[channel]);
+			}
+			for (; channel < COM_NUMBER_OF_CHANNELS; channel++) {
+				result[channel] = 0.0f;
+			}
+			return;
+		}
+
+		const float *pixel = &this->m_buffer[offset * this->m_numberOfChannels];
+		switch (this->m_numberOfChannels) {
+			case 1:
+				result[0] = pixel[0];
+				result[1] = 0.0f;
+				result[2] = 0.0f;
+				result[3] = 0.0f;
+				break;
+			case 3:
+				copy_v3_v3(result, pixel);
+				result[3] = 0.0f;
+				break;
+			default:
+				copy_v4_v4(result, pixel);
+				break;
+		}
+	}
+
+	/**
+	 * @brief write the channels of the datatype of a pixel at an offset in pixels
+	 */
+	inline void storePixel(const int offset, const float color[4])
+	{
+		int channel;
+
+		if (this->m_halfBuffer) {
+			unsigned short *pixel = &this->m_halfBuffer[offset * this->m_numberOfChannels];
+			for (channel = 0; channel < this->m_numberOfChannels; channel++) {
+				pixel[channel] = com_float_to_half(color[channel]);
+			}
+			return;
+		}
+
+		float *pixel = &this->m_buffer[offset * this->m_numberOfChannels];
+		switch (this->m_numberOfChannels) {
+			case 1:
+				pixel[0] = color[0];
+				break;
+			case 3:
+				copy_v3_v3(pixel, color);
+				break;
+			default:
+				copy_v4_v4(pixel, color);
+				break;
+		}
+	}
+
 public:
 	/**
 	 * @brief construct new MemoryBuffer for a chunk
@@ -101,6 +245,11 @@ public:
 	 */
 	MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect);
 	
+	/**
+	 * @brief construct new temporarily MemoryBuffer for an area with the channels of a datatype
+	 */
+	MemoryBuffer(DataType datatype, rcti *rect, bool halfFloat);
+	
 	/**
 	 * @brief destructor
 	 */
@@ -114,8 +263,43 @@ public:
 	/**
 	 * @brief get the data of this MemoryBuffer
 	 * @note buffer should already be available in memory
+	 * @note pixels are getNumberOfChannels floats apart, not available for half float buffers
+	 */
+	float *getBuffer()
+	{
+		BLI_assert(this->m_halfBuffer == NULL);
+		return this->m_buffer;
+	}
+	
+	/**
+	 * @brief get the datatype of the data
+	 */
+	DataType getDataType() const { return this->m_datatype; }
+	
+	/**
+	 * @brief get the number of channels of a pixel in the data
+	 */
+	int getNumberOfChannels() const { return this->m_numberOfChannels; }
+	
+	/**
+	 * @brief is the data stored as half floats
+	 */
+	bool isHalfFloat() const { return this->m_halfBuffer != NULL; }
+	
+	/**
+	 * @brief get the size of the data in bytes
+	 */
+	size_t getMemorySize();
+
+	/**
+	 * @brief get the number of channels that are stored for a datatype
 	 */
-	float *getBuffer() { return this->m_buffer; }
+	static int determineNumberOfChannels(DataType datatype);
+	
+	/**
+	 * @brief is the data stored in a scratch file
+	 */
+	bool isStoredInScratchFile() const { return this->m_scratchFile != NULL; }
 	
 	/**
 	 * @brief after execution the state will be set to available by calling this method
@@ -132,8 +316,7 @@ public:
 		{
 			const int dx = x - this->m_rect.xmin;
 			const int dy = y - this->m_rect.ymin;
-			const int offset = (this->m_chunkWidth * dy + dx) * COM_NUMBER_OF_CHANNELS;
-			copy_v4_v4(result, &this->m_buffer[offset]);
+			loadPixel(result, this->m_chunkWidth * dy + dx);
 		}
 		else {
 			zero_v4(result);
@@ -144,24 +327,69 @@ public:
 	{
 		const int dx = x - this->m_rect.xmin;
 		const int dy = y - this->m_rect.ymin;
-		const int offset = (this->m_chunkWidth * dy + dx) * COM_NUMBER_OF_CHANNELS;
+		const int offset = this->m_chunkWidth * dy + dx;
 
 		BLI_assert(offset >= 0);
-		BLI_assert(offset < this->determineBufferSize() * COM_NUMBER_OF_CHANNELS);
+		BLI_assert(offset < this->determineBufferSize());
 		BLI_assert(x >= this->m_rect.xmin && x < this->m_rect.xmax &&
 		           y >= this->m_rect.ymin && y < this->m_rect.ymax);
 
 #if 0
 		/* always true */
 		BLI_assert((int)(MEM_allocN_len(this->m_buffer) / sizeof(*this->m_buffer)) ==
-		           (int)(this->determineBufferSize() * COM_NUMBER_OF_CHANNELS));
+		           (int)(this->determineBufferSize() * this->m_numberOfChannels));
 #endif
 
-		copy_v4_v4(result, &this->m_buffer[offset]);
+		loadPixel(result, offset);
 	}
 	
+	/**
+	 * @brief read a horizontal span of pixels, pixels outside the buffer are black transparent
+	 * @param result array of length * COM_NUMBER_OF_CHANNELS floats
+	 */
+	inline void readRow(float *result, int x, int y, int length)
+	{
+		if (y < this->m_rect.ymin || y >= this->m_rect.ymax) {
+			memset(result, 0, length * COM_NUMBER_OF_CHANNELS * sizeof(float));
+			return;
+		}
+
+		const int xmin = max_ii(x, this->m_rect.xmin);
+		const int xmax = min_ii(x + length, this->m_rect.xmax);
+
+		if (xmin >= xmax) {
+			memset(result, 0, length * COM_NUMBER_OF_CHANNELS * sizeof(float));
+			return;
+		}
+		if (xmin > x) {
+			memset(result, 0, (xmin - x) * COM_NUMBER_OF_CHANNELS * sizeof(float));
+		}
+		const int offset = this->m_chunkWidth * (y - this->m_rect.ymin) + (xmin - this->m_rect.xmin);
+		if (this->m_numberOfChannels == COM_NUMBER_OF_CHANNELS && this->m_buffer) {
+			memcpy(&result[(xmin - x) * COM_NUMBER_OF_CHANNELS], &this->m_buffer[offset * COM_NUMBER_OF_CHANNELS],
+			       (xmax - xmin) * COM_NUMBER_OF_CHANNELS * sizeof(float));
+		}
+		else {
+			float *output = &result[(xmin - x) * COM_NUMBER_OF_CHANNELS];
+			for (int i = 0; i < xmax - xmin; i++, output += COM_NUMBER_OF_CHANNELS) {
+				loadPixel(output, offset + i);
+			}
+		}
+		if (xmax < x + length) {
+			memset(&result[(xmax - x) * COM_NUMBER_OF_CHANNELS], 0,
+			       (x + length - xmax) * COM_NUMBER_OF_CHANNELS * sizeof(float));
+		}
+	}
+
 	void writePixel(int x, int y, const float color[4]);
 	void addPixel(int x, int y, const float color[4]);
+
+	/**
+	 * @brief write a horizontal span of pixels, pixels outside the buffer are skipped
+	 * @param row array of length * COM_NUMBER_OF_CHANNELS floats
+	 */
+	void writeRow(int x, int y, int length, const float *row);
+
 	inline void readCubic(float result[4], float x, float y)
 	{
 		int x1 = floor(x);
@@ -211,7 +439,7 @@ public:
 	
 	/**
 	 * @brief add the content from otherBuffer to this MemoryBuffer
-	 * @param otherBuffer source buffer
+	 * @param otherBuffer source buffer, the data is converted when the buffers differ in channels or precision
 	 *
 	 * @note take care when running this on a new buffer since it wont fill in
 	 *       uninitialized values in areas where the buffers don't overlap.
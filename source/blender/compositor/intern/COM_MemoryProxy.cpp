@@ -27,6 +27,10 @@ MemoryProxy::MemoryProxy()
 {
 	this->m_writeBufferOperation = NULL;
 	this->m_executor = NULL;
+	this->m_datatype = COM_DT_COLOR;
+	this->m_halfFloat = false;
+	this->m_storedInScratchFile = false;
+	this->m_buffer = NULL;
 }
 
 void MemoryProxy::allocate(unsigned int width, unsigned int height)
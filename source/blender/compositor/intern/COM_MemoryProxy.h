@@ -48,9 +48,19 @@ private:
 	ExecutionGroup *m_executor;
 	
 	/**
-	 * @brief datatype of this MemoryProxy
+	 * @brief datatype of this MemoryProxy, determines the number of channels of the buffer
 	 */
-	/* DataType m_datatype; */ /* UNUSED */
+	DataType m_datatype;
+
+	/**
+	 * @brief store the buffer with half float precision
+	 */
+	bool m_halfFloat;
+
+	/**
+	 * @brief store the buffer in a scratch file instead of memory
+	 */
+	bool m_storedInScratchFile;
 	
 	/**
 	 * @brief channel information of this buffer
@@ -88,6 +98,38 @@ public:
 	 */
 	WriteBufferOperation *getWriteBufferOperation() { return this->m_writeBufferOperation; }
 
+	/**
+	 * @brief set the datatype of the buffer, the buffer stores the channels of this type only
+	 */
+	void setDataType(DataType datatype) { this->m_datatype = datatype; }
+
+	/**
+	 * @brief get the datatype of the buffer
+	 */
+	DataType getDataType() const { return this->m_datatype; }
+
+	/**
+	 * @brief store the buffer with half float precision
+	 * @note only allowed when no operation reads the float data of the buffer directly
+	 */
+	void setHalfFloat(bool halfFloat) { this->m_halfFloat = halfFloat; }
+
+	/**
+	 * @brief is the buffer stored with half float precision
+	 */
+	bool isHalfFloat() const { return this->m_halfFloat; }
+
+	/**
+	 * @brief store the buffer in a scratch file, for buffers that do not fit in the buffer memory limit
+	 * @see ScratchFile
+	 */
+	void setStoredInScratchFile(bool storedInScratchFile) { this->m_storedInScratchFile = storedInScratchFile; }
+
+	/**
+	 * @brief is the buffer stored in a scratch file
+	 */
+	bool isStoredInScratchFile() const { return this->m_storedInScratchFile; }
+
 	/**
 	 * @brief allocate memory of size width x height
 	 */
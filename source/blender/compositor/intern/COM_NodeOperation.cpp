@@ -107,6 +107,14 @@ NodeOperation *NodeOperation::getInputOperation(unsigned int inputSocketIndex)
 	return this->getInputSocket(inputSocketIndex)->getOperation();
 }
 
+bool NodeOperation::updateCacheKey(CacheKey *key) const
+{
+	bNode *node = this->getbNode();
+
+	/* node groups are expanded, other data-blocks can change without changing the node */
+	return node == NULL || node->id == NULL || GS(node->id->name) == ID_NT;
+}
+
 void NodeOperation::getConnectedInputSockets(vector<InputSocket *> *sockets)
 {
 	vector<InputSocket *> &inputsockets = this->getInputSockets();
@@ -29,6 +29,7 @@ class OpenCLDevice;
 #include "COM_MemoryBuffer.h"
 #include "COM_MemoryProxy.h"
 #include "COM_SocketReader.h"
+#include "COM_BufferCache.h"
 #include "OCL_opencl.h"
 #include "list"
 #include "BLI_threads.h"
@@ -201,6 +202,36 @@ public:
 	const bool isComplex() const { return this->m_complex; }
 	virtual const bool isSetOperation() const { return false; }
 
+	/**
+	 * @brief is this operation a pixel kernel
+	 *
+	 * Pixel kernels calculate an output pixel only from the input pixels at the same position
+	 * (conversions, mix, math, color corrections). Chains of pixel kernels are fused into a
+	 * single FusedOperation by the ExecutionSystem.
+	 * @see executeKernel
+	 * @see FusedOperation
+	 */
+	virtual const bool isPixelKernel() const { return false; }
+
+	/**
+	 * @brief calculate a single pixel from input pixels that have already been read
+	 * @note only called when isPixelKernel is true, the operation must not read its inputs itself
+	 * @param output is a float[4] array to store the result
+	 * @param inputs one float[4] array per input socket, in the order of the input sockets
+	 */
+	virtual void executeKernel(float output[4], const float *inputs[]) {}
+
+	/**
+	 * @brief add the data this operation reads from outside the node tree to a cache key
+	 * @note called after initExecution. The settings of the bNode, the resolution and the keys
+	 * of the inputs are already part of the key.
+	 * @return false when the result of this operation can not be cached. By default this is the
+	 * case for operations of nodes that use a data-block (image, movie clip, mask, scene), except
+	 * for node groups.
+	 * @see BufferCache
+	 */
+	virtual bool updateCacheKey(CacheKey *key) const;
+
 	/**
 	 * @brief is this operation of type ReadBufferOperation
 	 * @return [true:false]
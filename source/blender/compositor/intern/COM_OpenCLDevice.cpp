@@ -23,6 +23,8 @@
 #include "COM_OpenCLDevice.h"
 #include "COM_WorkScheduler.h"
 
+#include "PIL_time.h"
+
 typedef enum COM_VendorID  {NVIDIA = 0x10DE, AMD = 0x1002} COM_VendorID;
 
 OpenCLDevice::OpenCLDevice(cl_context context, cl_device_id device, cl_program program, cl_int vendorId)
@@ -55,6 +57,7 @@ void OpenCLDevice::execute(WorkPackage *work)
 	rcti rect;
 
 	executionGroup->determineChunkRect(&rect, chunkNumber);
+	const double startTime = PIL_check_seconds_timer();
 	MemoryBuffer **inputBuffers = executionGroup->getInputBuffersOpenCL(chunkNumber);
 	MemoryBuffer *outputBuffer = executionGroup->allocateOutputBuffer(chunkNumber, &rect);
 
@@ -62,6 +65,7 @@ void OpenCLDevice::execute(WorkPackage *work)
 	                                                              chunkNumber, inputBuffers, outputBuffer);
 
 	delete outputBuffer;
+	executionGroup->setChunkExecutionTimes(chunkNumber, startTime, PIL_check_seconds_timer());
 	
 	executionGroup->finalizeChunkExecution(chunkNumber, inputBuffers);
 }
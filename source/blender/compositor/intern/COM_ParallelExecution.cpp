@@ -0,0 +1,89 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "COM_ParallelExecution.h"
+
+#include "BLI_math.h"
+#include "BLI_threads.h"
+#include "DNA_listBase.h"
+
+/* BLI_init_threads and BLI_end_threads change the global thread level without a lock, which is
+ * not safe when several compositor threads start threads at once. Only one call runs threaded at
+ * a time, which costs little as every call already has a thread per processor. */
+static ThreadMutex g_executeMutex = BLI_MUTEX_INITIALIZER;
+
+typedef struct ParallelRangeData {
+	ParallelRangeFunc func;
+	void *userdata;
+	int size;
+	int grainSize;
+	int next;
+	ThreadMutex mutex;
+} ParallelRangeData;
+
+static void *parallel_range_thread(void *data_v)
+{
+	ParallelRangeData *data = (ParallelRangeData *)data_v;
+
+	while (true) {
+		int start, end;
+
+		BLI_mutex_lock(&data->mutex);
+		start = data->next;
+		end = min_ii(start + data->grainSize, data->size);
+		data->next = end;
+		BLI_mutex_unlock(&data->mutex);
+
+		if (start >= end) {
+			break;
+		}
+		data->func(data->userdata, start, end);
+	}
+	return NULL;
+}
+
+void ParallelExecution::execute(int size, int grainSize, ParallelRangeFunc func, void *userdata)
+{
+	const int numberOfJobs = (size + grainSize - 1) / grainSize;
+	const int totthread = min_ii(BLI_system_thread_count(), numberOfJobs);
+
+	if (totthread > 1) {
+		ParallelRangeData data;
+		ListBase threads;
+		int i;
+
+		data.func = func;
+		data.userdata = userdata;
+		data.size = size;
+		data.grainSize = grainSize;
+		data.next = 0;
+		BLI_mutex_init(&data.mutex);
+
+		BLI_mutex_lock(&g_executeMutex);
+		BLI_init_threads(&threads, parallel_range_thread, totthread);
+		for (i = 0; i < totthread; i++)
+			BLI_insert_thread(&threads, &data);
+		BLI_end_threads(&threads);
+		BLI_mutex_unlock(&g_executeMutex);
+
+		BLI_mutex_end(&data.mutex);
+	}
+	else if (size > 0) {
+		func(userdata, 0, size);
+	}
+}
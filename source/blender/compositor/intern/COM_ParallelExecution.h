@@ -0,0 +1,44 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_ParallelExecution_h
+#define _COM_ParallelExecution_h
+
+/* calculates the items start to end - 1 of a ParallelExecution.execute call */
+typedef void (*ParallelRangeFunc)(void *userdata, int start, int end);
+
+/**
+ * @brief divide the items of a calculation over threads
+ *
+ * Used by operations that calculate a whole image at once (SingleThreadedNodeOperation) and
+ * so only run on one of the compositor threads. The items are handed out in groups of grainSize
+ * to threads that are started for the call.
+ * @ingroup Execution
+ */
+class ParallelExecution {
+public:
+	/**
+	 * @brief calculate the items 0 to size - 1, returns when all are calculated
+	 * @param size number of items
+	 * @param grainSize number of items that are calculated at once by a thread
+	 * @note the items are calculated on the calling thread when there is only one thread or job
+	 */
+	static void execute(int size, int grainSize, ParallelRangeFunc func, void *userdata);
+};
+
+#endif
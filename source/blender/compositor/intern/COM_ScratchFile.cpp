@@ -0,0 +1,157 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <stdlib.h>
+
+#include "COM_ScratchFile.h"
+
+#ifdef WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#endif
+
+extern "C" {
+#include "BLI_path_util.h"
+}
+
+ScratchFile::ScratchFile()
+{
+	this->m_data = NULL;
+	this->m_size = 0;
+#ifdef WIN32
+	this->m_file = INVALID_HANDLE_VALUE;
+	this->m_mapping = NULL;
+#else
+	this->m_file = -1;
+#endif
+}
+
+ScratchFile::~ScratchFile()
+{
+	this->close();
+}
+
+#ifdef WIN32
+
+void *ScratchFile::open(size_t size)
+{
+	char path[FILE_MAX];
+	const unsigned long long size64 = size;
+
+	if (size == 0 || GetTempFileNameA(BLI_temporary_dir(), "com", 0, path) == 0) {
+		return NULL;
+	}
+
+	/* the system removes the file when the last handle is closed */
+	this->m_file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+	                           FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+	if (this->m_file == INVALID_HANDLE_VALUE) {
+		DeleteFileA(path);
+		return NULL;
+	}
+
+	this->m_mapping = CreateFileMapping(this->m_file, NULL, PAGE_READWRITE,
+	                                    (DWORD)(size64 >> 32), (DWORD)(size64 & 0xffffffff), NULL);
+	if (this->m_mapping) {
+		this->m_data = MapViewOfFile(this->m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	}
+	if (this->m_data == NULL) {
+		this->close();
+		return NULL;
+	}
+
+	this->m_size = size;
+	return this->m_data;
+}
+
+void ScratchFile::close()
+{
+	if (this->m_data) {
+		UnmapViewOfFile(this->m_data);
+		this->m_data = NULL;
+	}
+	if (this->m_mapping) {
+		CloseHandle(this->m_mapping);
+		this->m_mapping = NULL;
+	}
+	if (this->m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(this->m_file);
+		this->m_file = INVALID_HANDLE_VALUE;
+	}
+	this->m_size = 0;
+}
+
+#else
+
+void *ScratchFile::open(size_t size)
+{
+	char path[FILE_MAX];
+
+	if (size == 0) {
+		return NULL;
+	}
+
+	BLI_join_dirfile(path, sizeof(path), BLI_temporary_dir(), "blender_compositor_XXXXXX");
+	this->m_file = mkstemp(path);
+	if (this->m_file == -1) {
+		return NULL;
+	}
+	/* the file is removed when it is closed, no other process can open it anymore */
+	unlink(path);
+
+#ifdef __linux__
+	/* reserve the disk space, writing to a mapped page of a full disk would crash */
+	if (posix_fallocate(this->m_file, 0, size) != 0) {
+		this->close();
+		return NULL;
+	}
+#else
+	if (ftruncate(this->m_file, size) != 0) {
+		this->close();
+		return NULL;
+	}
+#endif
+
+	void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_file, 0);
+	if (data == MAP_FAILED) {
+		this->close();
+		return NULL;
+	}
+
+	this->m_data = data;
+	this->m_size = size;
+	return this->m_data;
+}
+
+void ScratchFile::close()
+{
+	if (this->m_data) {
+		munmap(this->m_data, this->m_size);
+		this->m_data = NULL;
+	}
+	if (this->m_file != -1) {
+		::close(this->m_file);
+		this->m_file = -1;
+	}
+	this->m_size = 0;
+}
+
+#endif
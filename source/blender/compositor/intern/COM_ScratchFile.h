@@ -0,0 +1,79 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_ScratchFile_h
+#define _COM_ScratchFile_h
+
+#include <stddef.h>
+#include "MEM_guardedalloc.h"
+
+/**
+ * @brief memory that is stored in a temporary file instead of RAM
+ *
+ * The file is mapped in memory. The operating system writes the pages that were not used
+ * recently to the file and reads them back when they are accessed again, so the data can be
+ * used like any other memory while only the recently used tiles take up RAM.
+ * The file is removed when it is closed.
+ * @see ExecutionSystem.determineBufferStorage
+ * @ingroup Memory
+ */
+class ScratchFile {
+private:
+	/**
+	 * @brief the mapped memory, NULL when the file is not open
+	 */
+	void *m_data;
+
+	/**
+	 * @brief size of the file and the mapped memory in bytes
+	 */
+	size_t m_size;
+
+#ifdef WIN32
+	void *m_file;
+	void *m_mapping;
+#else
+	int m_file;
+#endif
+
+public:
+	ScratchFile();
+	~ScratchFile();
+
+	/**
+	 * @brief create the file and map it in memory
+	 * @return the mapped memory, NULL when the file could not be created
+	 */
+	void *open(size_t size);
+
+	/**
+	 * @brief unmap and remove the file
+	 */
+	void close();
+
+	/**
+	 * @brief get the mapped memory
+	 */
+	void *getData() { return this->m_data; }
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("COM:ScratchFile")
+#endif
+};
+
+#endif
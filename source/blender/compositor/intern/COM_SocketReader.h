@@ -57,7 +57,7 @@ protected:
 
 	/**
 	 * @brief calculate a single pixel
-	 * @note this method is called for non-complex
+	 * @note this method is called for non-complex operations only
 	 * @param result is a float[4] array to store the result
 	 * @param x the x-coordinate of the pixel to calculate in image space
 	 * @param y the y-coordinate of the pixel to calculate in image space
@@ -67,7 +67,7 @@ protected:
 
 	/**
 	 * @brief calculate a single pixel
-	 * @note this method is called for complex
+	 * @note this method is called for complex operations only
 	 * @param result is a float[4] array to store the result
 	 * @param x the x-coordinate of the pixel to calculate in image space
 	 * @param y the y-coordinate of the pixel to calculate in image space
@@ -80,7 +80,7 @@ protected:
 
 	/**
 	 * @brief calculate a single pixel using an EWA filter
-	 * @note this method is called for complex
+	 * @note this method is called for complex operations only
 	 * @param result is a float[4] array to store the result
 	 * @param x the x-coordinate of the pixel to calculate in image space
 	 * @param y the y-coordinate of the pixel to calculate in image space
@@ -90,6 +90,55 @@ protected:
 	 */
 	virtual void executePixel(float output[4], float x, float y, float dx, float dy, PixelSampler sampler) {}
 
+	/**
+	 * @brief calculate a horizontal span of pixels
+	 * @note this method is called for non-complex operations only
+	 * the default implementation calls executePixel for every pixel of the span. Simple operations
+	 * override it to process the whole span in a tight loop over contiguous memory.
+	 * @param output array of length * COM_NUMBER_OF_CHANNELS floats to store the result
+	 * @param x the x-coordinate of the first pixel of the span in image space
+	 * @param y the y-coordinate of the span in image space
+	 * @param length number of pixels in the span
+	 */
+	virtual void executeRow(float *output, int x, int y, int length, PixelSampler sampler) {
+		for (int i = 0; i < length; i++) {
+			executePixel(&output[i * COM_NUMBER_OF_CHANNELS], (float)(x + i), (float)y, sampler);
+		}
+	}
+
+	/**
+	 * @brief calculate a horizontal span of pixels
+	 * @note this method is called for complex operations only
+	 * the default implementation calls executePixel for every pixel of the span. Operations that
+	 * read their input buffer directly override it to process the span in a single loop.
+	 * @param output array of length * COM_NUMBER_OF_CHANNELS floats to store the result
+	 * @param x the x-coordinate of the first pixel of the span in image space
+	 * @param y the y-coordinate of the span in image space
+	 * @param length number of pixels in the span
+	 * @param chunkData chunk specific data a during execution time.
+	 */
+	virtual void executeRow(float *output, int x, int y, int length, void *chunkData) {
+		for (int i = 0; i < length; i++) {
+			executePixel(&output[i * COM_NUMBER_OF_CHANNELS], x + i, y, chunkData);
+		}
+	}
+
+	/**
+	 * @brief calculate a rectangular tile of pixels
+	 * @note this method is called for non-complex operations only
+	 * the default implementation calls executeRow for every row of the tile.
+	 * @param output buffer to store the result, the first pixel of the tile is written at output[0]
+	 * @param stride number of pixels between the starts of two rows in output
+	 * @param rect area to calculate in image space
+	 */
+	virtual void executeTile(float *output, int stride, const rcti *rect, PixelSampler sampler) {
+		const int length = rect->xmax - rect->xmin;
+		for (int y = rect->ymin; y < rect->ymax; y++) {
+			executeRow(output, rect->xmin, y, length, sampler);
+			output += stride * COM_NUMBER_OF_CHANNELS;
+		}
+	}
+
 public:
 	inline void read(float *result, float x, float y, PixelSampler sampler) {
 		executePixel(result, x, y, sampler);
@@ -100,6 +149,15 @@ public:
 	inline void read(float *result, float x, float y, float dx, float dy, PixelSampler sampler) {
 		executePixel(result, x, y, dx, dy, sampler);
 	}
+	inline void readRow(float *result, int x, int y, int length, PixelSampler sampler) {
+		executeRow(result, x, y, length, sampler);
+	}
+	inline void readRow(float *result, int x, int y, int length, void *chunkData) {
+		executeRow(result, x, y, length, chunkData);
+	}
+	inline void readTile(float *result, int stride, const rcti *rect, PixelSampler sampler) {
+		executeTile(result, stride, rect, sampler);
+	}
 
 	virtual void *initializeTileData(rcti *rect) { return 0; }
 	virtual void deinitializeTileData(rcti *rect, void *data) {
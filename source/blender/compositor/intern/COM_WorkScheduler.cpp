@@ -21,6 +21,7 @@
  */
 
 #include <list>
+#include <deque>
 #include <stdio.h>
 
 #include "COM_compositor.h"
@@ -53,11 +54,42 @@
 static vector<CPUDevice *> g_cpudevices;
 
 #if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+/// @brief number of chunks scheduled after each other (neighbours in the chunk order) that go to the same CPU thread
+#define COM_SCHEDULE_NEIGHBOURS 2
+
+/// @brief work queue and statistics of a single CPU thread
+typedef struct CPUWorker {
+	CPUDevice *device;
+	int index;
+	/// @brief protects the packages
+	ThreadMutex mutex;
+	/// @brief work of this thread, it takes from the front, other threads steal from the back
+	deque<WorkPackage *> packages;
+	/// @brief signalled when there is work for this thread or the threads are stopped
+	ThreadCondition condition;
+	/// @brief is the thread waiting for work, protected by g_cpuMutex
+	bool sleeping;
+	int numberOfExecuted;
+	int numberOfStolen;
+	double busyTime;
+} CPUWorker;
+
 /// @brief list of all thread for every CPUDevice in cpudevices a thread exists
 static ListBase g_cputhreads;
 static bool g_cpuInitialized = false;
-/// @brief all scheduled work for the cpu
-static ThreadQueue *g_cpuqueue;
+/// @brief the work queues of the cpu threads
+static vector<CPUWorker *> g_cpuworkers;
+/// @brief protects the counters below and the sleeping state of the CPU threads
+static ThreadMutex g_cpuMutex;
+/// @brief signalled when all scheduled work of the cpu threads has been executed
+static ThreadCondition g_cpuFinishCondition;
+/// @brief number of packages in the queues that are not claimed by a thread yet
+static int g_cpuQueued;
+/// @brief number of scheduled packages that are not executed yet
+static int g_cpuUnfinished;
+/// @brief number of packages scheduled since start, used to distribute the work
+static unsigned int g_cpuScheduled;
+static bool g_cpuStopping;
 static ThreadQueue *g_gpuqueue;
 #ifdef COM_OPENCL_ENABLED
 static cl_context g_context;
@@ -139,20 +171,112 @@ int COM_isHighlightedbNode(bNode *bnode)
 } // end extern "C"
 
 #if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+/* take a package from the own queue, or steal one from the other threads */
+static WorkPackage *cpu_worker_take(CPUWorker *worker)
+{
+	const int numberOfWorkers = g_cpuworkers.size();
+	WorkPackage *work = NULL;
+
+	BLI_mutex_lock(&worker->mutex);
+	if (!worker->packages.empty()) {
+		work = worker->packages.front();
+		worker->packages.pop_front();
+	}
+	BLI_mutex_unlock(&worker->mutex);
+
+	/* steal from the back, away from the chunks the other thread is working on */
+	for (int offset = 1; work == NULL && offset < numberOfWorkers; offset++) {
+		CPUWorker *victim = g_cpuworkers[(worker->index + offset) % numberOfWorkers];
+
+		BLI_mutex_lock(&victim->mutex);
+		if (!victim->packages.empty()) {
+			work = victim->packages.back();
+			victim->packages.pop_back();
+			worker->numberOfStolen++;
+		}
+		BLI_mutex_unlock(&victim->mutex);
+	}
+
+	return work;
+}
+
 void *WorkScheduler::thread_execute_cpu(void *data)
 {
-	Device *device = (Device *)data;
+	CPUWorker *worker = (CPUWorker *)data;
 	WorkPackage *work;
-	
-	while ((work = (WorkPackage *)BLI_thread_queue_pop(g_cpuqueue))) {
+
+	while (true) {
+		BLI_mutex_lock(&g_cpuMutex);
+		while (g_cpuQueued == 0 && !g_cpuStopping) {
+			worker->sleeping = true;
+			BLI_condition_wait(&worker->condition, &g_cpuMutex);
+		}
+		worker->sleeping = false;
+		if (g_cpuQueued == 0) {
+			BLI_mutex_unlock(&g_cpuMutex);
+			break;
+		}
+		/* claim a package, the queues contain at least as many packages as there are claims */
+		g_cpuQueued--;
+		BLI_mutex_unlock(&g_cpuMutex);
+
+		while (!(work = cpu_worker_take(worker))) {
+			/* the claimed package is being moved by another thread, try again */
+		}
+
 		HIGHLIGHT(work);
-		device->execute(work);
+		const double start = PIL_check_seconds_timer();
+		worker->device->execute(work);
+		worker->busyTime += PIL_check_seconds_timer() - start;
+		worker->numberOfExecuted++;
 		delete work;
+
+		BLI_mutex_lock(&g_cpuMutex);
+		g_cpuUnfinished--;
+		if (g_cpuUnfinished == 0) {
+			BLI_condition_notify_all(&g_cpuFinishCondition);
+		}
+		BLI_mutex_unlock(&g_cpuMutex);
 	}
-	
+
 	return NULL;
 }
 
+/* add a package to the queue of a CPU thread and wake up a thread to execute it */
+static void cpu_schedule(WorkPackage *package)
+{
+	const int numberOfWorkers = g_cpuworkers.size();
+
+	BLI_mutex_lock(&g_cpuMutex);
+	CPUWorker *worker = g_cpuworkers[(g_cpuScheduled / COM_SCHEDULE_NEIGHBOURS) % numberOfWorkers];
+	g_cpuScheduled++;
+	BLI_mutex_unlock(&g_cpuMutex);
+
+	BLI_mutex_lock(&worker->mutex);
+	worker->packages.push_back(package);
+	BLI_mutex_unlock(&worker->mutex);
+
+	BLI_mutex_lock(&g_cpuMutex);
+	g_cpuQueued++;
+	g_cpuUnfinished++;
+
+	/* prefer the owner of the queue, otherwise any waiting thread steals the package */
+	CPUWorker *wake = NULL;
+	if (worker->sleeping) {
+		wake = worker;
+	}
+	for (int index = 0; wake == NULL && index < numberOfWorkers; index++) {
+		if (g_cpuworkers[index]->sleeping) {
+			wake = g_cpuworkers[index];
+		}
+	}
+	if (wake) {
+		wake->sleeping = false;
+		BLI_condition_notify_one(&wake->condition);
+	}
+	BLI_mutex_unlock(&g_cpuMutex);
+}
+
 void *WorkScheduler::thread_execute_gpu(void *data)
 {
 	Device *device = (Device *)data;
@@ -183,10 +307,10 @@ void WorkScheduler::schedule(ExecutionGroup *group, int chunkNumber)
 		BLI_thread_queue_push(g_gpuqueue, package);
 	}
 	else {
-		BLI_thread_queue_push(g_cpuqueue, package);
+		cpu_schedule(package);
 	}
 #else
-	BLI_thread_queue_push(cpuqueue, package);
+	cpu_schedule(package);
 #endif
 #endif
 }
@@ -195,11 +319,27 @@ void WorkScheduler::start(CompositorContext &context)
 {
 #if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
 	unsigned int index;
-	g_cpuqueue = BLI_thread_queue_init();
-	BLI_init_threads(&g_cputhreads, thread_execute_cpu, g_cpudevices.size());
+	BLI_mutex_init(&g_cpuMutex);
+	BLI_condition_init(&g_cpuFinishCondition);
+	g_cpuQueued = 0;
+	g_cpuUnfinished = 0;
+	g_cpuScheduled = 0;
+	g_cpuStopping = false;
 	for (index = 0; index < g_cpudevices.size(); index++) {
-		Device *device = g_cpudevices[index];
-		BLI_insert_thread(&g_cputhreads, device);
+		CPUWorker *worker = new CPUWorker();
+		worker->device = g_cpudevices[index];
+		worker->index = index;
+		BLI_mutex_init(&worker->mutex);
+		BLI_condition_init(&worker->condition);
+		worker->sleeping = false;
+		worker->numberOfExecuted = 0;
+		worker->numberOfStolen = 0;
+		worker->busyTime = 0.0;
+		g_cpuworkers.push_back(worker);
+	}
+	BLI_init_threads(&g_cputhreads, thread_execute_cpu, g_cpuworkers.size());
+	for (index = 0; index < g_cpuworkers.size(); index++) {
+		BLI_insert_thread(&g_cputhreads, g_cpuworkers[index]);
 	}
 #ifdef COM_OPENCL_ENABLED
 	if (context.getHasActiveOpenCLDevices()) {
@@ -223,23 +363,41 @@ void WorkScheduler::finish()
 #ifdef COM_OPENCL_ENABLED
 	if (g_openclActive) {
 		BLI_thread_queue_wait_finish(g_gpuqueue);
-		BLI_thread_queue_wait_finish(g_cpuqueue);
 	}
-	else {
-		BLI_thread_queue_wait_finish(g_cpuqueue);
-	}
-#else
-	BLI_thread_queue_wait_finish(cpuqueue);
 #endif
+	BLI_mutex_lock(&g_cpuMutex);
+	while (g_cpuUnfinished > 0) {
+		BLI_condition_wait(&g_cpuFinishCondition, &g_cpuMutex);
+	}
+	BLI_mutex_unlock(&g_cpuMutex);
 #endif
 }
 void WorkScheduler::stop()
 {
 #if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-	BLI_thread_queue_nowait(g_cpuqueue);
+	unsigned int index;
+
+	BLI_mutex_lock(&g_cpuMutex);
+	g_cpuStopping = true;
+	for (index = 0; index < g_cpuworkers.size(); index++) {
+		BLI_condition_notify_one(&g_cpuworkers[index]->condition);
+	}
+	BLI_mutex_unlock(&g_cpuMutex);
 	BLI_end_threads(&g_cputhreads);
-	BLI_thread_queue_free(g_cpuqueue);
-	g_cpuqueue = NULL;
+
+	for (index = 0; index < g_cpuworkers.size(); index++) {
+		CPUWorker *worker = g_cpuworkers[index];
+		if (G.debug & G_DEBUG) {
+			printf("Compositor: thread %d executed %d chunks (%d stolen), busy %.3f s\n",
+			       worker->index, worker->numberOfExecuted, worker->numberOfStolen, worker->busyTime);
+		}
+		BLI_condition_end(&worker->condition);
+		BLI_mutex_end(&worker->mutex);
+		delete worker;
+	}
+	g_cpuworkers.clear();
+	BLI_condition_end(&g_cpuFinishCondition);
+	BLI_mutex_end(&g_cpuMutex);
 #ifdef COM_OPENCL_ENABLED
 	if (g_openclActive) {
 		BLI_thread_queue_nowait(g_gpuqueue);
@@ -264,6 +422,15 @@ bool WorkScheduler::hasGPUDevices()
 #endif
 }
 
+int WorkScheduler::getNumberOfCPUDevices()
+{
+#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+	return g_cpudevices.size();
+#else
+	return 1;
+#endif
+}
+
 static void clContextError(const char *errinfo, const void *private_info, size_t cb, void *user_data)
 {
 	printf("OPENCL error: %s\n", errinfo);
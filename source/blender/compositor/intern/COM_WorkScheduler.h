@@ -44,7 +44,8 @@ class WorkScheduler {
 
 	/**
 	 * @brief main thread loop for cpudevices
-	 * inside this loop new work is queried and being executed
+	 * inside this loop new work is taken from the queue of the thread and being executed.
+	 * When the queue of the thread is empty, work is stolen from the queues of the other threads.
 	 */
 	static void *thread_execute_cpu(void *data);
 
@@ -59,7 +60,8 @@ public:
 	 * @brief schedule a chunk of a group to be calculated.
 	 * An execution group schedules a chunk in the WorkScheduler
 	 * when ExecutionGroup.isOpenCL is set the work will be handled by a OpenCLDevice
-	 * otherwide the work is scheduled for an CPUDevice
+	 * otherwide the work is scheduled for an CPUDevice. Chunks that are scheduled after each other
+	 * are mostly neighbours, small runs of them are added to the queue of the same CPU thread.
 	 * @see ExecutionGroup.execute
 	 * @param group the execution group
 	 * @param chunkNumber the number of the chunk in the group to be executed
@@ -113,6 +115,12 @@ public:
 	 */
 	static bool hasGPUDevices();
 
+	/**
+	 * @brief number of CPU devices that execute the work packages
+	 * follows the thread count of the system, or the one given with --threads
+	 */
+	static int getNumberOfCPUDevices();
+
 #ifdef WITH_CXX_GUARDEDALLOC
 	MEM_CXX_CLASS_ALLOC_FUNCS("COM:WorkScheduler")
 #endif
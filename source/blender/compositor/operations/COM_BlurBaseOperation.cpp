@@ -91,6 +91,31 @@ float *BlurBaseOperation::make_gausstab(int rad)
 	return gausstab;
 }
 
+float BlurBaseOperation::sum_gausstab(const float *gausstab, int rad)
+{
+	const int step = getStep();
+	float sum = 0.0f;
+	int i;
+
+	/* same order as the pixels are summed, so the normalization is exact */
+	for (i = 0; i <= 2 * rad; i += step)
+		sum += gausstab[i];
+
+	return sum;
+}
+
+bool BlurBaseOperation::useRecursiveGauss(int rad)
+{
+	/* only the gaussian filter has a recursive equivalent */
+	return (this->m_data->filtertype == R_FILTER_GAUSS && rad >= COM_BLUR_RECURSIVE_MIN_RADIUS);
+}
+
+float BlurBaseOperation::gaussSigma(int rad)
+{
+	/* RE_filter_value(R_FILTER_GAUSS) is exp(-(1.6 * i / rad)^2), minus a small offset */
+	return (float)rad / (1.6f * (float)M_SQRT2);
+}
+
 /* normalized distance from the current (inverted so 1.0 is close and 0.0 is far)
  * 'ease' is applied after, looks nicer */
 float *BlurBaseOperation::make_dist_fac_inverse(int rad, int falloff)
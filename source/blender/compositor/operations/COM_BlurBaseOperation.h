@@ -34,6 +34,22 @@ protected:
 	float *make_gausstab(int rad);
 	float *make_dist_fac_inverse(int rad, int falloff);
 
+	/**
+	 * @brief sum of the weights of a kernel made by make_gausstab that are used at the quality step
+	 */
+	float sum_gausstab(const float *gausstab, int rad);
+
+	/**
+	 * @brief calculate a blur with this radius with the recursive gaussian filter
+	 * (FastGaussianBlurOperation::IIR_gauss) instead of summing the kernel
+	 */
+	bool useRecursiveGauss(int rad);
+
+	/**
+	 * @brief standard deviation of the gaussian filter kernel with this radius
+	 */
+	static float gaussSigma(int rad);
+
 	void updateSize();
 
 	/**
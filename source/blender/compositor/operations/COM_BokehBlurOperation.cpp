@@ -23,6 +23,8 @@
 #include "COM_BokehBlurOperation.h"
 #include "BLI_math.h"
 #include "COM_OpenCLDevice.h"
+#include "COM_FFTConvolution.h"
+#include "MEM_guardedalloc.h"
 
 extern "C" {
 	#include "RE_pipeline.h"
@@ -43,6 +45,8 @@ BokehBlurOperation::BokehBlurOperation() : NodeOperation()
 	this->m_inputProgram = NULL;
 	this->m_inputBokehProgram = NULL;
 	this->m_inputBoundingBoxReader = NULL;
+	this->m_useFFTConvolution = false;
+	this->m_convolvedBuffer = NULL;
 }
 
 void *BokehBlurOperation::initializeTileData(rcti *rect)
@@ -52,6 +56,9 @@ void *BokehBlurOperation::initializeTileData(rcti *rect)
 		updateSize();
 	}
 	void *buffer = getInputOperation(0)->initializeTileData(NULL);
+	if (this->m_useFFTConvolution && this->m_convolvedBuffer == NULL) {
+		convolveWithFFT((MemoryBuffer *)buffer);
+	}
 	unlockMutex();
 	return buffer;
 }
@@ -72,6 +79,40 @@ void BokehBlurOperation::initExecution()
 	this->m_bokehMidY = height / 2.0f;
 	this->m_bokehDimension = dimension / 2.0f;
 	QualityStepHelper::initExecution(COM_QH_INCREASE);
+
+	this->m_useFFTConvolution = false;
+	if (this->m_sizeavailable) {
+		const float max_dim = max(this->getWidth(), this->getHeight());
+		int pixelSize = this->m_size * max_dim / 100.0f;
+		this->m_useFFTConvolution = pixelSize >= 2 && FFTConvolution::isBeneficial(2 * pixelSize + 1, 2 * pixelSize + 1);
+	}
+}
+
+void BokehBlurOperation::convolveWithFFT(MemoryBuffer *inputBuffer)
+{
+	const float max_dim = max(this->getWidth(), this->getHeight());
+	const int pixelSize = this->m_size * max_dim / 100.0f;
+	const int kernelSize = 2 * pixelSize + 1;
+	const float m = this->m_bokehDimension / pixelSize;
+	const int width = inputBuffer->getWidth();
+	const int height = inputBuffer->getHeight();
+	float *kernel = (float *)MEM_callocN(sizeof(float) * COM_NUMBER_OF_CHANNELS * kernelSize * kernelSize, __func__);
+
+	/* kernel pixel (pixelSize - dx, pixelSize - dy) weights the input pixel at offset (dx, dy),
+	 * sampled like executePixel does. The offsets run from -pixelSize to pixelSize - 1 there, so
+	 * the first row and column stay zero */
+	for (int ky = 1; ky < kernelSize; ky++) {
+		for (int kx = 1; kx < kernelSize; kx++) {
+			float u = this->m_bokehMidX - (pixelSize - kx) * m;
+			float v = this->m_bokehMidY - (pixelSize - ky) * m;
+			this->m_inputBokehProgram->read(&kernel[(ky * kernelSize + kx) * COM_NUMBER_OF_CHANNELS], u, v, COM_PS_NEAREST);
+		}
+	}
+
+	this->m_convolvedBuffer = (float *)MEM_mapallocN(sizeof(float) * COM_NUMBER_OF_CHANNELS * width * height, __func__);
+	FFTConvolution::convolve(this->m_convolvedBuffer, inputBuffer->getBuffer(), width, height,
+	                         kernel, kernelSize, kernelSize, COM_NUMBER_OF_CHANNELS, COM_NUMBER_OF_CHANNELS, true);
+	MEM_freeN(kernel);
 }
 
 void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
@@ -81,7 +122,12 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 	float bokeh[4];
 
 	this->m_inputBoundingBoxReader->read(tempBoundingBox, x, y, COM_PS_NEAREST);
-	if (tempBoundingBox[0] > 0.0f) {
+	if (tempBoundingBox[0] > 0.0f && this->m_convolvedBuffer) {
+		MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
+		int offset = ((y - inputBuffer->getRect()->ymin) * inputBuffer->getWidth() + (x - inputBuffer->getRect()->xmin)) * COM_NUMBER_OF_CHANNELS;
+		copy_v4_v4(output, &this->m_convolvedBuffer[offset]);
+	}
+	else if (tempBoundingBox[0] > 0.0f) {
 		float multiplier_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 		MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
 		float *buffer = inputBuffer->getBuffer();
@@ -137,6 +183,10 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 void BokehBlurOperation::deinitExecution()
 {
 	deinitMutex();
+	if (this->m_convolvedBuffer) {
+		MEM_freeN(this->m_convolvedBuffer);
+		this->m_convolvedBuffer = NULL;
+	}
 	this->m_inputProgram = NULL;
 	this->m_inputBokehProgram = NULL;
 	this->m_inputBoundingBoxReader = NULL;
@@ -148,7 +198,13 @@ bool BokehBlurOperation::determineDependingAreaOfInterest(rcti *input, ReadBuffe
 	rcti bokehInput;
 	const float max_dim = max(this->getWidth(), this->getHeight());
 
-	if (this->m_sizeavailable) {
+	if (this->m_useFFTConvolution) {
+		newInput.xmin = 0;
+		newInput.ymin = 0;
+		newInput.xmax = this->getWidth();
+		newInput.ymax = this->getHeight();
+	}
+	else if (this->m_sizeavailable) {
 		newInput.xmax = input->xmax + (this->m_size * max_dim / 100.0f);
 		newInput.xmin = input->xmin - (this->m_size * max_dim / 100.0f);
 		newInput.ymax = input->ymax + (this->m_size * max_dim / 100.0f);
@@ -36,6 +36,14 @@ private:
 	float m_bokehMidX;
 	float m_bokehMidY;
 	float m_bokehDimension;
+
+	/**
+	 * @brief large constant sized kernels are convolved with the whole image at once
+	 * @see FFTConvolution
+	 */
+	bool m_useFFTConvolution;
+	float *m_convolvedBuffer;
+	void convolveWithFFT(MemoryBuffer *inputBuffer);
 public:
 	BokehBlurOperation();
 
@@ -50,6 +50,8 @@ public:
 	 * the inner loop of this program
 	 */
 	void executePixel(float output[4], float x, float y, PixelSampler sampler);
+	void executeKernel(float output[4], const float *inputs[]);
+	const bool isPixelKernel() const { return true; }
 	
 	/**
 	 * Initialize the execution
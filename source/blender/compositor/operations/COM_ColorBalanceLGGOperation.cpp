@@ -58,12 +58,18 @@ void ColorBalanceLGGOperation::executePixel(float output[4], float x, float y, P
 {
 	float inputColor[4];
 	float value[4];
+	const float *inputs[2] = {value, inputColor};
 	
 	this->m_inputValueOperation->read(value, x, y, sampler);
 	this->m_inputColorOperation->read(inputColor, x, y, sampler);
-	
-	float fac = value[0];
-	fac = min(1.0f, fac);
+
+	this->executeKernel(output, inputs);
+}
+
+void ColorBalanceLGGOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputColor = inputs[1];
+	float fac = min(1.0f, inputs[0][0]);
 	const float mfac = 1.0f - fac;
 	
 	output[0] = mfac * inputColor[0] + fac * colorbalance_lgg(inputColor[0], this->m_lift[0], this->m_gamma_inv[0], this->m_gain[0]);
@@ -60,26 +60,36 @@ void ColorCurveOperation::initExecution()
 
 void ColorCurveOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
-	CurveMapping *cumap = this->m_curveMapping;
-	
 	float fac[4];
 	float image[4];
-
-	/* local versions of cumap->black, cumap->white, cumap->bwmul */
 	float black[4];
 	float white[4];
-	float bwmul[3];
+	const float *inputs[4] = {fac, image, black, white};
 
+	this->m_inputFacProgram->read(fac, x, y, sampler);
+	this->m_inputImageProgram->read(image, x, y, sampler);
 	this->m_inputBlackProgram->read(black, x, y, sampler);
 	this->m_inputWhiteProgram->read(white, x, y, sampler);
 
+	this->executeKernel(output, inputs);
+}
+
+void ColorCurveOperation::executeKernel(float output[4], const float *inputs[])
+{
+	CurveMapping *cumap = this->m_curveMapping;
+	
+	const float *fac = inputs[0];
+	const float *image = inputs[1];
+
+	/* local versions of cumap->black, cumap->white, cumap->bwmul */
+	const float *black = inputs[2];
+	const float *white = inputs[3];
+	float bwmul[3];
+
 	/* get our own local bwmul value,
 	 * since we can't be threadsafe and use cumap->bwmul & friends */
 	curvemapping_set_black_white_ex(black, white, bwmul);
 
-	this->m_inputFacProgram->read(fac, x, y, sampler);
-	this->m_inputImageProgram->read(image, x, y, sampler);
-
 	if (*fac >= 1.0f) {
 		curvemapping_evaluate_premulRGBF_ex(cumap, output, image,
 		                                    black, bwmul);
@@ -134,10 +144,19 @@ void ConstantLevelColorCurveOperation::executePixel(float output[4], float x, fl
 {
 	float fac[4];
 	float image[4];
+	const float *inputs[2] = {fac, image};
 
 	this->m_inputFacProgram->read(fac, x, y, sampler);
 	this->m_inputImageProgram->read(image, x, y, sampler);
 
+	this->executeKernel(output, inputs);
+}
+
+void ConstantLevelColorCurveOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *fac = inputs[0];
+	const float *image = inputs[1];
+
 	if (*fac >= 1.0f) {
 		curvemapping_evaluate_premulRGBF(this->m_curveMapping, output, image);
 	}
@@ -37,8 +37,24 @@ void ConvertColorToBWOperation::initExecution()
 void ConvertColorToBWOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputColor[4];
+	const float *inputs[1] = {inputColor};
+
 	this->m_inputOperation->read(&inputColor[0], x, y, sampler);
-	output[0] = rgb_to_bw(inputColor);
+	this->executeKernel(output, inputs);
+}
+
+void ConvertColorToBWOperation::executeKernel(float output[4], const float *inputs[])
+{
+	output[0] = rgb_to_bw(inputs[0]);
+}
+
+void ConvertColorToBWOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	this->m_inputOperation->readRow(output, x, y, length, sampler);
+
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		output[0] = rgb_to_bw(output);
+	}
 }
 
 void ConvertColorToBWOperation::deinitExecution()
@@ -37,10 +37,27 @@ void ConvertColorToValueProg::initExecution()
 void ConvertColorToValueProg::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputColor[4];
+	const float *inputs[1] = {inputColor};
+
 	this->m_inputOperation->read(&inputColor[0], x, y, sampler);
+	this->executeKernel(output, inputs);
+}
+
+void ConvertColorToValueProg::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputColor = inputs[0];
 	output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
 }
 
+void ConvertColorToValueProg::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	this->m_inputOperation->readRow(output, x, y, length, sampler);
+
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		output[0] = (output[0] + output[1] + output[2]) / 3.0f;
+	}
+}
+
 void ConvertColorToValueProg::deinitExecution()
 {
 	this->m_inputOperation = NULL;
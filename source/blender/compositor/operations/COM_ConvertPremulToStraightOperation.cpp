@@ -38,10 +38,16 @@ void ConvertPremulToStraightOperation::initExecution()
 void ConvertPremulToStraightOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputValue[4];
-	float alpha;
+	const float *inputs[1] = {inputValue};
 
 	this->m_inputColor->read(inputValue, x, y, sampler);
-	alpha = inputValue[3];
+	this->executeKernel(output, inputs);
+}
+
+void ConvertPremulToStraightOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputValue = inputs[0];
+	const float alpha = inputValue[3];
 
 	if (fabsf(alpha) < 1e-5f) {
 		zero_v3(output);
@@ -54,6 +60,22 @@ void ConvertPremulToStraightOperation::executePixel(float output[4], float x, fl
 	output[3] = alpha;
 }
 
+void ConvertPremulToStraightOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	this->m_inputColor->readRow(output, x, y, length, sampler);
+
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		const float alpha = output[3];
+
+		if (fabsf(alpha) < 1e-5f) {
+			zero_v3(output);
+		}
+		else {
+			mul_v3_fl(output, 1.0f / alpha);
+		}
+	}
+}
+
 void ConvertPremulToStraightOperation::deinitExecution()
 {
 	this->m_inputColor = NULL;
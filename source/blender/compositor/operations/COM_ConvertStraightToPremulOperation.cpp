@@ -38,10 +38,16 @@ void ConvertStraightToPremulOperation::initExecution()
 void ConvertStraightToPremulOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputValue[4];
-	float alpha;
+	const float *inputs[1] = {inputValue};
 
 	this->m_inputColor->read(inputValue, x, y, sampler);
-	alpha = inputValue[3];
+	this->executeKernel(output, inputs);
+}
+
+void ConvertStraightToPremulOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputValue = inputs[0];
+	const float alpha = inputValue[3];
 
 	mul_v3_v3fl(output, inputValue, alpha);
 
@@ -49,6 +55,15 @@ void ConvertStraightToPremulOperation::executePixel(float output[4], float x, fl
 	output[3] = alpha;
 }
 
+void ConvertStraightToPremulOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	this->m_inputColor->readRow(output, x, y, length, sampler);
+
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		mul_v3_fl(output, output[3]);
+	}
+}
+
 void ConvertStraightToPremulOperation::deinitExecution()
 {
 	this->m_inputColor = NULL;
@@ -36,11 +36,29 @@ void ConvertValueToColorProg::initExecution()
 void ConvertValueToColorProg::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputValue[4];
+	const float *inputs[1] = {inputValue};
+
 	this->m_inputProgram->read(inputValue, x, y, sampler);
-	output[0] = output[1] = output[2] = inputValue[0];
+	this->executeKernel(output, inputs);
+}
+
+void ConvertValueToColorProg::executeKernel(float output[4], const float *inputs[])
+{
+	output[0] = output[1] = output[2] = inputs[0][0];
 	output[3] = 1.0f;
 }
 
+void ConvertValueToColorProg::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	/* convert in place, every output pixel only depends on the input pixel at the same position */
+	this->m_inputProgram->readRow(output, x, y, length, sampler);
+
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		output[1] = output[2] = output[0];
+		output[3] = 1.0f;
+	}
+}
+
 void ConvertValueToColorProg::deinitExecution()
 {
 	this->m_inputProgram = NULL;
@@ -74,6 +74,7 @@ void DilateErodeThresholdOperation::executePixel(float output[4], int x, int y,
 
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
 	float *buffer = inputBuffer->getBuffer();
+	const int numberOfChannels = inputBuffer->getNumberOfChannels();
 	rcti *rect = inputBuffer->getRect();
 	const int minx = max(x - this->m_scope, rect->xmin);
 	const int miny = max(y - this->m_scope, rect->ymin);
@@ -86,14 +87,14 @@ void DilateErodeThresholdOperation::executePixel(float output[4], int x, int y,
 	if (inputValue[0] > sw) {
 		for (int yi = miny; yi < maxy; yi++) {
 			const float dy = yi - y;
-			offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * 4;
+			offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * numberOfChannels;
 			for (int xi = minx; xi < maxx; xi++) {
 				if (buffer[offset] < sw) {
 					const float dx = xi - x;
 					const float dis = dx * dx + dy * dy;
 					mindist = min(mindist, dis);
 				}
-				offset += 4;
+				offset += numberOfChannels;
 			}
 		}
 		pixelvalue = -sqrtf(mindist);
@@ -101,14 +102,14 @@ void DilateErodeThresholdOperation::executePixel(float output[4], int x, int y,
 	else {
 		for (int yi = miny; yi < maxy; yi++) {
 			const float dy = yi - y;
-			offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * 4;
+			offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * numberOfChannels;
 			for (int xi = minx; xi < maxx; xi++) {
 				if (buffer[offset] > sw) {
 					const float dx = xi - x;
 					const float dis = dx * dx + dy * dy;
 					mindist = min(mindist, dis);
 				}
-				offset += 4;
+				offset += numberOfChannels;
 
 			}
 		}
@@ -194,6 +195,7 @@ void DilateDistanceOperation::executePixel(float output[4], int x, int y, void *
 
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
 	float *buffer = inputBuffer->getBuffer();
+	const int numberOfChannels = inputBuffer->getNumberOfChannels();
 	rcti *rect = inputBuffer->getRect();
 	const int minx = max(x - this->m_scope, rect->xmin);
 	const int miny = max(y - this->m_scope, rect->ymin);
@@ -206,14 +208,14 @@ void DilateDistanceOperation::executePixel(float output[4], int x, int y, void *
 
 	for (int yi = miny; yi < maxy; yi++) {
 		const float dy = yi - y;
-		offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * 4;
+		offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * numberOfChannels;
 		for (int xi = minx; xi < maxx; xi++) {
 			const float dx = xi - x;
 			const float dis = dx * dx + dy * dy;
 			if (dis <= mindist) {
 				value = max(buffer[offset], value);
 			}
-			offset += 4;
+			offset += numberOfChannels;
 		}
 	}
 	output[0] = value;
@@ -268,6 +270,7 @@ void ErodeDistanceOperation::executePixel(float output[4], int x, int y, void *d
 
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
 	float *buffer = inputBuffer->getBuffer();
+	const int numberOfChannels = inputBuffer->getNumberOfChannels();
 	rcti *rect = inputBuffer->getRect();
 	const int minx = max(x - this->m_scope, rect->xmin);
 	const int miny = max(y - this->m_scope, rect->ymin);
@@ -280,14 +283,14 @@ void ErodeDistanceOperation::executePixel(float output[4], int x, int y, void *d
 
 	for (int yi = miny; yi < maxy; yi++) {
 		const float dy = yi - y;
-		offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * 4;
+		offset = ((yi - rect->ymin) * bufferWidth + (minx - rect->xmin)) * numberOfChannels;
 		for (int xi = minx; xi < maxx; xi++) {
 			const float dx = xi - x;
 			const float dis = dx * dx + dy * dy;
 			if (dis <= mindist) {
 				value = min(buffer[offset], value);
 			}
-			offset += 4;
+			offset += numberOfChannels;
 		}
 	}
 	output[0] = value;
@@ -352,6 +355,7 @@ void *DilateStepOperation::initializeTileData(rcti *rect)
 	int width = tile->getWidth();
 	int height = tile->getHeight();
 	float *buffer = tile->getBuffer();
+	const int numberOfChannels = tile->getNumberOfChannels();
 
 	int half_window = this->m_iterations;
 	int window = half_window * 2 + 1;
@@ -383,7 +387,7 @@ void *DilateStepOperation::initializeTileData(rcti *rect)
 			buf[x] = -MAXFLOAT;
 		}
 		for (x = xmin; x < xmax; ++x) {
-			buf[x - rect->xmin + window - 1] = buffer[4 * (y * width + x)];
+			buf[x - rect->xmin + window - 1] = buffer[numberOfChannels * (y * width + x)];
 		}
 
 		for (i = 0; i < (bwidth + 3 * half_window) / window; i++) {
@@ -479,6 +483,7 @@ void *ErodeStepOperation::initializeTileData(rcti *rect)
 	int width = tile->getWidth();
 	int height = tile->getHeight();
 	float *buffer = tile->getBuffer();
+	const int numberOfChannels = tile->getNumberOfChannels();
 
 	int half_window = this->m_iterations;
 	int window = half_window * 2 + 1;
@@ -510,7 +515,7 @@ void *ErodeStepOperation::initializeTileData(rcti *rect)
 			buf[x] = MAXFLOAT;
 		}
 		for (x = xmin; x < xmax; ++x) {
-			buf[x - rect->xmin + window - 1] = buffer[4 * (y * width + x)];
+			buf[x - rect->xmin + window - 1] = buffer[numberOfChannels * (y * width + x)];
 		}
 
 		for (i = 0; i < (bwidth + 3 * half_window) / window; i++) {
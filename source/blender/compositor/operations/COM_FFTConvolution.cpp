@@ -0,0 +1,497 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <string.h>
+
+#include "COM_FFTConvolution.h"
+#include "MEM_guardedalloc.h"
+#include "BLI_math.h"
+#include "COM_ParallelExecution.h"
+
+/*
+ *  2D Fast Hartley Transform, used for convolution
+ */
+
+typedef float fREAL;
+
+// returns next highest power of 2 of x, as well it's log2 in L2
+static unsigned int nextPow2(unsigned int x, unsigned int *L2)
+{
+	unsigned int pw, x_notpow2 = x & (x - 1);
+	*L2 = 0;
+	while (x >>= 1) ++(*L2);
+	pw = 1 << (*L2);
+	if (x_notpow2) { (*L2)++;  pw <<= 1; }
+	return pw;
+}
+
+//------------------------------------------------------------------------------
+
+// from FXT library by Joerg Arndt, faster in order bitreversal
+// use: r = revbin_upd(r, h) where h = N>>1
+static unsigned int revbin_upd(unsigned int r, unsigned int h)
+{
+	while (!((r ^= h) & h)) h >>= 1;
+	return r;
+}
+//------------------------------------------------------------------------------
+static void FHT(fREAL *data, unsigned int M, unsigned int inverse)
+{
+	double tt, fc, dc, fs, ds, a = M_PI;
+	fREAL t1, t2;
+	int n2, bd, bl, istep, k, len = 1 << M, n = 1;
+
+	int i, j = 0;
+	unsigned int Nh = len >> 1;
+	for (i = 1; i < (len - 1); ++i) {
+		j = revbin_upd(j, Nh);
+		if (j > i) {
+			t1 = data[i];
+			data[i] = data[j];
+			data[j] = t1;
+		}
+	}
+
+	do {
+		fREAL *data_n = &data[n];
+
+		istep = n << 1;
+		for (k = 0; k < len; k += istep) {
+			t1 = data_n[k];
+			data_n[k] = data[k] - t1;
+			data[k] += t1;
+		}
+
+		n2 = n >> 1;
+		if (n > 2) {
+			fc = dc = cos(a);
+			fs = ds = sqrt(1.0 - fc * fc); //sin(a);
+			bd = n - 2;
+			for (bl = 1; bl < n2; bl++) {
+				fREAL *data_nbd = &data_n[bd];
+				fREAL *data_bd = &data[bd];
+				for (k = bl; k < len; k += istep) {
+					t1 = fc * (double)data_n[k] + fs * (double)data_nbd[k];
+					t2 = fs * (double)data_n[k] - fc * (double)data_nbd[k];
+					data_n[k] = data[k] - t1;
+					data_nbd[k] = data_bd[k] - t2;
+					data[k] += t1;
+					data_bd[k] += t2;
+				}
+				tt = fc * dc - fs * ds;
+				fs = fs * dc + fc * ds;
+				fc = tt;
+				bd -= 2;
+			}
+		}
+
+		if (n > 1) {
+			for (k = n2; k < len; k += istep) {
+				t1 = data_n[k];
+				data_n[k] = data[k] - t1;
+				data[k] += t1;
+			}
+		}
+
+		n = istep;
+		a *= 0.5;
+	} while (n < len);
+
+	if (inverse) {
+		fREAL sc = (fREAL)1 / (fREAL)len;
+		for (k = 0; k < len; ++k)
+			data[k] *= sc;
+	}
+}
+//------------------------------------------------------------------------------
+
+/* size of the tiles the data is transposed in, so the rows read and written stay in the cache */
+#define FHT_TRANSPOSE_TILE 32
+
+/* dst = transposed src, src has Ny rows of Nx */
+static void fht_transpose(fREAL *dst, const fREAL *src, unsigned int Nx, unsigned int Ny)
+{
+	unsigned int i, j, ti, tj;
+
+	for (tj = 0; tj < Ny; tj += FHT_TRANSPOSE_TILE) {
+		const unsigned int maxj = min_ii(tj + FHT_TRANSPOSE_TILE, Ny);
+		for (ti = 0; ti < Nx; ti += FHT_TRANSPOSE_TILE) {
+			const unsigned int maxi = min_ii(ti + FHT_TRANSPOSE_TILE, Nx);
+			for (j = tj; j < maxj; j++) {
+				const fREAL *row = &src[j * Nx];
+				for (i = ti; i < maxi; i++)
+					dst[i * Ny + j] = row[i];
+			}
+		}
+	}
+}
+
+/* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
+ * nzp -> the row where zero pad data starts,
+ * inverse -> see above,
+ * scratch -> room for a copy of data, the data is transposed into it */
+static void FHT2D(fREAL *data, fREAL *scratch, unsigned int Mx, unsigned int My,
+                  unsigned int nzp, unsigned int inverse)
+{
+	unsigned int i, j, Nx, Ny, maxy;
+
+	Nx = 1 << Mx;
+	Ny = 1 << My;
+
+	// rows (forward transform skips 0 pad data)
+	maxy = inverse ? Ny : min_ii(nzp, Ny);
+	for (j = 0; j < maxy; ++j)
+		FHT(&data[Nx * j], Mx, inverse);
+
+	// transpose data
+	fht_transpose(scratch, data, Nx, Ny);
+
+	// swap Mx/My & Nx/Ny
+	i = Nx, Nx = Ny, Ny = i;
+	i = Mx, Mx = My, My = i;
+
+	// now columns == transposed rows
+	for (j = 0; j < Ny; ++j)
+		FHT(&scratch[Nx * j], Mx, inverse);
+
+	// finalize
+	for (j = 0; j <= (Ny >> 1); j++) {
+		unsigned int jm = (Ny - j) & (Ny - 1);
+		unsigned int ji = j << Mx;
+		unsigned int jmi = jm << Mx;
+		for (i = 0; i <= (Nx >> 1); i++) {
+			unsigned int im = (Nx - i) & (Nx - 1);
+			fREAL A = scratch[ji + i];
+			fREAL B = scratch[jmi + i];
+			fREAL C = scratch[ji + im];
+			fREAL D = scratch[jmi + im];
+			fREAL E = (fREAL)0.5 * ((A + D) - (B + C));
+			scratch[ji + i] = A - E;
+			scratch[jmi + i] = B + E;
+			scratch[ji + im] = C + E;
+			scratch[jmi + im] = D - E;
+		}
+	}
+
+	memcpy(data, scratch, sizeof(fREAL) * Nx * Ny);
+}
+
+//------------------------------------------------------------------------------
+
+/* 2D convolution calc, d1 *= d2, M/N - > log2 of width/height */
+static void fht_convolve(fREAL *d1, const fREAL *d2, unsigned int M, unsigned int N)
+{
+	fREAL a, b;
+	unsigned int i, j, k, L, mj, mL;
+	unsigned int m = 1 << M, n = 1 << N;
+	unsigned int m2 = 1 << (M - 1), n2 = 1 << (N - 1);
+	unsigned int mn2 = m << (N - 1);
+
+	d1[0] *= d2[0];
+	d1[mn2] *= d2[mn2];
+	d1[m2] *= d2[m2];
+	d1[m2 + mn2] *= d2[m2 + mn2];
+	for (i = 1; i < m2; i++) {
+		k = m - i;
+		a = d1[i] * d2[i] - d1[k] * d2[k];
+		b = d1[k] * d2[i] + d1[i] * d2[k];
+		d1[i] = (b + a) * (fREAL)0.5;
+		d1[k] = (b - a) * (fREAL)0.5;
+		a = d1[i + mn2] * d2[i + mn2] - d1[k + mn2] * d2[k + mn2];
+		b = d1[k + mn2] * d2[i + mn2] + d1[i + mn2] * d2[k + mn2];
+		d1[i + mn2] = (b + a) * (fREAL)0.5;
+		d1[k + mn2] = (b - a) * (fREAL)0.5;
+	}
+	for (j = 1; j < n2; j++) {
+		L = n - j;
+		mj = j << M;
+		mL = L << M;
+		a = d1[mj] * d2[mj] - d1[mL] * d2[mL];
+		b = d1[mL] * d2[mj] + d1[mj] * d2[mL];
+		d1[mj] = (b + a) * (fREAL)0.5;
+		d1[mL] = (b - a) * (fREAL)0.5;
+		a = d1[m2 + mj] * d2[m2 + mj] - d1[m2 + mL] * d2[m2 + mL];
+		b = d1[m2 + mL] * d2[m2 + mj] + d1[m2 + mj] * d2[m2 + mL];
+		d1[m2 + mj] = (b + a) * (fREAL)0.5;
+		d1[m2 + mL] = (b - a) * (fREAL)0.5;
+	}
+	for (i = 1; i < m2; i++) {
+		k = m - i;
+		for (j = 1; j < n2; j++) {
+			L = n - j;
+			mj = j << M;
+			mL = L << M;
+			a = d1[i + mj] * d2[i + mj] - d1[k + mL] * d2[k + mL];
+			b = d1[k + mL] * d2[i + mj] + d1[i + mj] * d2[k + mL];
+			d1[i + mj] = (b + a) * (fREAL)0.5;
+			d1[k + mL] = (b - a) * (fREAL)0.5;
+			a = d1[i + mL] * d2[i + mL] - d1[k + mj] * d2[k + mj];
+			b = d1[k + mj] * d2[i + mL] + d1[i + mL] * d2[k + mj];
+			d1[i + mL] = (b + a) * (fREAL)0.5;
+			d1[k + mj] = (b - a) * (fREAL)0.5;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+
+/*
+ *  Threaded block add-overlap
+ */
+
+/* the kernels are transformed in the first pass, the blocks in the next four passes. Blocks
+ * overlap their direct neighbours, so each block pass only handles blocks that are two blocks
+ * apart in both directions and the threads never add to the same pixels */
+#define FFT_PASS_KERNELS 0
+#define FFT_PASS_BLOCKS 1
+#define FFT_NUMBER_OF_PASSES 5
+
+typedef struct FFTConvolutionData {
+	float *output;
+	const float *image;
+	int width;
+	int height;
+	const float *kernel;
+	int kernelWidth;
+	int kernelHeight;
+	int kernelChannels;
+	int numberOfChannels;
+
+	/* transform size, power of 2, and its log2 */
+	unsigned int w2, h2;
+	unsigned int log2_w, log2_h;
+
+	/* size and number of the image blocks */
+	int xbsz, ybsz;
+	int nxb, nyb;
+
+	/* transformed kernels, w2 * h2 values per kernel */
+	fREAL *kernelData;
+	int numberOfKernels;
+
+	/* the current pass */
+	int pass;
+} FFTConvolutionData;
+
+/* number of blocks in a block pass, in x and y direction */
+static void fft_convolution_pass_blocks(FFTConvolutionData *data, int pass, int *r_blocksx, int *r_blocksy)
+{
+	const int xoffset = (pass - FFT_PASS_BLOCKS) & 1;
+	const int yoffset = (pass - FFT_PASS_BLOCKS) >> 1;
+
+	*r_blocksx = (data->nxb - xoffset + 1) / 2;
+	*r_blocksy = (data->nyb - yoffset + 1) / 2;
+}
+
+static void fft_convolution_kernel(FFTConvolutionData *data, int kernelIndex, fREAL *scratch)
+{
+	const int kernelChannels = data->kernelChannels;
+	fREAL *kernelData = &data->kernelData[kernelIndex * data->w2 * data->h2];
+	int x, y;
+
+	for (y = 0; y < data->kernelHeight; y++) {
+		fREAL *fp = &kernelData[y * data->w2];
+		const float *kp = &data->kernel[(y * data->kernelWidth) * kernelChannels + kernelIndex];
+		for (x = 0; x < data->kernelWidth; x++, kp += kernelChannels)
+			fp[x] = *kp;
+	}
+
+	FHT2D(kernelData, scratch, data->log2_w, data->log2_h, data->kernelHeight, 0);
+}
+
+static void fft_convolution_block(FFTConvolutionData *data, int job, fREAL *block, fREAL *scratch)
+{
+	const int channel = job % data->numberOfChannels;
+	const int kernelIndex = data->numberOfKernels == 1 ? 0 : channel;
+	const fREAL *kernelData = &data->kernelData[kernelIndex * data->w2 * data->h2];
+	const int hw = data->kernelWidth >> 1;
+	const int hh = data->kernelHeight >> 1;
+	int blocksx, blocksy, x, y;
+
+	fft_convolution_pass_blocks(data, data->pass, &blocksx, &blocksy);
+	job /= data->numberOfChannels;
+	const int xbl = ((data->pass - FFT_PASS_BLOCKS) & 1) + 2 * (job % blocksx);
+	const int ybl = ((data->pass - FFT_PASS_BLOCKS) >> 1) + 2 * (job / blocksx);
+	const int xstart = xbl * data->xbsz;
+	const int ystart = ybl * data->ybsz;
+	const int xend = min_ii(xstart + data->xbsz, data->width);
+	const int yend = min_ii(ystart + data->ybsz, data->height);
+
+	// image block, channel -> block
+	memset(block, 0, data->w2 * data->h2 * sizeof(fREAL));
+	for (y = ystart; y < yend; y++) {
+		fREAL *fp = &block[(y - ystart) * data->w2];
+		const float *colp = &data->image[(y * data->width + xstart) * COM_NUMBER_OF_CHANNELS + channel];
+		for (x = xstart; x < xend; x++, colp += COM_NUMBER_OF_CHANNELS)
+			*fp++ = *colp;
+	}
+
+	// forward FHT, FHT2D transposed data, row/col now swapped
+	// convolve & inverse FHT
+	FHT2D(block, scratch, data->log2_w, data->log2_h, yend - ystart, 0);
+	fht_convolve(block, kernelData, data->log2_h, data->log2_w);
+	FHT2D(block, scratch, data->log2_h, data->log2_w, 0, 1);
+	// data again transposed, so in order again
+
+	// overlap-add result
+	for (y = 0; y < (int)data->h2; y++) {
+		const int yy = ystart + y - hh;
+		if ((yy < 0) || (yy >= data->height)) continue;
+		const fREAL *fp = &block[y * data->w2];
+		float *colp = &data->output[yy * data->width * COM_NUMBER_OF_CHANNELS + channel];
+		for (x = 0; x < (int)data->w2; x++) {
+			const int xx = xstart + x - hw;
+			if ((xx < 0) || (xx >= data->width)) continue;
+			colp[xx * COM_NUMBER_OF_CHANNELS] += fp[x];
+		}
+	}
+}
+
+static void fft_convolution_jobs(void *data_v, int start, int end)
+{
+	FFTConvolutionData *data = (FFTConvolutionData *)data_v;
+	const unsigned int size = data->w2 * data->h2;
+	fREAL *block = (fREAL *)MEM_mallocN(2 * size * sizeof(fREAL), "FFT convolution block");
+	fREAL *scratch = &block[size];
+	int job;
+
+	for (job = start; job < end; job++) {
+		if (data->pass == FFT_PASS_KERNELS) {
+			fft_convolution_kernel(data, job, scratch);
+		}
+		else {
+			fft_convolution_block(data, job, block, scratch);
+		}
+	}
+
+	MEM_freeN(block);
+}
+
+static void fft_convolution_pass(FFTConvolutionData *data, int pass)
+{
+	int numberOfJobs;
+
+	if (pass == FFT_PASS_KERNELS) {
+		numberOfJobs = data->numberOfKernels;
+	}
+	else {
+		int blocksx, blocksy;
+		fft_convolution_pass_blocks(data, pass, &blocksx, &blocksy);
+		numberOfJobs = blocksx * blocksy * data->numberOfChannels;
+	}
+
+	data->pass = pass;
+	ParallelExecution::execute(numberOfJobs, 1, fft_convolution_jobs, data);
+}
+
+/* divide by the sum of the kernel values that were multiplied with pixels inside the image,
+ * these sums are rectangles of the kernel, looked up in a summed area table */
+static void fft_convolution_normalize(FFTConvolutionData *data)
+{
+	const int kernelWidth = data->kernelWidth;
+	const int kernelHeight = data->kernelHeight;
+	const int tableWidth = kernelWidth + 1;
+	const int hw = kernelWidth >> 1;
+	const int hh = kernelHeight >> 1;
+	double *table = (double *)MEM_callocN(sizeof(double) * tableWidth * (kernelHeight + 1), "FFT convolution weights");
+	int kernelIndex, x, y, channel;
+
+	for (kernelIndex = 0; kernelIndex < data->numberOfKernels; kernelIndex++) {
+		const int firstChannel = data->numberOfKernels == 1 ? 0 : kernelIndex;
+		const int lastChannel = data->numberOfKernels == 1 ? data->numberOfChannels : kernelIndex + 1;
+
+		for (y = 0; y < kernelHeight; y++) {
+			const float *kp = &data->kernel[(y * kernelWidth) * data->kernelChannels + kernelIndex];
+			double rowSum = 0.0;
+			for (x = 0; x < kernelWidth; x++, kp += data->kernelChannels) {
+				rowSum += *kp;
+				table[(y + 1) * tableWidth + x + 1] = table[y * tableWidth + x + 1] + rowSum;
+			}
+		}
+
+		for (y = 0; y < data->height; y++) {
+			/* kernel rows j that multiplied image row y - j + hh inside the image */
+			const int miny = max_ii(0, y + hh - data->height + 1);
+			const int maxy = min_ii(kernelHeight, y + hh + 1);
+			float *colp = &data->output[y * data->width * COM_NUMBER_OF_CHANNELS];
+
+			for (x = 0; x < data->width; x++, colp += COM_NUMBER_OF_CHANNELS) {
+				const int minx = max_ii(0, x + hw - data->width + 1);
+				const int maxx = min_ii(kernelWidth, x + hw + 1);
+				const double sum = table[maxy * tableWidth + maxx] - table[miny * tableWidth + maxx] -
+				                   table[maxy * tableWidth + minx] + table[miny * tableWidth + minx];
+
+				if (sum != 0.0) {
+					const float weight = 1.0 / sum;
+					for (channel = firstChannel; channel < lastChannel; channel++)
+						colp[channel] *= weight;
+				}
+			}
+		}
+	}
+
+	MEM_freeN(table);
+}
+
+bool FFTConvolution::isBeneficial(int kernelWidth, int kernelHeight)
+{
+	return kernelWidth * kernelHeight >= COM_FFT_CONVOLUTION_MIN_SIZE * COM_FFT_CONVOLUTION_MIN_SIZE;
+}
+
+void FFTConvolution::convolve(float *output, const float *image, int width, int height,
+                              const float *kernel, int kernelWidth, int kernelHeight, int kernelChannels,
+                              int numberOfChannels, bool normalize)
+{
+	FFTConvolutionData data;
+	int pass;
+
+	data.output = output;
+	data.image = image;
+	data.width = width;
+	data.height = height;
+	data.kernel = kernel;
+	data.kernelWidth = kernelWidth;
+	data.kernelHeight = kernelHeight;
+	data.kernelChannels = kernelChannels;
+	data.numberOfChannels = numberOfChannels;
+	data.numberOfKernels = kernelChannels == 1 ? 1 : numberOfChannels;
+
+	// convolution result width & height
+	// FFT pow2 required size & log2
+	data.w2 = nextPow2(max_ii(2 * kernelWidth - 1, 2), &data.log2_w);
+	data.h2 = nextPow2(max_ii(2 * kernelHeight - 1, 2), &data.log2_h);
+
+	// block add-overlap
+	data.xbsz = (data.w2 + 1) - kernelWidth;
+	data.ybsz = (data.h2 + 1) - kernelHeight;
+	data.nxb = (width + data.xbsz - 1) / data.xbsz;
+	data.nyb = (height + data.ybsz - 1) / data.ybsz;
+
+	data.kernelData = (fREAL *)MEM_callocN(data.numberOfKernels * data.w2 * data.h2 * sizeof(fREAL), "FFT convolution kernels");
+
+	memset(output, 0, sizeof(float) * width * height * COM_NUMBER_OF_CHANNELS);
+	for (pass = 0; pass < FFT_NUMBER_OF_PASSES; pass++) {
+		fft_convolution_pass(&data, pass);
+	}
+
+	MEM_freeN(data.kernelData);
+
+	if (normalize) {
+		fft_convolution_normalize(&data);
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_FFTConvolution_h
+#define _COM_FFTConvolution_h
+#include "COM_defines.h"
+
+/**
+ * @brief convolution of a whole image with a large kernel using the fast Hartley transform
+ *
+ * The image is split in blocks that are convolved separately and added together (overlap-add).
+ * The blocks and channels are divided over threads. Direct summation costs a multiplication per
+ * kernel pixel for every image pixel, while the transforms grow with the logarithm of the kernel
+ * size, so operations with large kernels (fog glow, bokeh blur, gaussian bokeh blur) use this
+ * when the kernel is at least COM_FFT_CONVOLUTION_MIN_SIZE pixels wide and high.
+ * @ingroup Operation
+ */
+class FFTConvolution {
+public:
+	/**
+	 * @brief is convolving with a kernel of this size faster than direct summation
+	 */
+	static bool isBeneficial(int kernelWidth, int kernelHeight);
+
+	/**
+	 * @brief convolve an image with a kernel
+	 *
+	 * Pixels outside the image are zero.
+	 * @param output result, RGBA pixels of width * height, the channels that are not convolved are zero
+	 * @param image RGBA pixels of width * height
+	 * @param kernel kernelWidth * kernelHeight pixels of kernelChannels, the center of the kernel is
+	 * at (kernelWidth / 2, kernelHeight / 2)
+	 * @param kernelChannels 1 to use the same kernel for every channel, or COM_NUMBER_OF_CHANNELS
+	 * to convolve every channel with its own kernel
+	 * @param numberOfChannels the number of channels that are convolved, starting with red
+	 * @param normalize divide every pixel by the sum of the kernel values that fell inside the image,
+	 * like direct summation that skips the pixels outside the image
+	 */
+	static void convolve(float *output, const float *image, int width, int height,
+	                     const float *kernel, int kernelWidth, int kernelHeight, int kernelChannels,
+	                     int numberOfChannels, bool normalize);
+};
+
+#endif
@@ -25,6 +25,8 @@
 #include "COM_FastGaussianBlurOperation.h"
 #include "MEM_guardedalloc.h"
 #include "BLI_utildefines.h"
+#include "BLI_math.h"
+#include "COM_ParallelExecution.h"
 
 FastGaussianBlurOperation::FastGaussianBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
@@ -92,16 +94,16 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
 		this->m_sy = this->m_data->sizey * this->m_size / 2.0f;
 		
 		if ((this->m_sx == this->m_sy) && (this->m_sx > 0.f)) {
-			for (c = 0; c < COM_NUMBER_OF_CHANNELS; ++c)
+			for (c = 0; c < copy->getNumberOfChannels(); ++c)
 				IIR_gauss(copy, this->m_sx, c, 3);
 		}
 		else {
 			if (this->m_sx > 0.0f) {
-				for (c = 0; c < COM_NUMBER_OF_CHANNELS; ++c)
+				for (c = 0; c < copy->getNumberOfChannels(); ++c)
 					IIR_gauss(copy, this->m_sx, c, 1);
 			}
 			if (this->m_sy > 0.0f) {
-				for (c = 0; c < COM_NUMBER_OF_CHANNELS; ++c)
+				for (c = 0; c < copy->getNumberOfChannels(); ++c)
 					IIR_gauss(copy, this->m_sy, c, 2);
 			}
 		}
@@ -111,22 +113,101 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
 	return this->m_iirgaus;
 }
 
+/* the lines of a direction are divided over threads, every job filters IIR_GAUSS_LINES_PER_JOB lines */
+#define IIR_GAUSS_LINES_PER_JOB 32
+
+typedef struct IIRGaussData {
+	float *buffer;
+	unsigned int width;
+	unsigned int height;
+	unsigned int numberOfChannels;
+	unsigned int channel;
+
+	/* filter coefficients and the Triggs/Sdika border correction matrix */
+	double cf[4];
+	double tsM[9];
+
+	/* 1 filters the rows, 2 the columns */
+	unsigned int direction;
+} IIRGaussData;
+
+/* filter L values of X into Y, W holds the result of the causal pass */
+static void iir_gauss_line(const IIRGaussData *data, const double *X, double *Y, double *W, unsigned int L)
+{
+	const double *cf = data->cf;
+	const double *tsM = data->tsM;
+	double tsu[3], tsv[3];
+	unsigned int i;
+
+	W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+	W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+	W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+	for (i = 3; i < L; i++) {
+		W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+	}
+	tsu[0] = W[L - 1] - X[L - 1];
+	tsu[1] = W[L - 2] - X[L - 1];
+	tsu[2] = W[L - 3] - X[L - 1];
+	tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+	tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+	tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+	Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+	Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+	Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+	/* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */
+	for (i = L - 4; i != UINT_MAX; i--) {
+		Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+	}
+}
+
+static void iir_gauss_lines(void *data_v, int start, int end)
+{
+	IIRGaussData *data = (IIRGaussData *)data_v;
+	const unsigned int num_channels = data->numberOfChannels;
+	const unsigned int sz = max(data->width, data->height);
+	/* the pixels of a row are num_channels apart, those of a column a whole row */
+	const unsigned int length = (data->direction == 1) ? data->width : data->height;
+	const unsigned int stride = (data->direction == 1) ? num_channels : data->width * num_channels;
+	const unsigned int lineStride = (data->direction == 1) ? data->width * num_channels : num_channels;
+	double *X = (double *)MEM_mallocN(3 * sz * sizeof(double), "IIR_gauss buffers");
+	double *Y = &X[sz];
+	double *W = &Y[sz];
+	unsigned int line, i;
+
+	for (line = start; line < (unsigned int)end; line++) {
+		float *buffer = &data->buffer[line * lineStride + data->channel];
+		for (i = 0; i < length; i++)
+			X[i] = buffer[i * stride];
+		iir_gauss_line(data, X, Y, W, length);
+		for (i = 0; i < length; i++)
+			buffer[i * stride] = Y[i];
+	}
+
+	MEM_freeN(X);
+}
+
+static void iir_gauss_direction(IIRGaussData *data, unsigned int direction)
+{
+	const int numberOfLines = (direction == 1) ? data->height : data->width;
+
+	data->direction = direction;
+	ParallelExecution::execute(numberOfLines, IIR_GAUSS_LINES_PER_JOB, iir_gauss_lines, data);
+}
+
 void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, unsigned int chan, unsigned int xy)
 {
-	double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-	double *X, *Y, *W;
+	IIRGaussData data;
+	double q, q2, sc;
+	double *cf = data.cf, *tsM = data.tsM;
 	const unsigned int src_width = src->getWidth();
 	const unsigned int src_height = src->getHeight();
-	unsigned int x, y, sz;
-	unsigned int i;
-	float *buffer = src->getBuffer();
 	
 	// <0.5 not valid, though can have a possibly useful sort of sharpening effect
 	if (sigma < 0.5f) return;
 	
 	if ((xy < 1) || (xy > 3)) xy = 3;
 	
-	// XXX The YVV macro defined below explicitly expects sources of at least 3x3 pixels,
+	// XXX The line filter explicitly expects sources of at least 3x3 pixels,
 	//     so just skiping blur along faulty direction if src's def is below that limit!
 	if (src_width < 3) xy &= ~1;
 	if (src_height < 3) xy &= ~2;
@@ -165,63 +246,22 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src, float sigma, unsign
 	tsM[6] = sc * (cf[3] * cf[1] + cf[2] + cf[1] * cf[1] - cf[2] * cf[2]);
 	tsM[7] = sc * (cf[1] * cf[2] + cf[3] * cf[2] * cf[2] - cf[1] * cf[3] * cf[3] - cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
 	tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
-	
-#define YVV(L)                                                                          \
-{                                                                                       \
-	W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];                   \
-	W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];                   \
-	W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];                   \
-	for (i = 3; i < L; i++) {                                                           \
-		W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];   \
-	}                                                                                   \
-	tsu[0] = W[L - 1] - X[L - 1];                                                       \
-	tsu[1] = W[L - 2] - X[L - 1];                                                       \
-	tsu[2] = W[L - 3] - X[L - 1];                                                       \
-	tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];            \
-	tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];            \
-	tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];            \
-	Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];     \
-	Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];   \
-	Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-	/* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */   \
-	for (i = L - 4; i != UINT_MAX; i--) {                                               \
-		Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];   \
-	}                                                                                   \
-} (void)0
-	
-	// intermediate buffers
-	sz = max(src_width, src_height);
-	X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
-	Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
-	W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
+
+	data.buffer = src->getBuffer();
+	data.width = src_width;
+	data.height = src_height;
+	data.numberOfChannels = src->getNumberOfChannels();
+	data.channel = chan;
+
+	// the lines are filtered independently, rows and columns are divided over threads
 	if (xy & 1) {   // H
-		for (y = 0; y < src_height; ++y) {
-			const int yx = y * src_width;
-			for (x = 0; x < src_width; ++x)
-				X[x] = buffer[(x + yx) * COM_NUMBER_OF_CHANNELS + chan];
-			YVV(src_width);
-			for (x = 0; x < src_width; ++x)
-				buffer[(x + yx) * COM_NUMBER_OF_CHANNELS + chan] = Y[x];
-		}
+		iir_gauss_direction(&data, 1);
 	}
 	if (xy & 2) {   // V
-		for (x = 0; x < src_width; ++x) {
-			for (y = 0; y < src_height; ++y)
-				X[y] = buffer[(x + y * src_width) * COM_NUMBER_OF_CHANNELS + chan];
-			YVV(src_height);
-			for (y = 0; y < src_height; ++y)
-				buffer[(x + y * src_width) * COM_NUMBER_OF_CHANNELS + chan] = Y[y];
-		}
+		iir_gauss_direction(&data, 2);
 	}
-	
-	MEM_freeN(X);
-	MEM_freeN(W);
-	MEM_freeN(Y);
-#undef YVV
-	
 }
 
-
 ///
 FastGaussianBlurValueOperation::FastGaussianBlurValueOperation() : NodeOperation()
 {
@@ -277,12 +317,13 @@ void *FastGaussianBlurValueOperation::initializeTileData(rcti *rect)
 	if (!this->m_iirgaus) {
 		MemoryBuffer *newBuf = (MemoryBuffer *)this->m_inputprogram->initializeTileData(rect);
 		MemoryBuffer *copy = newBuf->duplicate();
+		const int num_channels = copy->getNumberOfChannels();
 		FastGaussianBlurOperation::IIR_gauss(copy, this->m_sigma, 0, 3);
 
 		if (this->m_overlay == FAST_GAUSS_OVERLAY_MIN) {
 			float *src = newBuf->getBuffer();
 			float *dst = copy->getBuffer();
-			for (int i = copy->getWidth() * copy->getHeight(); i != 0; i--, src += COM_NUMBER_OF_CHANNELS, dst += COM_NUMBER_OF_CHANNELS) {
+			for (int i = copy->getWidth() * copy->getHeight(); i != 0; i--, src += num_channels, dst += num_channels) {
 				if (*src < *dst) {
 					*dst = *src;
 				}
@@ -291,7 +332,7 @@ void *FastGaussianBlurValueOperation::initializeTileData(rcti *rect)
 		else if (this->m_overlay == FAST_GAUSS_OVERLAY_MAX) {
 			float *src = newBuf->getBuffer();
 			float *dst = copy->getBuffer();
-			for (int i = copy->getWidth() * copy->getHeight(); i != 0; i--, src += COM_NUMBER_OF_CHANNELS, dst += COM_NUMBER_OF_CHANNELS) {
+			for (int i = copy->getWidth() * copy->getHeight(); i != 0; i--, src += num_channels, dst += num_channels) {
 				if (*src > *dst) {
 					*dst = *src;
 				}
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "COM_FusedOperation.h"
+#include "COM_InputSocket.h"
+#include "COM_OutputSocket.h"
+
+/* every operation result and every input of the chain has a slot */
+#define FUSION_MAX_INPUTS (COM_FUSION_MAX_OPERATIONS * COM_FUSION_MAX_ARGUMENTS)
+#define FUSION_MAX_SLOTS (COM_FUSION_MAX_OPERATIONS + FUSION_MAX_INPUTS)
+
+/* number of pixels of all input spans of executeRow together */
+#define FUSION_BUFFER_PIXELS (COM_ROW_SPAN * COM_FUSION_MAX_ARGUMENTS)
+
+FusedOperation::FusedOperation() : NodeOperation()
+{
+	/* pass */
+}
+
+FusedOperation::~FusedOperation()
+{
+	while (!this->m_operations.empty()) {
+		delete this->m_operations.back();
+		this->m_operations.pop_back();
+	}
+}
+
+void FusedOperation::fuse(const vector<NodeOperation *> &operations)
+{
+	const int numberOfOperations = operations.size();
+	NodeOperation *outputOperation = operations.back();
+
+	BLI_assert(numberOfOperations <= COM_FUSION_MAX_OPERATIONS);
+	BLI_assert(outputOperation->getNumberOfInputSockets() > 0);
+
+	this->m_operations = operations;
+	this->m_arguments.clear();
+	this->m_argumentOffsets.clear();
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		NodeOperation *operation = operations[index];
+
+		BLI_assert(operation->getNumberOfInputSockets() <= COM_FUSION_MAX_ARGUMENTS);
+		this->m_argumentOffsets.push_back(this->m_arguments.size());
+
+		for (unsigned int i = 0; i < operation->getNumberOfInputSockets(); i++) {
+			InputSocket *socket = operation->getInputSocket(i);
+			NodeOperation *inputOperation = socket->getOperation();
+			int slot = -1;
+
+			for (int j = 0; j < index; j++) {
+				if (operations[j] == inputOperation) {
+					slot = j;
+					break;
+				}
+			}
+
+			if (slot == -1) {
+				/* input of the chain, becomes an input socket of this operation */
+				slot = numberOfOperations + this->getNumberOfInputSockets();
+				this->addInputSocket(socket->getDataType());
+				socket->relinkConnections(this->getInputSocket(this->getNumberOfInputSockets() - 1));
+			}
+			this->m_arguments.push_back(slot);
+		}
+	}
+	this->m_argumentOffsets.push_back(this->m_arguments.size());
+
+	this->addOutputSocket(outputOperation->getOutputSocket()->getDataType());
+	outputOperation->getOutputSocket()->relinkConnections(this->getOutputSocket());
+
+	unsigned int resolution[2] = {outputOperation->getWidth(), outputOperation->getHeight()};
+	this->setResolution(resolution);
+}
+
+void FusedOperation::initExecution()
+{
+	const int numberOfOperations = this->m_operations.size();
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		NodeOperation *operation = this->m_operations[index];
+		operation->initExecution();
+
+		/* operations without inputs (Set operations) are the same for every pixel */
+		if (this->m_argumentOffsets[index] == this->m_argumentOffsets[index + 1]) {
+			zero_v4(this->m_constants[index]);
+			operation->executeKernel(this->m_constants[index], NULL);
+		}
+	}
+
+	for (unsigned int i = 0; i < this->getNumberOfInputSockets(); i++) {
+		this->m_inputReaders.push_back(this->getInputSocketReader(i));
+	}
+}
+
+void FusedOperation::executeKernels(float output[4], float **slots)
+{
+	const int numberOfOperations = this->m_operations.size();
+	const float *arguments[COM_FUSION_MAX_ARGUMENTS];
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		const int first = this->m_argumentOffsets[index];
+		const int last = this->m_argumentOffsets[index + 1];
+
+		if (first == last) {
+			/* constant, calculated in initExecution */
+			continue;
+		}
+
+		for (int j = first; j < last; j++) {
+			arguments[j - first] = slots[this->m_arguments[j]];
+		}
+
+		/* the last operation writes the result directly */
+		this->m_operations[index]->executeKernel(index == numberOfOperations - 1 ? output : slots[index], arguments);
+	}
+}
+
+void FusedOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+{
+	const int numberOfOperations = this->m_operations.size();
+	const int numberOfInputs = this->m_inputReaders.size();
+	float inputs[FUSION_MAX_INPUTS][COM_NUMBER_OF_CHANNELS];
+	float results[COM_FUSION_MAX_OPERATIONS][COM_NUMBER_OF_CHANNELS];
+	float *slots[FUSION_MAX_SLOTS];
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		const bool constant = this->m_argumentOffsets[index] == this->m_argumentOffsets[index + 1];
+		slots[index] = constant ? this->m_constants[index] : results[index];
+	}
+
+	for (int i = 0; i < numberOfInputs; i++) {
+		this->m_inputReaders[i]->read(inputs[i], x, y, sampler);
+		slots[numberOfOperations + i] = inputs[i];
+	}
+
+	this->executeKernels(output, slots);
+}
+
+void FusedOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	const int numberOfOperations = this->m_operations.size();
+	const int numberOfInputs = this->m_inputReaders.size();
+	float inputs[FUSION_BUFFER_PIXELS * COM_NUMBER_OF_CHANNELS];
+	float results[COM_FUSION_MAX_OPERATIONS][COM_NUMBER_OF_CHANNELS];
+	float *slots[FUSION_MAX_SLOTS];
+
+	/* shorten the spans when there are many inputs, so all input spans fit in the buffer */
+	const int spanLength = numberOfInputs ? min_ii(COM_ROW_SPAN, FUSION_BUFFER_PIXELS / numberOfInputs) : COM_ROW_SPAN;
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		const bool constant = this->m_argumentOffsets[index] == this->m_argumentOffsets[index + 1];
+		slots[index] = constant ? this->m_constants[index] : results[index];
+	}
+
+	for (int start = 0; start < length; start += spanLength) {
+		const int span = min_ii(length - start, spanLength);
+		float *out = &output[start * COM_NUMBER_OF_CHANNELS];
+
+		for (int i = 0; i < numberOfInputs; i++) {
+			this->m_inputReaders[i]->readRow(&inputs[i * span * COM_NUMBER_OF_CHANNELS], x + start, y, span, sampler);
+		}
+
+		for (int p = 0; p < span; p++, out += COM_NUMBER_OF_CHANNELS) {
+			for (int i = 0; i < numberOfInputs; i++) {
+				slots[numberOfOperations + i] = &inputs[(i * span + p) * COM_NUMBER_OF_CHANNELS];
+			}
+			this->executeKernels(out, slots);
+		}
+	}
+}
+
+void FusedOperation::deinitExecution()
+{
+	const int numberOfOperations = this->m_operations.size();
+
+	for (int index = 0; index < numberOfOperations; index++) {
+		this->m_operations[index]->deinitExecution();
+	}
+	this->m_inputReaders.clear();
+}
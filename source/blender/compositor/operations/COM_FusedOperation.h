@@ -0,0 +1,92 @@
+/*
+ * Copyright 2013, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_FusedOperation_h
+#define _COM_FusedOperation_h
+#include "COM_NodeOperation.h"
+
+/**
+ * @brief a chain of pixel kernels executed as a single operation
+ *
+ * The ExecutionSystem replaces chains of pixel kernels (conversions, mix, math, color corrections)
+ * by a FusedOperation. Only the inputs of the chain are read, the kernels are evaluated in order
+ * per pixel and the intermediate results stay in local arrays instead of going through the
+ * read calls of every operation in the chain.
+ * @see NodeOperation.isPixelKernel
+ * @ingroup Operation
+ */
+class FusedOperation : public NodeOperation {
+private:
+	/**
+	 * @brief fused operations in evaluation order, the last one calculates the output
+	 */
+	vector<NodeOperation *> m_operations;
+
+	/**
+	 * @brief the slots the operations read, the arguments of operation i are
+	 * m_arguments[m_argumentOffsets[i]] to m_arguments[m_argumentOffsets[i + 1]]
+	 *
+	 * slot i < number of operations is the result of operation i,
+	 * the following slots are the input sockets of this operation.
+	 */
+	vector<int> m_arguments;
+	vector<int> m_argumentOffsets;
+
+	/**
+	 * @brief results of the operations without inputs, calculated once in initExecution
+	 */
+	float m_constants[COM_FUSION_MAX_OPERATIONS][COM_NUMBER_OF_CHANNELS];
+
+	/**
+	 * @brief cached readers of the input sockets
+	 */
+	vector<SocketReader *> m_inputReaders;
+
+	void executeKernels(float output[4], float **slots);
+public:
+	FusedOperation();
+	~FusedOperation();
+
+	/**
+	 * @brief take over a chain of pixel kernels
+	 *
+	 * The connections from outside the chain are relinked to this operation, connections inside
+	 * the chain are kept. The operations are owned by this operation afterwards.
+	 * @param operations the pixel kernels, every operation must come after the operations it reads
+	 * from, the last one is the output of the chain.
+	 */
+	void fuse(const vector<NodeOperation *> &operations);
+
+	/**
+	 * @brief get the fused operations, in evaluation order
+	 */
+	const vector<NodeOperation *> &getFusedOperations() const { return this->m_operations; }
+
+	/**
+	 * @brief get the slots the fused operations read from
+	 */
+	const vector<int> &getArguments() const { return this->m_arguments; }
+
+	void executePixel(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int x, int y, int length, PixelSampler sampler);
+
+	void initExecution();
+	void deinitExecution();
+};
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include "COM_GaussianBokehBlurOperation.h"
+#include "COM_FFTConvolution.h"
 #include "BLI_math.h"
 #include "MEM_guardedalloc.h"
 extern "C" {
@@ -30,6 +31,8 @@ extern "C" {
 GaussianBokehBlurOperation::GaussianBokehBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
 	this->m_gausstab = NULL;
+	this->m_useFFTConvolution = false;
+	this->m_convolvedBuffer = NULL;
 }
 
 void *GaussianBokehBlurOperation::initializeTileData(rcti *rect)
@@ -39,6 +42,9 @@ void *GaussianBokehBlurOperation::initializeTileData(rcti *rect)
 		updateGauss();
 	}
 	void *buffer = getInputOperation(0)->initializeTileData(NULL);
+	if (this->m_useFFTConvolution && this->m_convolvedBuffer == NULL) {
+		convolveWithFFT((MemoryBuffer *)buffer);
+	}
 	unlockMutex();
 	return buffer;
 }
@@ -49,9 +55,32 @@ void GaussianBokehBlurOperation::initExecution()
 
 	initMutex();
 
+	this->m_useFFTConvolution = false;
 	if (this->m_sizeavailable) {
 		updateGauss();
+		this->m_useFFTConvolution = FFTConvolution::isBeneficial(2 * this->m_radx + 1, 2 * this->m_rady + 1);
+	}
+}
+
+void GaussianBokehBlurOperation::convolveWithFFT(MemoryBuffer *inputBuffer)
+{
+	const int kernelWidth = 2 * this->m_radx + 1;
+	const int kernelHeight = 2 * this->m_rady + 1;
+	const int width = inputBuffer->getWidth();
+	const int height = inputBuffer->getHeight();
+	float *kernel = (float *)MEM_dupallocN(this->m_gausstab);
+
+	/* executePixel skips the last row and column of the filter, the filter is symmetric so
+	 * these are the first row and column of the convolution kernel */
+	memset(kernel, 0, sizeof(float) * kernelWidth);
+	for (int y = 1; y < kernelHeight; y++) {
+		kernel[y * kernelWidth] = 0.0f;
 	}
+
+	this->m_convolvedBuffer = (float *)MEM_mapallocN(sizeof(float) * COM_NUMBER_OF_CHANNELS * width * height, __func__);
+	FFTConvolution::convolve(this->m_convolvedBuffer, inputBuffer->getBuffer(), width, height,
+	                         kernel, kernelWidth, kernelHeight, 1, COM_NUMBER_OF_CHANNELS, true);
+	MEM_freeN(kernel);
 }
 
 void GaussianBokehBlurOperation::updateGauss()
@@ -119,6 +148,13 @@ void GaussianBokehBlurOperation::updateGauss()
 
 void GaussianBokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 {
+	if (this->m_convolvedBuffer) {
+		MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
+		int offset = ((y - inputBuffer->getRect()->ymin) * inputBuffer->getWidth() + (x - inputBuffer->getRect()->xmin)) * COM_NUMBER_OF_CHANNELS;
+		copy_v4_v4(output, &this->m_convolvedBuffer[offset]);
+		return;
+	}
+
 	float tempColor[4];
 	tempColor[0] = 0;
 	tempColor[1] = 0;
@@ -165,6 +201,10 @@ void GaussianBokehBlurOperation::deinitExecution()
 	BlurBaseOperation::deinitExecution();
 	MEM_freeN(this->m_gausstab);
 	this->m_gausstab = NULL;
+	if (this->m_convolvedBuffer) {
+		MEM_freeN(this->m_convolvedBuffer);
+		this->m_convolvedBuffer = NULL;
+	}
 
 	deinitMutex();
 }
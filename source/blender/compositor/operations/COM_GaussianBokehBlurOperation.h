@@ -32,6 +32,14 @@ private:
 	int m_radx, m_rady;
 	void updateGauss();
 
+	/**
+	 * @brief large constant sized kernels are convolved with the whole image at once
+	 * @see FFTConvolution
+	 */
+	bool m_useFFTConvolution;
+	float *m_convolvedBuffer;
+	void convolveWithFFT(MemoryBuffer *inputBuffer);
+
 public:
 	GaussianBokehBlurOperation();
 	void initExecution();
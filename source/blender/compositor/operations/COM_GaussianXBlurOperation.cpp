@@ -21,17 +21,73 @@
  */
 
 #include "COM_GaussianXBlurOperation.h"
+#include "COM_FastGaussianBlurOperation.h"
 #include "BLI_math.h"
 #include "MEM_guardedalloc.h"
 
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
 extern "C" {
 	#include "RE_pipeline.h"
 }
 
+/* weighted sum of count pixels that are stride floats apart, multiplied with scale */
+static void gauss_sum_pixel(float output[4], const float *input, int stride,
+                            const float *weights, int weightStride, int count, float scale)
+{
+#ifdef __SSE__
+	__m128 accum = _mm_setzero_ps();
+	for (int i = 0; i < count; i++, input += stride, weights += weightStride) {
+		accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(input), _mm_set1_ps(*weights)));
+	}
+	_mm_storeu_ps(output, _mm_mul_ps(accum, _mm_set1_ps(scale)));
+#else
+	float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	for (int i = 0; i < count; i++, input += stride, weights += weightStride) {
+		madd_v4_v4fl(accum, input, *weights);
+	}
+	mul_v4_v4fl(output, accum, scale);
+#endif
+}
+
+/* gauss_sum_pixel for four adjacent pixels, the sums are independent so they are calculated
+ * side by side, every pixel is still summed in the same order */
+static void gauss_sum_pixel4(float output[16], const float *input, int stride,
+                             const float *weights, int weightStride, int count, float scale)
+{
+#ifdef __SSE__
+	__m128 accum0 = _mm_setzero_ps();
+	__m128 accum1 = _mm_setzero_ps();
+	__m128 accum2 = _mm_setzero_ps();
+	__m128 accum3 = _mm_setzero_ps();
+	for (int i = 0; i < count; i++, input += stride, weights += weightStride) {
+		const __m128 weight = _mm_set1_ps(*weights);
+		accum0 = _mm_add_ps(accum0, _mm_mul_ps(_mm_loadu_ps(&input[0]), weight));
+		accum1 = _mm_add_ps(accum1, _mm_mul_ps(_mm_loadu_ps(&input[4]), weight));
+		accum2 = _mm_add_ps(accum2, _mm_mul_ps(_mm_loadu_ps(&input[8]), weight));
+		accum3 = _mm_add_ps(accum3, _mm_mul_ps(_mm_loadu_ps(&input[12]), weight));
+	}
+	const __m128 factor = _mm_set1_ps(scale);
+	_mm_storeu_ps(&output[0], _mm_mul_ps(accum0, factor));
+	_mm_storeu_ps(&output[4], _mm_mul_ps(accum1, factor));
+	_mm_storeu_ps(&output[8], _mm_mul_ps(accum2, factor));
+	_mm_storeu_ps(&output[12], _mm_mul_ps(accum3, factor));
+#else
+	for (int i = 0; i < 4; i++) {
+		gauss_sum_pixel(&output[i * 4], &input[i * 4], stride, weights, weightStride, count, scale);
+	}
+#endif
+}
+
 GaussianXBlurOperation::GaussianXBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
 	this->m_gausstab = NULL;
+	this->m_gausssum = 1.0f;
 	this->m_rad = 0;
+	this->m_recursive = false;
+	this->m_iirgaus = NULL;
 }
 
 void *GaussianXBlurOperation::initializeTileData(rcti *rect)
@@ -41,6 +97,17 @@ void *GaussianXBlurOperation::initializeTileData(rcti *rect)
 		updateGauss();
 	}
 	void *buffer = getInputOperation(0)->initializeTileData(NULL);
+	if (this->m_recursive) {
+		if (!this->m_iirgaus) {
+			MemoryBuffer *copy = ((MemoryBuffer *)buffer)->duplicate();
+			const float sigma = BlurBaseOperation::gaussSigma(this->m_rad);
+			for (int c = 0; c < copy->getNumberOfChannels(); c++) {
+				FastGaussianBlurOperation::IIR_gauss(copy, sigma, c, 1);
+			}
+			this->m_iirgaus = copy;
+		}
+		buffer = this->m_iirgaus;
+	}
 	unlockMutex();
 	return buffer;
 }
@@ -52,12 +119,7 @@ void GaussianXBlurOperation::initExecution()
 	initMutex();
 
 	if (this->m_sizeavailable) {
-		float rad = this->m_size * this->m_data->sizex;
-		if (rad < 1)
-			rad = 1;
-
-		this->m_rad = rad;
-		this->m_gausstab = BlurBaseOperation::make_gausstab(rad);
+		updateGauss();
 	}
 }
 
@@ -71,38 +133,72 @@ void GaussianXBlurOperation::updateGauss()
 
 		this->m_rad = rad;
 		this->m_gausstab = BlurBaseOperation::make_gausstab(rad);
+		this->m_gausssum = BlurBaseOperation::sum_gausstab(this->m_gausstab, this->m_rad);
+		this->m_recursive = BlurBaseOperation::useRecursiveGauss(this->m_rad);
 	}
 }
 
 void GaussianXBlurOperation::executePixel(float output[4], int x, int y, void *data)
 {
-	float color_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-	float multiplier_accum = 0.0f;
+	executeRow(output, x, y, 1, data);
+}
+
+void GaussianXBlurOperation::executeRow(float *output, int x, int y, int length, void *data)
+{
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
+
+	if (this->m_recursive) {
+		/* blurred in initializeTileData */
+		inputBuffer->readRow(output, x, y, length);
+		return;
+	}
+
 	float *buffer = inputBuffer->getBuffer();
-	int bufferwidth = inputBuffer->getWidth();
-	int bufferstartx = inputBuffer->getRect()->xmin;
-	int bufferstarty = inputBuffer->getRect()->ymin;
-
-	int miny = y;
-	// int maxy = y;  // UNUSED
-	int minx = x - this->m_rad;
-	int maxx = x + this->m_rad;
-	miny = max(miny, inputBuffer->getRect()->ymin);
-	minx = max(minx, inputBuffer->getRect()->xmin);
-	// maxy = min(maxy, inputBuffer->getRect()->ymax);
-	maxx = min(maxx, inputBuffer->getRect()->xmax - 1);
-
-	int step = getStep();
-	int offsetadd = getOffsetAdd();
-	int bufferindex = ((minx - bufferstartx) * 4) + ((miny - bufferstarty) * 4 * bufferwidth);
-	for (int nx = minx, index = (minx - x) + this->m_rad; nx <= maxx; nx += step, index += step) {
-		const float multiplier = this->m_gausstab[index];
-		madd_v4_v4fl(color_accum, &buffer[bufferindex], multiplier);
-		multiplier_accum += multiplier;
-		bufferindex += offsetadd;
+	const rcti *rect = inputBuffer->getRect();
+	const int bufferwidth = inputBuffer->getWidth();
+	const int rad = this->m_rad;
+	const int step = getStep();
+	const int offsetadd = getOffsetAdd();
+	const int rowindex = (max(y, rect->ymin) - rect->ymin) * bufferwidth - rect->xmin;
+
+	/* pixels whose kernel lies inside the buffer, these are summed four at a time */
+	const int interiorx1 = max(x, rect->xmin + rad);
+	const int interiorx2 = min(x + length, rect->xmax - rad);
+
+	int px = x;
+	while (px < x + length) {
+		if (px >= interiorx1 && px + 4 <= interiorx2) {
+			const float *input = &buffer[(rowindex + px - rad) * COM_NUMBER_OF_CHANNELS];
+			gauss_sum_pixel4(output, input, offsetadd, this->m_gausstab, step, 2 * rad / step + 1, 1.0f / this->m_gausssum);
+			output += 4 * COM_NUMBER_OF_CHANNELS;
+			px += 4;
+			continue;
+		}
+
+		const int minx = max(px - rad, rect->xmin);
+		const int maxx = min(px + rad, rect->xmax - 1);
+		const float *gausstab = &this->m_gausstab[(minx - px) + rad];
+		float multiplier_accum = 0.0f;
+
+		if (minx == px - rad && maxx == px + rad) {
+			multiplier_accum = this->m_gausssum;
+		}
+		else {
+			for (int nx = minx, index = 0; nx <= maxx; nx += step, index += step) {
+				multiplier_accum += gausstab[index];
+			}
+		}
+
+		if (multiplier_accum > 0.0f) {
+			const float *input = &buffer[(rowindex + minx) * COM_NUMBER_OF_CHANNELS];
+			gauss_sum_pixel(output, input, offsetadd, gausstab, step, (maxx - minx) / step + 1, 1.0f / multiplier_accum);
+		}
+		else {
+			zero_v4(output);
+		}
+		output += COM_NUMBER_OF_CHANNELS;
+		px++;
 	}
-	mul_v4_v4fl(output, color_accum, 1.0f / multiplier_accum);
 }
 
 void GaussianXBlurOperation::deinitExecution()
@@ -112,6 +208,10 @@ void GaussianXBlurOperation::deinitExecution()
 		MEM_freeN(this->m_gausstab);
 		this->m_gausstab = NULL;
 	}
+	if (this->m_iirgaus) {
+		delete this->m_iirgaus;
+		this->m_iirgaus = NULL;
+	}
 
 	deinitMutex();
 }
@@ -132,7 +232,7 @@ bool GaussianXBlurOperation::determineDependingAreaOfInterest(rcti *input, ReadB
 		}
 	}
 	{
-		if (this->m_sizeavailable && this->m_gausstab != NULL) {
+		if (this->m_sizeavailable && this->m_gausstab != NULL && !this->m_recursive) {
 			newInput.xmax = input->xmax + this->m_rad + 1;
 			newInput.xmin = input->xmin - this->m_rad - 1;
 			newInput.ymax = input->ymax;
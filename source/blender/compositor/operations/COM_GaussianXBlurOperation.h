@@ -28,7 +28,16 @@
 class GaussianXBlurOperation : public BlurBaseOperation {
 private:
 	float *m_gausstab;
+	float m_gausssum;
 	int m_rad;
+
+	/**
+	 * @brief large radii are blurred with the recursive filter over the whole image,
+	 * see BlurBaseOperation.useRecursiveGauss
+	 */
+	bool m_recursive;
+	MemoryBuffer *m_iirgaus;
+
 	void updateGauss();
 public:
 	GaussianXBlurOperation();
@@ -37,6 +46,7 @@ public:
 	 * @brief the inner loop of this program
 	 */
 	void executePixel(float output[4], int x, int y, void *data);
+	void executeRow(float *output, int x, int y, int length, void *data);
 	
 	/**
 	 * @brief initialize the execution
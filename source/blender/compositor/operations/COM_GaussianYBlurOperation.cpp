@@ -21,17 +21,39 @@
  */
 
 #include "COM_GaussianYBlurOperation.h"
+#include "COM_FastGaussianBlurOperation.h"
 #include "BLI_math.h"
 #include "MEM_guardedalloc.h"
 
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
 extern "C" {
 	#include "RE_pipeline.h"
 }
 
+/* add count pixels of input multiplied with weight to output */
+static void gauss_add_row(float *output, const float *input, int count, float weight)
+{
+#ifdef __SSE__
+	const __m128 factor = _mm_set1_ps(weight);
+	for (int i = 0; i < count; i++, output += 4, input += 4) {
+		_mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_loadu_ps(input), factor)));
+	}
+#else
+	for (int i = 0; i < count; i++, output += 4, input += 4) {
+		madd_v4_v4fl(output, input, weight);
+	}
+#endif
+}
+
 GaussianYBlurOperation::GaussianYBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
 	this->m_gausstab = NULL;
 	this->m_rad = 0;
+	this->m_recursive = false;
+	this->m_iirgaus = NULL;
 }
 
 void *GaussianYBlurOperation::initializeTileData(rcti *rect)
@@ -41,6 +63,17 @@ void *GaussianYBlurOperation::initializeTileData(rcti *rect)
 		updateGauss();
 	}
 	void *buffer = getInputOperation(0)->initializeTileData(NULL);
+	if (this->m_recursive) {
+		if (!this->m_iirgaus) {
+			MemoryBuffer *copy = ((MemoryBuffer *)buffer)->duplicate();
+			const float sigma = BlurBaseOperation::gaussSigma(this->m_rad);
+			for (int c = 0; c < copy->getNumberOfChannels(); c++) {
+				FastGaussianBlurOperation::IIR_gauss(copy, sigma, c, 2);
+			}
+			this->m_iirgaus = copy;
+		}
+		buffer = this->m_iirgaus;
+	}
 	unlockMutex();
 	return buffer;
 }
@@ -52,12 +85,7 @@ void GaussianYBlurOperation::initExecution()
 	initMutex();
 
 	if (this->m_sizeavailable) {
-		float rad = this->m_size * this->m_data->sizey;
-		if (rad < 1)
-			rad = 1;
-
-		this->m_rad = rad;
-		this->m_gausstab = BlurBaseOperation::make_gausstab(rad);
+		updateGauss();
 	}
 }
 
@@ -71,39 +99,55 @@ void GaussianYBlurOperation::updateGauss()
 
 		this->m_rad = rad;
 		this->m_gausstab = BlurBaseOperation::make_gausstab(rad);
+		this->m_recursive = BlurBaseOperation::useRecursiveGauss(this->m_rad);
 	}
 }
 
 void GaussianYBlurOperation::executePixel(float output[4], int x, int y, void *data)
 {
-	float color_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-	float multiplier_accum = 0.0f;
+	executeRow(output, x, y, 1, data);
+}
+
+void GaussianYBlurOperation::executeRow(float *output, int x, int y, int length, void *data)
+{
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
+
+	if (this->m_recursive) {
+		/* blurred in initializeTileData */
+		inputBuffer->readRow(output, x, y, length);
+		return;
+	}
+
 	float *buffer = inputBuffer->getBuffer();
-	int bufferwidth = inputBuffer->getWidth();
-	int bufferstartx = inputBuffer->getRect()->xmin;
-	int bufferstarty = inputBuffer->getRect()->ymin;
-
-	int miny = y - this->m_rad;
-	int maxy = y + this->m_rad;
-	int minx = x;
-	// int maxx = x;  // UNUSED
-	miny = max(miny, inputBuffer->getRect()->ymin);
-	minx = max(minx, inputBuffer->getRect()->xmin);
-	maxy = min(maxy, inputBuffer->getRect()->ymax - 1);
-	// maxx = min(maxx, inputBuffer->getRect()->xmax);
-
-	int index;
-	int step = getStep();
-	const int bufferIndexx = ((minx - bufferstartx) * 4);
+	const rcti *rect = inputBuffer->getRect();
+	const int bufferwidth = inputBuffer->getWidth();
+	const int step = getStep();
+
+	/* the kernel is the same for every pixel of the row, so it is applied row by row:
+	 * the rows of the buffer are contiguous and every pixel is summed in the same order */
+	const int miny = max(y - this->m_rad, rect->ymin);
+	const int maxy = min(y + this->m_rad, rect->ymax - 1);
+	const int minx = max(x, rect->xmin);
+	const int maxx = min(x + length, rect->xmax);
+	const int count = maxx - minx;
+	float multiplier_accum = 0.0f;
+
+	memset(output, 0, sizeof(float) * COM_NUMBER_OF_CHANNELS * length);
+	if (count <= 0) {
+		return;
+	}
+
+	float *accum = &output[(minx - x) * COM_NUMBER_OF_CHANNELS];
 	for (int ny = miny; ny <= maxy; ny += step) {
-		index = (ny - y) + this->m_rad;
-		int bufferindex = bufferIndexx + ((ny - bufferstarty) * 4 * bufferwidth);
-		const float multiplier = this->m_gausstab[index];
-		madd_v4_v4fl(color_accum, &buffer[bufferindex], multiplier);
+		const float multiplier = this->m_gausstab[(ny - y) + this->m_rad];
+		const float *input = &buffer[((ny - rect->ymin) * bufferwidth + (minx - rect->xmin)) * COM_NUMBER_OF_CHANNELS];
+		gauss_add_row(accum, input, count, multiplier);
 		multiplier_accum += multiplier;
 	}
-	mul_v4_v4fl(output, color_accum, 1.0f / multiplier_accum);
+
+	if (multiplier_accum > 0.0f) {
+		mul_vn_fl(accum, count * COM_NUMBER_OF_CHANNELS, 1.0f / multiplier_accum);
+	}
 }
 
 void GaussianYBlurOperation::deinitExecution()
@@ -113,6 +157,10 @@ void GaussianYBlurOperation::deinitExecution()
 		MEM_freeN(this->m_gausstab);
 		this->m_gausstab = NULL;
 	}
+	if (this->m_iirgaus) {
+		delete this->m_iirgaus;
+		this->m_iirgaus = NULL;
+	}
 
 	deinitMutex();
 }
@@ -133,7 +181,7 @@ bool GaussianYBlurOperation::determineDependingAreaOfInterest(rcti *input, ReadB
 		}
 	}
 	{
-		if (this->m_sizeavailable && this->m_gausstab != NULL) {
+		if (this->m_sizeavailable && this->m_gausstab != NULL && !this->m_recursive) {
 			newInput.xmax = input->xmax;
 			newInput.xmin = input->xmin;
 			newInput.ymax = input->ymax + this->m_rad + 1;
@@ -29,6 +29,14 @@ class GaussianYBlurOperation : public BlurBaseOperation {
 private:
 	float *m_gausstab;
 	int m_rad;
+
+	/**
+	 * @brief large radii are blurred with the recursive filter over the whole image,
+	 * see BlurBaseOperation.useRecursiveGauss
+	 */
+	bool m_recursive;
+	MemoryBuffer *m_iirgaus;
+
 	void updateGauss();
 public:
 	GaussianYBlurOperation();
@@ -37,6 +45,7 @@ public:
 	 * the inner loop of this program
 	 */
 	void executePixel(float output[4], int x, int y, void *data);
+	void executeRow(float *output, int x, int y, int length, void *data);
 	
 	/**
 	 * @brief initialize the execution
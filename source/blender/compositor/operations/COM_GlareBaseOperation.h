@@ -24,6 +24,7 @@
 #define _COM_GlareBaseOperation_h
 
 #include "COM_SingleThreadedNodeOperation.h"
+#include "COM_ParallelExecution.h"
 #include "DNA_node_types.h"
 
 
@@ -35,6 +36,9 @@ typedef float fRGB[4];
 /* multiply c2 by color rgb, rgb as separate arguments */
 #define fRGB_rgbmult(c, r, g, b) { c[0] *= (r);  c[1] *= (g);  c[2] *= (b); } (void)0
 
+/* number of rows a thread calculates at once in a glare pass, see ParallelExecution */
+#define GLARE_ROWS_PER_JOB 16
+
 
 class GlareBaseOperation : public SingleThreadedNodeOperation {
 private:
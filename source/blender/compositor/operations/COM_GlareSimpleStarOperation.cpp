@@ -22,78 +22,107 @@
 
 #include "COM_GlareSimpleStarOperation.h"
 
-void GlareSimpleStarOperation::generateGlare(float *data, MemoryBuffer *inputTile, NodeGlare *settings)
+typedef struct SimpleStarPass {
+	MemoryBuffer *tbuf[2];
+	int i;
+	int angle;
+	float f1, f2;
+} SimpleStarPass;
+
+/* one iteration of one of the buffers, buffer 0 holds the vertical (or diagonal) lines, buffer 1
+ * the horizontal lines. The sweeps filter in place, so the rows depend on each other, but the
+ * buffers do not: they are calculated in parallel */
+static void simple_star_pass(void *userdata, int start, int end)
 {
-	int i, x, y, ym, yp, xm, xp;
+	const SimpleStarPass *pass = (const SimpleStarPass *)userdata;
+	const int i = pass->i;
+	const float f1 = pass->f1, f2 = pass->f2;
 	float c[4] = {0, 0, 0, 0}, tc[4] = {0, 0, 0, 0};
-	const float f1 = 1.0f - settings->fade;
-	const float f2 = (1.0f - f1) * 0.5f;
+	int b, x, y, ym, yp, xm, xp;
 
-	MemoryBuffer *tbuf1 = inputTile->duplicate();
-	MemoryBuffer *tbuf2 = inputTile->duplicate();
+	for (b = start; b < end; b++) {
+		MemoryBuffer *tbuf = pass->tbuf[b];
+		const int width = tbuf->getWidth();
+		const int height = tbuf->getHeight();
+		int x1, y1, x2, y2;
 
-	bool breaked = false;
-	for (i = 0; i < settings->iter && (!breaked); i++) {
 //		// (x || x-1, y-1) to (x || x+1, y+1)
 //		// F
-		for (y = 0; y < this->getHeight() && (!breaked); y++) {
+		for (y = 0; y < height; y++) {
 			ym = y - i;
 			yp = y + i;
-			for (x = 0; x < this->getWidth(); x++) {
+			for (x = 0; x < width; x++) {
 				xm = x - i;
 				xp = x + i;
-				tbuf1->read(c, x, y);
-				mul_v3_fl(c, f1);
-				tbuf1->read(tc, (settings->angle ? xm : x), ym);
-				madd_v3_v3fl(c, tc, f2);
-				tbuf1->read(tc, (settings->angle ? xp : x), yp);
-				madd_v3_v3fl(c, tc, f2);
-				c[3] = 1.0f;
-				tbuf1->writePixel(x, y, c);
-
-				tbuf2->read(c, x, y);
+				if (b == 0) {
+					x1 = pass->angle ? xm : x; y1 = ym;
+					x2 = pass->angle ? xp : x; y2 = yp;
+				}
+				else {
+					x1 = xm; y1 = pass->angle ? yp : y;
+					x2 = xp; y2 = pass->angle ? ym : y;
+				}
+				tbuf->read(c, x, y);
 				mul_v3_fl(c, f1);
-				tbuf2->read(tc, xm, (settings->angle ? yp : y));
+				tbuf->read(tc, x1, y1);
 				madd_v3_v3fl(c, tc, f2);
-				tbuf2->read(tc, xp, (settings->angle ? ym : y));
+				tbuf->read(tc, x2, y2);
 				madd_v3_v3fl(c, tc, f2);
 				c[3] = 1.0f;
-				tbuf2->writePixel(x, y, c);
-			}
-			if (isBreaked()) {
-				breaked = true;
+				tbuf->writePixel(x, y, c);
 			}
 		}
 //		// B
-		for (y = tbuf1->getHeight() - 1 && (!breaked); y >= 0; y--) {
+		/* XXX the backward sweep starts at row 1, the start used to be written as
+		 * 'height - 1 && (!breaked)', kept like this so the star does not change */
+		for (y = (height - 1) ? 1 : 0; y >= 0; y--) {
 			ym = y - i;
 			yp = y + i;
-			for (x = tbuf1->getWidth() - 1; x >= 0; x--) {
+			for (x = width - 1; x >= 0; x--) {
 				xm = x - i;
 				xp = x + i;
-				tbuf1->read(c, x, y);
+				if (b == 0) {
+					x1 = pass->angle ? xm : x; y1 = ym;
+					x2 = pass->angle ? xp : x; y2 = yp;
+				}
+				else {
+					x1 = xm; y1 = pass->angle ? yp : y;
+					x2 = xp; y2 = pass->angle ? ym : y;
+				}
+				tbuf->read(c, x, y);
 				mul_v3_fl(c, f1);
-				tbuf1->read(tc, (settings->angle ? xm : x), ym);
+				tbuf->read(tc, x1, y1);
 				madd_v3_v3fl(c, tc, f2);
-				tbuf1->read(tc, (settings->angle ? xp : x), yp);
+				tbuf->read(tc, x2, y2);
 				madd_v3_v3fl(c, tc, f2);
 				c[3] = 1.0f;
-				tbuf1->writePixel(x, y, c);
-
-				tbuf2->read(c, x, y);
-				mul_v3_fl(c, f1);
-				tbuf2->read(tc, xm, (settings->angle ? yp : y));
-				madd_v3_v3fl(c, tc, f2);
-				tbuf2->read(tc, xp, (settings->angle ? ym : y));
-				madd_v3_v3fl(c, tc, f2);
-				c[3] = 1.0f;
-				tbuf2->writePixel(x, y, c);
-			}
-			if (isBreaked()) {
-				breaked = true;
+				tbuf->writePixel(x, y, c);
 			}
 		}
 	}
+}
+
+void GlareSimpleStarOperation::generateGlare(float *data, MemoryBuffer *inputTile, NodeGlare *settings)
+{
+	int i;
+	SimpleStarPass pass;
+
+	MemoryBuffer *tbuf1 = inputTile->duplicate();
+	MemoryBuffer *tbuf2 = inputTile->duplicate();
+
+	pass.tbuf[0] = tbuf1;
+	pass.tbuf[1] = tbuf2;
+	pass.angle = settings->angle;
+	pass.f1 = 1.0f - settings->fade;
+	pass.f2 = (1.0f - pass.f1) * 0.5f;
+
+	for (i = 0; i < settings->iter; i++) {
+		pass.i = i;
+		ParallelExecution::execute(2, 1, simple_star_pass, &pass);
+		if (isBreaked()) {
+			break;
+		}
+	}
 
 	for (i = 0; i < this->getWidth() * this->getHeight() * 4; i++) {
 		data[i] = tbuf1->getBuffer()[i] + tbuf2->getBuffer()[i];
@@ -97,6 +97,18 @@ void BaseImageOperation::deinitExecution()
 	BKE_image_release_ibuf(this->m_image, this->m_buffer, NULL);
 }
 
+bool BaseImageOperation::updateCacheKey(CacheKey *key) const
+{
+	/* the image can be painted or reloaded without changing the node, use the pixels */
+	if (this->m_imageBuffer) {
+		key->addData(this->m_imageBuffer, sizeof(float) * this->m_imagewidth * this->m_imageheight * this->m_numberOfChannels);
+	}
+	if (this->m_depthBuffer) {
+		key->addData(this->m_depthBuffer, sizeof(float) * this->m_imagewidth * this->m_imageheight);
+	}
+	return true;
+}
+
 void BaseImageOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	ImBuf *stackbuf = getImBuf();
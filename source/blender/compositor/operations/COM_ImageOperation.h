@@ -61,6 +61,7 @@ public:
 	
 	void initExecution();
 	void deinitExecution();
+	bool updateCacheKey(CacheKey *key) const;
 	void setImage(Image *image) { this->m_image = image; }
 	void setImageUser(ImageUser *imageuser) { this->m_imageUser = imageuser; }
 
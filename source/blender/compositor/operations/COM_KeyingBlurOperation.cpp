@@ -50,6 +50,7 @@ void KeyingBlurOperation::executePixel(float output[4], int x, int y, void *data
 {
 	MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
 	float *buffer = inputBuffer->getBuffer();
+	const int numberOfChannels = inputBuffer->getNumberOfChannels();
 
 	int bufferWidth = inputBuffer->getWidth();
 	int bufferHeight = inputBuffer->getHeight();
@@ -63,7 +64,7 @@ void KeyingBlurOperation::executePixel(float output[4], int x, int y, void *data
 			int cx = x + i;
 
 			if (cx >= 0 && cx < bufferWidth) {
-				int bufferIndex = (y * bufferWidth + cx) * 4;
+				int bufferIndex = (y * bufferWidth + cx) * numberOfChannels;
 
 				average += buffer[bufferIndex];
 				count++;
@@ -75,7 +76,7 @@ void KeyingBlurOperation::executePixel(float output[4], int x, int y, void *data
 			int cy = y + i;
 
 			if (cy >= 0 && cy < bufferHeight) {
-				int bufferIndex = (cy * bufferWidth + x) * 4;
+				int bufferIndex = (cy * bufferWidth + x) * numberOfChannels;
 
 				average += buffer[bufferIndex];
 				count++;
@@ -72,53 +72,80 @@ void MathBaseOperation::clampIfNeeded(float *color)
 	}
 }
 
-void MathAddOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathBaseOperation::readInputRows(float *inputValue1, float *inputValue2, int x, int y, int length, PixelSampler sampler)
+{
+	BLI_assert(length <= COM_ROW_SPAN);
+	this->m_inputValue1Operation->readRow(inputValue1, x, y, length, sampler);
+	this->m_inputValue2Operation->readRow(inputValue2, x, y, length, sampler);
+}
+
+void MathBaseOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
 {
 	float inputValue1[4];
 	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputs[2] = {inputValue1, inputValue2};
+
+	this->m_inputValue1Operation->read(inputValue1, x, y, sampler);
+	this->m_inputValue2Operation->read(inputValue2, x, y, sampler);
+
+	this->executeKernel(output, inputs);
+}
+
+void MathBaseOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	float inputValue1[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+	float inputValue2[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+	const float *inputs[2];
+
+	for (int start = 0; start < length; start += COM_ROW_SPAN) {
+		const int span = min_ii(length - start, COM_ROW_SPAN);
+		float *out = &output[start * COM_NUMBER_OF_CHANNELS];
+
+		this->readInputRows(inputValue1, inputValue2, x + start, y, span, sampler);
+
+		for (int i = 0; i < span; i++, out += COM_NUMBER_OF_CHANNELS) {
+			inputs[0] = &inputValue1[i * COM_NUMBER_OF_CHANNELS];
+			inputs[1] = &inputValue2[i * COM_NUMBER_OF_CHANNELS];
+			this->executeKernel(out, inputs);
+		}
+	}
+}
+
+void MathAddOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = inputValue1[0] + inputValue2[0];
 
 	clampIfNeeded(output);
 }
 
-void MathSubtractOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathSubtractOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = inputValue1[0] - inputValue2[0];
 
 	clampIfNeeded(output);
 }
 
-void MathMultiplyOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathMultiplyOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = inputValue1[0] * inputValue2[0];
 
 	clampIfNeeded(output);
 }
 
-void MathDivideOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathDivideOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	if (inputValue2[0] == 0) /* We don't want to divide by zero. */
 		output[0] = 0.0;
 	else
@@ -127,53 +154,37 @@ void MathDivideOperation::executePixel(float output[4], float x, float y, PixelS
 	clampIfNeeded(output);
 }
 
-void MathSineOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathSineOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	output[0] = sin(inputValue1[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathCosineOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathCosineOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	output[0] = cos(inputValue1[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathTangentOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathTangentOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	output[0] = tan(inputValue1[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathArcSineOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathArcSineOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	if (inputValue1[0] <= 1 && inputValue1[0] >= -1)
 		output[0] = asin(inputValue1[0]);
 	else
@@ -182,14 +193,10 @@ void MathArcSineOperation::executePixel(float output[4], float x, float y, Pixel
 	clampIfNeeded(output);
 }
 
-void MathArcCosineOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathArcCosineOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	if (inputValue1[0] <= 1 && inputValue1[0] >= -1)
 		output[0] = acos(inputValue1[0]);
 	else
@@ -198,27 +205,20 @@ void MathArcCosineOperation::executePixel(float output[4], float x, float y, Pix
 	clampIfNeeded(output);
 }
 
-void MathArcTangentOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathArcTangentOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	output[0] = atan(inputValue1[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathPowerOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathPowerOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	if (inputValue1[0] >= 0) {
 		output[0] = pow(inputValue1[0], inputValue2[0]);
 	}
@@ -236,14 +236,11 @@ void MathPowerOperation::executePixel(float output[4], float x, float y, PixelSa
 	clampIfNeeded(output);
 }
 
-void MathLogarithmOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathLogarithmOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	if (inputValue1[0] > 0  && inputValue2[0] > 0)
 		output[0] = log(inputValue1[0]) / log(inputValue2[0]);
 	else
@@ -252,66 +249,50 @@ void MathLogarithmOperation::executePixel(float output[4], float x, float y, Pix
 	clampIfNeeded(output);
 }
 
-void MathMinimumOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathMinimumOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = min(inputValue1[0], inputValue2[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathMaximumOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathMaximumOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = max(inputValue1[0], inputValue2[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathRoundOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathRoundOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+
 	output[0] = round(inputValue1[0]);
 
 	clampIfNeeded(output);
 }
 
-void MathLessThanOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathLessThanOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = inputValue1[0] < inputValue2[0] ? 1.0f : 0.0f;
 
 	clampIfNeeded(output);
 }
 
-void MathGreaterThanOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MathGreaterThanOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputValue1[4];
-	float inputValue2[4];
-	
-	this->m_inputValue1Operation->read(&inputValue1[0], x, y, sampler);
-	this->m_inputValue2Operation->read(&inputValue2[0], x, y, sampler);
-	
+	const float *inputValue1 = inputs[0];
+	const float *inputValue2 = inputs[1];
+
 	output[0] = inputValue1[0] > inputValue2[0] ? 1.0f : 0.0f;
 
 	clampIfNeeded(output);
@@ -47,12 +47,21 @@ void MixBaseOperation::executePixel(float output[4], float x, float y, PixelSamp
 	float inputColor1[4];
 	float inputColor2[4];
 	float inputValue[4];
+	const float *inputs[3] = {inputValue, inputColor1, inputColor2};
 	
 	this->m_inputValueOperation->read(inputValue, x, y, sampler);
 	this->m_inputColor1Operation->read(inputColor1, x, y, sampler);
 	this->m_inputColor2Operation->read(inputColor2, x, y, sampler);
-	
-	float value = inputValue[0];
+
+	this->executeKernel(output, inputs);
+}
+
+void MixBaseOperation::executeKernel(float output[4], const float *inputs[])
+{
+	const float *inputColor1 = inputs[1];
+	const float *inputColor2 = inputs[2];
+	float value = inputs[0][0];
+
 	if (this->useValueAlphaMultiply()) {
 		value *= inputColor2[3];
 	}
@@ -63,6 +72,43 @@ void MixBaseOperation::executePixel(float output[4], float x, float y, PixelSamp
 	output[3] = inputColor1[3];
 }
 
+void MixBaseOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	if (!this->isPixelKernel()) {
+		/* the blend function is implemented in executePixel */
+		NodeOperation::executeRow(output, x, y, length, sampler);
+		return;
+	}
+
+	float inputColor1[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+	float inputColor2[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+	float inputValue[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+	const float *inputs[3];
+
+	for (int start = 0; start < length; start += COM_ROW_SPAN) {
+		const int span = min_ii(length - start, COM_ROW_SPAN);
+		float *out = &output[start * COM_NUMBER_OF_CHANNELS];
+
+		this->readInputRows(inputValue, inputColor1, inputColor2, x + start, y, span, sampler);
+
+		for (int i = 0; i < span; i++, out += COM_NUMBER_OF_CHANNELS) {
+			inputs[0] = &inputValue[i * COM_NUMBER_OF_CHANNELS];
+			inputs[1] = &inputColor1[i * COM_NUMBER_OF_CHANNELS];
+			inputs[2] = &inputColor2[i * COM_NUMBER_OF_CHANNELS];
+			this->executeKernel(out, inputs);
+		}
+	}
+}
+
+void MixBaseOperation::readInputRows(float *inputValue, float *inputColor1, float *inputColor2,
+                                     int x, int y, int length, PixelSampler sampler)
+{
+	BLI_assert(length <= COM_ROW_SPAN);
+	this->m_inputValueOperation->readRow(inputValue, x, y, length, sampler);
+	this->m_inputColor1Operation->readRow(inputColor1, x, y, length, sampler);
+	this->m_inputColor2Operation->readRow(inputColor2, x, y, length, sampler);
+}
+
 void MixBaseOperation::deinitExecution()
 {
 	this->m_inputValueOperation = NULL;
@@ -49,6 +49,13 @@ protected:
 			CLAMP(color[3], 0.0f, 1.0f);
 		}
 	}
+
+	/**
+	 * @brief read a span of all inputs, used by executeRow
+	 * @note length may not exceed COM_ROW_SPAN
+	 */
+	void readInputRows(float *inputValue, float *inputColor1, float *inputColor2,
+	                   int x, int y, int length, PixelSampler sampler);
 	
 public:
 	/**
@@ -57,9 +64,21 @@ public:
 	MixBaseOperation();
 	
 	/**
-	 * the inner loop of this program
+	 * the inner loop of this program, reads all inputs and calls executeKernel
 	 */
 	void executePixel(float output[4], float x, float y, PixelSampler sampler);
+
+	/**
+	 * reads a span of all inputs at once and calls executeKernel for every pixel
+	 * @note subclasses that are no pixel kernels are evaluated with executePixel
+	 */
+	void executeRow(float *output, int x, int y, int length, PixelSampler sampler);
+
+	/**
+	 * the blend function of this program
+	 * @note subclasses that implement it are pixel kernels and can be fused
+	 */
+	void executeKernel(float output[4], const float *inputs[]);
 	
 	/**
 	 * Initialize the execution
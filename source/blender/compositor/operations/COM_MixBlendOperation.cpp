@@ -27,18 +27,12 @@ MixBlendOperation::MixBlendOperation() : MixBaseOperation()
 	/* pass */
 }
 
-void MixBlendOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MixBlendOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputColor1[4];
-	float inputColor2[4];
-	float inputValue[4];
-	float value;
-	
-	this->m_inputValueOperation->read(inputValue, x, y, sampler);
-	this->m_inputColor1Operation->read(inputColor1, x, y, sampler);
-	this->m_inputColor2Operation->read(inputColor2, x, y, sampler);
-	value = inputValue[0];
-	
+	const float *inputColor1 = inputs[1];
+	const float *inputColor2 = inputs[2];
+	float value = inputs[0][0];
+
 	if (this->useValueAlphaMultiply()) {
 		value *= inputColor2[3];
 	}
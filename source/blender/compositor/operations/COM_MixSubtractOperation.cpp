@@ -27,16 +27,12 @@ MixSubtractOperation::MixSubtractOperation() : MixBaseOperation()
 	/* pass */
 }
 
-void MixSubtractOperation::executePixel(float output[4], float x, float y, PixelSampler sampler)
+void MixSubtractOperation::executeKernel(float output[4], const float *inputs[])
 {
-	float inputColor1[4];
-	float inputColor2[4];
-	float value;
-	
-	this->m_inputValueOperation->read(&value,   x, y, sampler);
-	this->m_inputColor1Operation->read(&inputColor1[0],   x, y, sampler);
-	this->m_inputColor2Operation->read(&inputColor2[0],   x, y, sampler);
-	
+	const float *inputColor1 = inputs[1];
+	const float *inputColor2 = inputs[2];
+	float value = inputs[0][0];
+
 	if (this->useValueAlphaMultiply()) {
 		value *= inputColor2[3];
 	}
@@ -47,4 +43,3 @@ void MixSubtractOperation::executePixel(float output[4], float x, float y, Pixel
 
 	clampIfNeeded(output);
 }
-
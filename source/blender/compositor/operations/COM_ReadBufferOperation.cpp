@@ -64,6 +64,16 @@ void ReadBufferOperation::executePixel(float output[4], float x, float y, float
 	m_buffer->readEWA(output, x, y, dx, dy, sampler);
 }
 
+void ReadBufferOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	if (sampler == COM_PS_NEAREST) {
+		m_buffer->readRow(output, x, y, length);
+	}
+	else {
+		NodeOperation::executeRow(output, x, y, length, sampler);
+	}
+}
+
 bool ReadBufferOperation::determineDependingAreaOfInterest(rcti *input, ReadBufferOperation *readOperation, rcti *output)
 {
 	if (this == readOperation) {
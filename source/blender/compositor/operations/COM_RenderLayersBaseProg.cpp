@@ -143,6 +143,15 @@ void RenderLayersBaseProg::deinitExecution()
 	this->m_inputBuffer = NULL;
 }
 
+bool RenderLayersBaseProg::updateCacheKey(CacheKey *key) const
+{
+	/* the render result changes without changing the node, use the pixels */
+	if (this->m_inputBuffer) {
+		key->addData(this->m_inputBuffer, sizeof(float) * this->getWidth() * this->getHeight() * this->m_elementsize);
+	}
+	return true;
+}
+
 void RenderLayersBaseProg::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	Scene *sce = this->getScene();
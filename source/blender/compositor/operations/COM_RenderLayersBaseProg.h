@@ -99,6 +99,7 @@ public:
 	short getLayerId() { return this->m_layerId; }
 	void initExecution();
 	void deinitExecution();
+	bool updateCacheKey(CacheKey *key) const;
 	void executePixel(float output[4], float x, float y, PixelSampler sampler);
 };
 
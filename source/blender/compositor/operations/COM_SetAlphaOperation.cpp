@@ -48,6 +48,30 @@ void SetAlphaOperation::executePixel(float output[4], float x, float y, PixelSam
 	output[3] = alphaInput[0];
 }
 
+void SetAlphaOperation::executeKernel(float output[4], const float *inputs[])
+{
+	copy_v3_v3(output, inputs[0]);
+	output[3] = inputs[1][0];
+}
+
+void SetAlphaOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	float inputAlpha[COM_ROW_SPAN * COM_NUMBER_OF_CHANNELS];
+
+	this->m_inputColor->readRow(output, x, y, length, sampler);
+
+	for (int start = 0; start < length; start += COM_ROW_SPAN) {
+		const int span = min_ii(length - start, COM_ROW_SPAN);
+		float *out = &output[start * COM_NUMBER_OF_CHANNELS];
+
+		this->m_inputAlpha->readRow(inputAlpha, x + start, y, span, sampler);
+
+		for (int i = 0; i < span; i++, out += COM_NUMBER_OF_CHANNELS) {
+			out[3] = inputAlpha[i * COM_NUMBER_OF_CHANNELS];
+		}
+	}
+}
+
 void SetAlphaOperation::deinitExecution()
 {
 	this->m_inputColor = NULL;
@@ -32,6 +32,18 @@ void SetColorOperation::executePixel(float output[4], float x, float y, PixelSam
 	copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeKernel(float output[4], const float *inputs[])
+{
+	copy_v4_v4(output, this->m_color);
+}
+
+void SetColorOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		copy_v4_v4(output, this->m_color);
+	}
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
@@ -56,6 +56,9 @@ public:
 	 * the inner loop of this program
 	 */
 	void executePixel(float output[4], float x, float y, PixelSampler sampler);
+	void executeKernel(float output[4], const float *inputs[]);
+	const bool isPixelKernel() const { return true; }
+	void executeRow(float *output, int x, int y, int length, PixelSampler sampler);
 
 	void determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2]);
 	const bool isSetOperation() const { return true; }
@@ -32,6 +32,18 @@ void SetValueOperation::executePixel(float output[4], float x, float y, PixelSam
 	output[0] = this->m_value;
 }
 
+void SetValueOperation::executeKernel(float output[4], const float *inputs[])
+{
+	output[0] = this->m_value;
+}
+
+void SetValueOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		output[0] = this->m_value;
+	}
+}
+
 void SetValueOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
@@ -36,6 +36,24 @@ void SetVectorOperation::executePixel(float output[4], float x, float y, PixelSa
 	output[3] = this->m_w;
 }
 
+void SetVectorOperation::executeKernel(float output[4], const float *inputs[])
+{
+	output[0] = this->m_x;
+	output[1] = this->m_y;
+	output[2] = this->m_z;
+	output[3] = this->m_w;
+}
+
+void SetVectorOperation::executeRow(float *output, int x, int y, int length, PixelSampler sampler)
+{
+	for (int i = 0; i < length; i++, output += COM_NUMBER_OF_CHANNELS) {
+		output[0] = this->m_x;
+		output[1] = this->m_y;
+		output[2] = this->m_z;
+		output[3] = this->m_w;
+	}
+}
+
 void SetVectorOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
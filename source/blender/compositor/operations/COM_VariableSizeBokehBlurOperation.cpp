@@ -137,16 +137,19 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
 		copy_v4_fl(multiplier_accum, 1.0f);
 		float size_center = tempSize[0] * scalar;
 		
+		const int sizeChannels = inputSizeBuffer->getNumberOfChannels();
 		const int addXStep = QualityStepHelper::getStep() * COM_NUMBER_OF_CHANNELS;
+		const int addXStepSize = QualityStepHelper::getStep() * sizeChannels;
 		
 		if (size_center > this->m_threshold) {
 			for (int ny = miny; ny < maxy; ny += QualityStepHelper::getStep()) {
 				float dy = ny - y;
 				int offsetNy = ny * inputSizeBuffer->getWidth() * COM_NUMBER_OF_CHANNELS;
 				int offsetNxNy = offsetNy + (minx * COM_NUMBER_OF_CHANNELS);
+				int sizeOffsetNxNy = (ny * inputSizeBuffer->getWidth() + minx) * sizeChannels;
 				for (int nx = minx; nx < maxx; nx += QualityStepHelper::getStep()) {
 					if (nx != x || ny != y) {
-						float size = min(inputSizeFloatBuffer[offsetNxNy] * scalar, size_center);
+						float size = min(inputSizeFloatBuffer[sizeOffsetNxNy] * scalar, size_center);
 						if (size > this->m_threshold) {
 							float dx = nx - x;
 							if (size > fabsf(dx) && size > fabsf(dy)) {
@@ -160,6 +163,7 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
 						}
 					}
 					offsetNxNy += addXStep;
+					sizeOffsetNxNy += addXStepSize;
 				}
 			}
 		}
@@ -24,6 +24,7 @@
 #include "COM_defines.h"
 #include <stdio.h>
 #include "COM_OpenCLDevice.h"
+#include "MEM_guardedalloc.h"
 
 WriteBufferOperation::WriteBufferOperation() : NodeOperation()
 {
@@ -60,22 +61,23 @@ void WriteBufferOperation::deinitExecution()
 void WriteBufferOperation::executeRegion(rcti *rect, unsigned int tileNumber)
 {
 	MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
-	float *buffer = memoryBuffer->getBuffer();
+	/* colors are written in the buffer directly, other data is converted per row */
+	const bool writeDirect = (memoryBuffer->getNumberOfChannels() == COM_NUMBER_OF_CHANNELS && !memoryBuffer->isHalfFloat());
+	float *buffer = writeDirect ? memoryBuffer->getBuffer() : NULL;
+	float *row = writeDirect ? NULL : (float *)MEM_mallocN(sizeof(float) * COM_NUMBER_OF_CHANNELS * (rect->xmax - rect->xmin), __func__);
 	if (this->m_input->isComplex()) {
 		void *data = this->m_input->initializeTileData(rect);
 		int x1 = rect->xmin;
 		int y1 = rect->ymin;
 		int x2 = rect->xmax;
 		int y2 = rect->ymax;
-		int x;
 		int y;
 		bool breaked = false;
 		for (y = y1; y < y2 && (!breaked); y++) {
-			int offset4 = (y * memoryBuffer->getWidth() + x1) * COM_NUMBER_OF_CHANNELS;
-			for (x = x1; x < x2; x++) {
-				this->m_input->read(&(buffer[offset4]), x, y, data);
-				offset4 += COM_NUMBER_OF_CHANNELS;
-
+			float *output = writeDirect ? &buffer[(y * memoryBuffer->getWidth() + x1) * COM_NUMBER_OF_CHANNELS] : row;
+			this->m_input->readRow(output, x1, y, x2 - x1, data);
+			if (!writeDirect) {
+				memoryBuffer->writeRow(x1, y, x2 - x1, row);
 			}
 			if (isBreaked()) {
 				breaked = true;
@@ -93,20 +95,26 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int tileNumber)
 		int x2 = rect->xmax;
 		int y2 = rect->ymax;
 
-		int x;
 		int y;
 		bool breaked = false;
 		for (y = y1; y < y2 && (!breaked); y++) {
-			int offset4 = (y * memoryBuffer->getWidth() + x1) * COM_NUMBER_OF_CHANNELS;
-			for (x = x1; x < x2; x++) {
-				this->m_input->read(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-				offset4 += COM_NUMBER_OF_CHANNELS;
+			/* evaluate the whole row at once, simple operations process it in a single loop */
+			if (writeDirect) {
+				int offset4 = (y * memoryBuffer->getWidth() + x1) * COM_NUMBER_OF_CHANNELS;
+				this->m_input->readRow(&(buffer[offset4]), x1, y, x2 - x1, COM_PS_NEAREST);
+			}
+			else {
+				this->m_input->readRow(row, x1, y, x2 - x1, COM_PS_NEAREST);
+				memoryBuffer->writeRow(x1, y, x2 - x1, row);
 			}
 			if (isBreaked()) {
 				breaked = true;
 			}
 		}
 	}
+	if (row) {
+		MEM_freeN(row);
+	}
 	memoryBuffer->setCreatedState();
 }
 
@@ -174,6 +182,13 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device, rcti *rect,
 	delete clKernelsToCleanUp;
 }
 
+void WriteBufferOperation::readDataTypeFromInputSocket()
+{
+	/* only store the channels the input calculates */
+	NodeOperation *inputOperation = this->getInputOperation(0);
+	this->m_memoryProxy->setDataType(inputOperation->getOutputSocket()->getDataType());
+}
+
 void WriteBufferOperation::readResolutionFromInputSocket()
 {
 	NodeOperation *inputOperation = this->getInputOperation(0);
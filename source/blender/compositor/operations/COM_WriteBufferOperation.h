@@ -46,6 +46,11 @@ public:
 	void deinitExecution();
 	void executeOpenCLRegion(OpenCLDevice *device, rcti *rect, unsigned int chunkNumber, MemoryBuffer **memoryBuffers, MemoryBuffer *outputBuffer);
 	void readResolutionFromInputSocket();
+
+	/**
+	 * @brief set the datatype of the memory proxy to the datatype of the input
+	 */
+	void readDataTypeFromInputSocket();
 	inline NodeOperation *getInput() {
 		return m_input;
 	}
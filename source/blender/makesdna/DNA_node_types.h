@@ -350,7 +350,7 @@ typedef struct bNodeTree {
 	int update;						/* update flags */
 	short is_updating;				/* flag to prevent reentrant update calls */
 	short done;						/* generic temporary flag for recursion check (DFS/BFS) */
-	int pad2;
+	int buffer_memory_limit;		/* compositor: megabytes of intermediate buffers kept in memory, 0 is unlimited */
 	
 	int nodetype DNA_DEPRECATED;	/* specific node type this tree is used for */
 
@@ -404,6 +404,7 @@ typedef struct bNodeTree {
 #define NTREE_TWO_PASS				4	/* two pass */
 #define NTREE_COM_GROUPNODE_BUFFER	8	/* use groupnode buffers */
 #define NTREE_VIEWER_BORDER		16	/* use a border for viewer nodes */
+#define NTREE_COM_HALF_FLOAT_BUFFERS	32	/* store intermediate buffers as half floats */
 
 /* XXX not nice, but needed as a temporary flags
  * for group updates after library linking.
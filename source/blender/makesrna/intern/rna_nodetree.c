@@ -6884,6 +6884,18 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
 	RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_GROUPNODE_BUFFER);
 	RNA_def_property_ui_text(prop, "Buffer Groups", "Enable buffering of group nodes");
 
+	prop = RNA_def_property(srna, "use_half_float_buffers", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_HALF_FLOAT_BUFFERS);
+	RNA_def_property_ui_text(prop, "Half Float Buffers", "Store intermediate buffers with half precision "
+	                                                     "to reduce memory usage");
+
+	prop = RNA_def_property(srna, "buffer_memory_limit", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "buffer_memory_limit");
+	RNA_def_property_range(prop, 0, INT_MAX);
+	RNA_def_property_ui_range(prop, 0, 1024 * 64, 256, -1);
+	RNA_def_property_ui_text(prop, "Buffer Memory Limit", "Memory for intermediate buffers (in megabytes), "
+	                         "buffers that do not fit are stored in a scratch file on disk (0 is unlimited)");
+
 	prop = RNA_def_property(srna, "two_pass", PROP_BOOLEAN, PROP_NONE);
 	RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_TWO_PASS);
 	RNA_def_property_ui_text(prop, "Two Pass", "Use two pass execution during editing: first calculate fast nodes, "
@@ -2688,10 +2688,13 @@ int RE_ReadRenderResult(Scene *scene, Scene *scenode)
 
 void RE_set_max_threads(int threads)
 {
+	/* the override is also used by the compositor and other threaded tools */
 	if (threads == 0) {
+		BLI_system_num_threads_override_set(0);
 		RenderGlobal.threads = BLI_system_thread_count();
 	}
 	else if (threads >= 1 && threads <= BLENDER_MAX_THREADS) {
+		BLI_system_num_threads_override_set(threads);
 		RenderGlobal.threads = threads;
 	}
 	else {
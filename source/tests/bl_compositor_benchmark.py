@@ -0,0 +1,217 @@
+# ##### BEGIN GPL LICENSE BLOCK #####
+#
+#  This program is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU General Public License
+#  as published by the Free Software Foundation; either version 2
+#  of the License, or (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software Foundation,
+#  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+# ##### END GPL LICENSE BLOCK #####
+
+# <pep8 compliant>
+
+# Benchmark of the compositor on synthetic node trees, without the UI.
+#
+# Every tree is composited with every thread count and chunk size. The number of compositor
+# threads is fixed when the compositor starts, so every thread count runs in its own
+# background Blender process. The compositor profile of every run (--debug-compositor)
+# is printed: the time per execution group of operations, the slowest initializations and
+# the peak memory. A summary of the throughput follows at the end.
+#
+# Example:
+#
+#   ./blender.bin --background --factory-startup --python source/tests/bl_compositor_benchmark.py -- \
+#       --trees blur,glare --threads 1,4 --chunk-sizes 128,256 --resolution 1920x1080 --repeat 3
+
+import sys
+import subprocess
+
+TREES = ("blur", "glare", "keying", "defocus", "vector_blur")
+
+
+def tree_add_image(tree, width, height):
+    import bpy
+
+    image = bpy.data.images.new("Benchmark", width, height, alpha=True, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    node = tree.nodes.new("CompositorNodeImage")
+    node.image = image
+    return node.outputs["Image"]
+
+
+def tree_add_math(tree, socket, operation, value):
+    node = tree.nodes.new("CompositorNodeMath")
+    node.operation = operation
+    node.inputs[1].default_value = value
+    tree.links.new(socket, node.inputs[0])
+    return node.outputs[0]
+
+
+def tree_add_channel(tree, socket, channel):
+    node = tree.nodes.new("CompositorNodeSepRGBA")
+    tree.links.new(socket, node.inputs["Image"])
+    return node.outputs[channel]
+
+
+def build_tree(tree, name, width, height):
+    links = tree.links
+    image = tree_add_image(tree, width, height)
+
+    if name == "blur":
+        for filter_type, size in (('GAUSS', 20), ('FAST_GAUSS', 80), ('FLAT', 10)):
+            node = tree.nodes.new("CompositorNodeBlur")
+            node.filter_type = filter_type
+            node.size_x = node.size_y = size
+            links.new(image, node.inputs["Image"])
+            image = node.outputs["Image"]
+
+    elif name == "glare":
+        for glare_type in ('FOG_GLOW', 'STREAKS'):
+            node = tree.nodes.new("CompositorNodeGlare")
+            node.glare_type = glare_type
+            node.quality = 'HIGH'
+            node.threshold = 0.5
+            links.new(image, node.inputs["Image"])
+            image = node.outputs["Image"]
+
+    elif name == "keying":
+        node = tree.nodes.new("CompositorNodeKeying")
+        node.inputs["Key Color"].default_value = (0.0, 1.0, 0.0, 1.0)
+        node.blur_pre = 2
+        node.blur_post = 2
+        node.dilate_distance = 2
+        node.feather_distance = 4
+        links.new(image, node.inputs["Image"])
+        image = node.outputs["Image"]
+
+    elif name == "defocus":
+        depth = tree_add_math(tree, tree_add_channel(tree, image, "R"), 'MULTIPLY', 20.0)
+        node = tree.nodes.new("CompositorNodeDefocus")
+        node.use_zbuffer = True
+        node.f_stop = 2.0
+        node.blur_max = 32.0
+        links.new(image, node.inputs["Image"])
+        links.new(depth, node.inputs["Z"])
+        image = node.outputs["Image"]
+
+    elif name == "vector_blur":
+        depth = tree_add_math(tree, tree_add_channel(tree, image, "B"), 'MULTIPLY', 10.0)
+        speed = tree.nodes.new("CompositorNodeCombRGBA")
+        for channel in ("R", "G", "B", "A"):
+            links.new(tree_add_math(tree, tree_add_channel(tree, image, channel), 'MULTIPLY', 16.0),
+                      speed.inputs[channel])
+        node = tree.nodes.new("CompositorNodeVecBlur")
+        node.samples = 32
+        node.speed_max = 64
+        links.new(image, node.inputs["Image"])
+        links.new(depth, node.inputs["Z"])
+        links.new(speed.outputs["Image"], node.inputs["Speed"])
+        image = node.outputs["Image"]
+
+    else:
+        raise Exception("unknown tree %r, available trees: %s" % (name, ", ".join(TREES)))
+
+    composite = tree.nodes.new("CompositorNodeComposite")
+    links.new(image, composite.inputs["Image"])
+
+
+def run(name, chunk_sizes, width, height, repeat):
+    """Composite a tree with every chunk size, runs inside the benchmarked process."""
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    scene.render.resolution_x = width
+    scene.render.resolution_y = height
+    scene.render.resolution_percentage = 100
+    scene.use_nodes = True
+
+    tree = scene.node_tree
+    tree.nodes.clear()
+    build_tree(tree, name, width, height)
+
+    threads = bpy.app.debug_value  # set by the main process
+
+    for chunk_size in chunk_sizes:
+        tree.chunk_size = str(chunk_size)
+
+        # the scene has no render layer nodes, rendering only composites
+        times = []
+        for i in range(repeat):
+            start = time.time()
+            bpy.ops.render.render()
+            times.append(time.time() - start)
+
+        print("BENCHMARK %s %d %d %.4f %.4f" % (name, threads, chunk_size, min(times), width * height / 1e6))
+        sys.stdout.flush()
+
+
+def parse_int_list(text):
+    return [int(value) for value in text.split(",") if value]
+
+
+def main():
+    import argparse
+
+    argv = sys.argv
+    argv = argv[argv.index("--") + 1:] if "--" in argv else []
+
+    parser = argparse.ArgumentParser(description="Benchmark of the compositor on synthetic node trees")
+    parser.add_argument("--trees", default=",".join(TREES),
+                        help="comma separated trees, from: %s" % ", ".join(TREES))
+    parser.add_argument("--threads", default="1,2,4,8", help="comma separated thread counts")
+    parser.add_argument("--chunk-sizes", default="128,256,512", help="comma separated chunk sizes")
+    parser.add_argument("--resolution", default="1920x1080", help="WIDTHxHEIGHT of the input and output")
+    parser.add_argument("--repeat", type=int, default=1, help="runs per configuration, the fastest is reported")
+    parser.add_argument("--run", help=argparse.SUPPRESS)  # a single tree, used by the started processes
+    args = parser.parse_args(argv)
+
+    width, height = (int(value) for value in args.resolution.lower().split("x"))
+    chunk_sizes = parse_int_list(args.chunk_sizes)
+
+    if args.run:
+        run(args.run, chunk_sizes, width, height, args.repeat)
+        return
+
+    import bpy
+
+    # pass the location of the scripts on to the started processes
+    system_scripts = []
+    if "--env-system-scripts" in sys.argv:
+        index = sys.argv.index("--env-system-scripts")
+        system_scripts = sys.argv[index:index + 2]
+
+    results = []
+    for name in args.trees.split(","):
+        for threads in parse_int_list(args.threads):
+            command = [bpy.app.binary_path, "--background", "-noaudio", "--factory-startup"] + system_scripts + [
+                       "--threads", str(threads), "--debug-value", str(threads), "--debug-compositor",
+                       "--python", __file__, "--",
+                       "--run", name, "--chunk-sizes", args.chunk_sizes,
+                       "--resolution", args.resolution, "--repeat", str(args.repeat)]
+            process = subprocess.Popen(command, stdout=subprocess.PIPE, universal_newlines=True)
+            for line in process.stdout:
+                if line.startswith("BENCHMARK "):
+                    results.append(line.split()[1:])
+                elif line.startswith("Compositor") or line.startswith("  "):
+                    sys.stdout.write(line)
+            if process.wait() != 0:
+                print("Error: benchmark of %r with %d threads failed" % (name, threads))
+
+    print("")
+    print("%-12s %8s %10s %10s %8s" % ("tree", "threads", "chunk size", "time (s)", "Mpix/s"))
+    for name, threads, chunk_size, seconds, megapixels in results:
+        print("%-12s %8s %10s %10s %8.2f" % (name, threads, chunk_size, seconds, float(megapixels) / float(seconds)))
+
+
+if __name__ == "__main__":
+    main()